@@ -0,0 +1,199 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file bench_cfd_psbt.cpp
+ *
+ * @brief This file is benchmark of Partially Signed Bitcoin Transaction.
+ * @details The global operator new is replaced to count the allocation.
+ *    The allocation on libwally (malloc) is not counted.
+ */
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "cfd/cfd_common.h"
+#include "cfd/cfd_psbt.h"
+#include "cfd/cfd_utxo.h"
+#include "cfdcore/cfdcore_address.h"
+#include "cfdcore/cfdcore_amount.h"
+#include "cfdcore/cfdcore_bytedata.h"
+#include "cfdcore/cfdcore_descriptor.h"
+#include "cfdcore/cfdcore_exception.h"
+#include "cfdcore/cfdcore_hdwallet.h"
+#include "cfdcore/cfdcore_key.h"
+#include "cfdcore/cfdcore_util.h"
+
+using cfd::Psbt;
+using cfd::UtxoData;
+using cfd::core::AddressType;
+using cfd::core::Amount;
+using cfd::core::ByteData;
+using cfd::core::ByteData256;
+using cfd::core::CfdException;
+using cfd::core::Descriptor;
+using cfd::core::HashUtil;
+using cfd::core::HDWallet;
+using cfd::core::NetType;
+using cfd::core::Privkey;
+using cfd::core::Txid;
+
+// -----------------------------------------------------------------------------
+// allocation hook
+// -----------------------------------------------------------------------------
+//! allocation count
+static std::atomic<uint64_t> g_alloc_count(0);
+//! allocation bytes
+static std::atomic<uint64_t> g_alloc_bytes(0);
+
+void* operator new(std::size_t size) {
+  g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+  g_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+  void* pointer = std::malloc((size == 0) ? 1 : size);
+  if (pointer == nullptr) throw std::bad_alloc();
+  return pointer;
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+// -----------------------------------------------------------------------------
+// benchmark
+// -----------------------------------------------------------------------------
+//! benchmark seed
+static const char* const kBenchmarkSeed =
+    "8bc106907003ea0b55f3ed4ce2fcf9a198d8c43f07e6ade8aacc5c20c33db12e";
+
+/**
+ * @brief Measure the function.
+ * @param[in] name          operation name
+ * @param[in] input_count   psbt input count
+ * @param[in] function      target function
+ */
+template <typename Function>
+static void Measure(
+    const char* name, size_t input_count, const Function& function) {
+  uint64_t count = g_alloc_count.load();
+  uint64_t bytes = g_alloc_bytes.load();
+  auto start = std::chrono::steady_clock::now();
+  function();
+  auto end = std::chrono::steady_clock::now();
+  uint64_t usec = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+          .count());
+  uint64_t alloc_count = g_alloc_count.load() - count;
+  uint64_t alloc_bytes = g_alloc_bytes.load() - bytes;
+  printf(
+      "%-10s %8zu %12llu %12llu %14llu %10.1f\n", name, input_count,
+      static_cast<unsigned long long>(usec),         // NOLINT
+      static_cast<unsigned long long>(alloc_count),  // NOLINT
+      static_cast<unsigned long long>(alloc_bytes),  // NOLINT
+      static_cast<double>(alloc_count) / static_cast<double>(input_count));
+}
+
+/**
+ * @brief Generate the wpkh utxo list.
+ * @param[in] count           utxo count
+ * @param[out] privkey_list   privkey list
+ * @return utxo list
+ */
+static std::vector<UtxoData> GenerateUtxo(
+    size_t count, std::vector<Privkey>* privkey_list) {
+  static constexpr NetType kNetType = NetType::kRegtest;
+  HDWallet wallet(ByteData(std::string(kBenchmarkSeed)));
+  std::vector<UtxoData> list;
+  list.reserve(count);
+  for (size_t index = 0; index < count; ++index) {
+    std::string path = "44h/0h/0h/0/" + std::to_string(index);
+    auto key = wallet.GeneratePrivkeyData(kNetType, path);
+    UtxoData utxo;
+    utxo.block_height = 0;
+    utxo.binary_data = nullptr;
+    utxo.descriptor = "wpkh(" + key.ToString() + ")";
+    utxo.amount = Amount(int64_t{100000});
+    auto ref = Descriptor::Parse(utxo.descriptor).GetReference();
+    utxo.locking_script = ref.GetLockingScript();
+    utxo.address = ref.GenerateAddress(kNetType);
+    utxo.address_type = AddressType::kP2wpkhAddress;
+    utxo.txid = Txid(ByteData256(HashUtil::Sha256(path)));
+    utxo.vout = static_cast<uint32_t>(index);
+    list.push_back(utxo);
+    privkey_list->push_back(key.GetPrivkey());
+  }
+  return list;
+}
+
+/**
+ * @brief Run the psbt benchmark.
+ * @param[in] input_count   psbt input count
+ */
+static void RunPsbtBenchmark(size_t input_count) {
+  std::vector<Privkey> privkey_list;
+  std::vector<UtxoData> utxos = GenerateUtxo(input_count, &privkey_list);
+  auto change = Descriptor::Parse(utxos[0].descriptor);
+  auto address = utxos[0].address;
+  int64_t send_amount =
+      static_cast<int64_t>(input_count) * 100000 / 2 + 1000;
+
+  Psbt psbt;
+  Measure("create", input_count, [&]() { psbt = Psbt(2, 0); });
+  Measure("add-input", input_count, [&]() {
+    for (const auto& utxo : utxos) psbt.AddTxInData(utxo);
+    psbt.AddTxOut(Amount(send_amount), address);
+  });
+
+  Psbt fund_psbt(2, 0);
+  fund_psbt.AddTxOut(Amount(send_amount), address);
+  Measure("fund", input_count, [&]() {
+    fund_psbt.FundTransaction(utxos, 2.0, &change);
+  });
+
+  Psbt signed_psbt(psbt);
+  Measure("sign", input_count, [&]() {
+    signed_psbt.Sign(privkey_list, true, 1);
+  });
+  Measure("combine", input_count, [&]() { psbt.Combine(signed_psbt); });
+  Measure("finalize", input_count, [&]() { psbt.Finalize(); });
+  Measure("extract", input_count, [&]() { psbt.Extract(); });
+
+  ByteData psbt_bytes = psbt.GetData();
+  Measure("decode", input_count, [&]() { Psbt decode_psbt(psbt_bytes); });
+  Measure("get-utxo", input_count, [&]() { psbt.GetUtxoDataAll(); });
+  Measure("copy", input_count, [&]() { Psbt copy_psbt(psbt); });
+}
+
+/**
+ * @brief benchmark main.
+ * @details usage: cfd_psbt_benchmark [input_count ...]
+ * @param[in] argc    argument count
+ * @param[in] argv    argument list
+ * @return exit code
+ */
+int main(int argc, char* argv[]) {
+  std::vector<size_t> input_counts;
+  for (int index = 1; index < argc; ++index) {
+    input_counts.push_back(
+        static_cast<size_t>(std::strtoul(argv[index], nullptr, 10)));
+  }
+  if (input_counts.empty()) input_counts = {1, 10, 100, 500, 1000, 2000};
+
+  printf(
+      "%-10s %8s %12s %12s %14s %10s\n", "operation", "inputs", "usec",
+      "allocs", "alloc_bytes", "allocs/in");
+  try {
+    for (size_t input_count : input_counts) {
+      if (input_count == 0) continue;
+      RunPsbtBenchmark(input_count);
+    }
+  } catch (const CfdException& except) {
+    fprintf(stderr, "benchmark error: %s\n", except.what());
+    return 1;
+  }
+  return 0;
+}
@@ -15,10 +15,12 @@ if(NOT WIN32)
 #option(TARGET_RPATH "target rpath list (separator is ';') (default:)" "")
 set(TARGET_RPATH "" CACHE STRING "target rpath list (separator is ';') (default:)")
 option(ENABLE_COVERAGE "enable code coverage (ON or OFF. default:OFF)" OFF)
+option(ENABLE_THREAD_SANITIZER "enable thread sanitizer (ON or OFF. default:OFF)" OFF)
 option(ENABLE_RPATH "enable rpath (ON or OFF. default:ON)" ON)
 else()
 set(TARGET_RPATH "")
 set(ENABLE_COVERAGE FALSE)
+set(ENABLE_THREAD_SANITIZER FALSE)
 set(ENABLE_RPATH off)
 endif()
 
@@ -73,6 +75,11 @@ set(CMAKE_SKIP_BUILD_RPATH  TRUE)
 endif()
 endif()
 
+if(ENABLE_THREAD_SANITIZER)
+add_compile_options(-fsanitize=thread)
+add_link_options(-fsanitize=thread)
+endif()
+
 if(NOT ENABLE_ELEMENTS)
 set(ELEMENTS_COMP_OPT "")
 set(CFD_ELEMENTS_USE   CFD_DISABLE_ELEMENTS)
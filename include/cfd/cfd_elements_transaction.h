@@ -9,6 +9,7 @@
 #ifndef CFD_DISABLE_ELEMENTS
 
 #include <map>
+#include <mutex>  // NOLINT
 #include <set>
 #include <string>
 #include <vector>
@@ -79,6 +80,19 @@ struct ConfidentialKeyBlindParameter {
   Pubkey confidential_key;  //!< confidential key
 };
 
+/**
+ * @brief Using utxo and option data in elements
+ */
+struct ElementsUtxoAndOption {
+  UtxoData utxo;                       //!< utxo
+  bool is_issuance = false;            //!< use issuance/reissuance
+  bool is_blind_issuance = false;      //!< use blind issuance/reissuance
+  bool is_pegin = false;               //!< use pegin
+  uint32_t pegin_btc_tx_size = 0;      //!< btc pegin tx size
+  Script claim_script;                 //!< claim script for pegin
+  uint32_t pegin_txoutproof_size = 0;  //!< btc pegin txoutproof size
+};
+
 /**
  * @brief Context class for generating bitcoin transaction.
  */
@@ -130,6 +144,15 @@ class CFD_EXPORT ConfidentialTransactionContext
    */
   ConfidentialTransactionContext& operator=(
       const ConfidentialTransactionContext& context) &;
+  /**
+   * @brief Copy the serialized transaction into the buffer.
+   * @details The transaction is serialized directly into the buffer.
+   *    If buffer is null or too small, only the data size is returned.
+   * @param[out] buffer       transaction byte buffer (nullable)
+   * @param[in] buffer_size   buffer size
+   * @return transaction byte data size
+   */
+  size_t CopyData(uint8_t* buffer, size_t buffer_size) const;
 
   /**
    * @brief ConfidentialTransaction's GetTxInIndex.
@@ -301,6 +324,98 @@ class CFD_EXPORT ConfidentialTransactionContext
    */
   bool IsFindFeeTxOut(uint32_t* index = nullptr) const;
 
+  /**
+   * @brief fund this transaction.
+   * @details The selected utxos are appended to txin, and the change and fee
+   *   are set to txout. The transaction is updated in place without
+   *   serializing. If an exception occurs, the transaction state is undefined.
+   * @param[in] utxos                    using utxo data
+   * @param[in] map_target_value         asset target value map.
+   * @param[in] selected_txin_utxos      selected txin utxo
+   * @param[in] reserve_txout_address    address for adding txout.
+   *    Also serves as a change address.
+   * @param[in] fee_asset                using fee asset
+   * @param[in] is_blind_estimate_fee    using tx blinding
+   * @param[in] effective_fee_rate       effective fee rate (minimum)
+   * @param[out] estimate_fee            estimate fee
+   * @param[in] filter                   utxo search filter
+   * @param[in] option_params            utxo search option
+   * @param[out] append_txout_addresses  used txout additional address
+   * @param[in] net_type                 network type
+   * @param[in] prefix_list              address prefix list
+   * @param[out] calculate_fee           calculate fee (before add dust amount)
+   * @return utxo list appended to txin.
+   */
+  std::vector<UtxoData> Fund(
+      const std::vector<UtxoData>& utxos,
+      const std::map<std::string, Amount>& map_target_value,
+      const std::vector<UtxoData>& selected_txin_utxos,
+      const std::map<std::string, std::string>& reserve_txout_address,
+      const ConfidentialAssetId& fee_asset, bool is_blind_estimate_fee = true,
+      double effective_fee_rate = 1, Amount* estimate_fee = nullptr,
+      const UtxoFilter* filter = nullptr,
+      const CoinSelectionOption* option_params = nullptr,
+      std::vector<std::string>* append_txout_addresses = nullptr,
+      NetType net_type = NetType::kLiquidV1,
+      const std::vector<cfd::core::AddressFormatData>* prefix_list = nullptr,
+      Amount* calculate_fee = nullptr);
+
+  /**
+   * @brief fund this transaction with txin utxo options.
+   * @details The same as the UtxoData overload, except that the selected
+   *   txin utxos carry issuance and pegin options for the fee estimation.
+   * @param[in] utxos                    using utxo data
+   * @param[in] map_target_value         asset target value map.
+   * @param[in] selected_txin_utxos      selected txin utxo and option
+   * @param[in] reserve_txout_address    address for adding txout.
+   *    Also serves as a change address.
+   * @param[in] fee_asset                using fee asset
+   * @param[in] is_blind_estimate_fee    using tx blinding
+   * @param[in] effective_fee_rate       effective fee rate (minimum)
+   * @param[out] estimate_fee            estimate fee
+   * @param[in] filter                   utxo search filter
+   * @param[in] option_params            utxo search option
+   * @param[out] append_txout_addresses  used txout additional address
+   * @param[in] net_type                 network type
+   * @param[in] prefix_list              address prefix list
+   * @param[out] calculate_fee           calculate fee (before add dust amount)
+   * @return utxo list appended to txin.
+   */
+  std::vector<UtxoData> Fund(
+      const std::vector<UtxoData>& utxos,
+      const std::map<std::string, Amount>& map_target_value,
+      const std::vector<ElementsUtxoAndOption>& selected_txin_utxos,
+      const std::map<std::string, std::string>& reserve_txout_address,
+      const ConfidentialAssetId& fee_asset, bool is_blind_estimate_fee = true,
+      double effective_fee_rate = 1, Amount* estimate_fee = nullptr,
+      const UtxoFilter* filter = nullptr,
+      const CoinSelectionOption* option_params = nullptr,
+      std::vector<std::string>* append_txout_addresses = nullptr,
+      NetType net_type = NetType::kLiquidV1,
+      const std::vector<cfd::core::AddressFormatData>* prefix_list = nullptr,
+      Amount* calculate_fee = nullptr);
+
+  /**
+   * @brief estimate the fee of this transaction.
+   * @param[in] utxos                txin utxo and option list
+   * @param[in] fee_asset            fee asset
+   * @param[out] txout_fee           fee of the txout part
+   * @param[out] utxo_fee            fee of the txin part
+   * @param[in] is_blind             blinding estimation
+   * @param[in] effective_fee_rate   fee rate
+   * @param[in] exponent             rangeproof exponent value
+   * @param[in] minimum_bits         rangeproof blinding bits
+   * @param[out] append_asset_count  asset count that has not txout
+   * @return estimate fee
+   */
+  Amount EstimateFee(
+      const std::vector<ElementsUtxoAndOption>& utxos,
+      const ConfidentialAssetId& fee_asset, Amount* txout_fee = nullptr,
+      Amount* utxo_fee = nullptr, bool is_blind = true,
+      uint64_t effective_fee_rate = 1000, int exponent = 0,
+      int minimum_bits = kDefaultBlindMinimumBits,
+      uint32_t* append_asset_count = nullptr) const;
+
   /**
    * @brief Get the Fee amount for TxOut.
    * @param[out] asset    fee asset.
@@ -859,6 +974,27 @@ class CFD_EXPORT ConfidentialTransactionContext
       const std::vector<OutPoint>& list, const OutPoint& outpoint) const;
 
  private:
+  /**
+   * @brief find the txin index without the exception.
+   * @param[in] outpoint    TxIn txid and vout
+   * @param[out] index      txin index
+   * @retval true   exist
+   * @retval false  not exist
+   */
+  bool FindTxInIndex(const OutPoint& outpoint, uint32_t* index) const;
+  /**
+   * @brief find the first txout index without the exception.
+   * @param[in] locking_script    locking script
+   * @param[out] index            txout index
+   * @retval true   exist
+   * @retval false  not exist
+   */
+  bool FindTxOutIndex(const Script& locking_script, uint32_t* index) const;
+  /**
+   * @brief mark the txin index map to rebuild on the next miss.
+   */
+  void MarkTxInIndexDirty();
+
   /**
    * @brief utxo map.
    */
@@ -875,6 +1011,18 @@ class CFD_EXPORT ConfidentialTransactionContext
    * @brief utxo verify ignore map. (outpoint)
    */
   std::vector<OutPoint> verify_ignore_map_;
+  /**
+   * @brief txin index map. (outpoint, txin index)
+   */
+  mutable std::map<OutPoint, uint32_t> txin_index_map_;
+  /**
+   * @brief txin index map is changed.
+   */
+  mutable bool is_txin_index_dirty_ = true;
+  /**
+   * @brief txin index map mutex.
+   */
+  mutable std::mutex txin_index_mutex_;
 };
 
 // ----------------------------------------------------------------------------
@@ -9,7 +9,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <istream>
 #include <map>
+#include <mutex>  // NOLINT
 #include <set>
 #include <string>
 #include <vector>
@@ -106,9 +108,31 @@ class CFD_EXPORT Psbt : public cfd::core::Psbt {
 
   /**
    * @brief Get transaction context base.
+   * @details The context is built from the psbt structure directly.
    * @return transaction context.
    */
   TransactionContext GetTransactionContext() const;
+  /**
+   * @brief Set the final script from the signed transaction context.
+   * @details The input that is not signed on the context is skipped.
+   * @param[in] context   signed transaction context.
+   */
+  void SetTxInFinalScriptByContext(const TransactionContext& context);
+
+  /**
+   * @brief cfd::core::Psbt's Combine.
+   */
+  using cfd::core::Psbt::Combine;
+  /**
+   * @brief combine multiple psbts.
+   * @details Each input is combined with all psbts on one pass, and \
+   *    the inputs are processed in parallel. The psbt list is not cloned. \
+   *    Each record is merged by libwally, so the result is the same as \
+   *    calling Combine for each psbt in order.
+   * @param[in] psbt_list       combine target psbt list.
+   * @param[in] thread_count    thread count (0: hardware concurrency)
+   */
+  void Combine(const std::vector<Psbt>& psbt_list, uint32_t thread_count = 0);
 
   /**
    * @brief Get transaction fee. (only if HasAllUtxos is true.)
@@ -497,6 +521,20 @@ class CFD_EXPORT Psbt : public cfd::core::Psbt {
 
   // GetTxOutXXXX is see `cfd::core::Psbt`
 
+  using cfd::core::Psbt::Sign;
+  /**
+   * @brief sign all inputs that match the privkey list with multiple threads.
+   * @details The signatures are the same as the serial sign. \
+   *    The standard inputs are signed in parallel, and only the privkeys \
+   *    of the unsupported inputs (taproot, etc) use the serial sign.
+   * @param[in] privkey_list    privkey list
+   * @param[in] has_grind_r     grind-r flag
+   * @param[in] thread_count    thread count (0: hardware concurrency)
+   */
+  void Sign(
+      const std::vector<Privkey>& privkey_list, bool has_grind_r = true,
+      uint32_t thread_count = 0);
+
   /**
    * @brief set ignore verify target.
    * @param[in] outpoint    utxo target.
@@ -506,6 +544,12 @@ class CFD_EXPORT Psbt : public cfd::core::Psbt {
    * @brief verify tx sign (signature).
    */
   void Verify() const;
+  /**
+   * @brief verify tx sign (signature) with multiple threads.
+   * @details The unsigned transaction and the utxos are collected once.
+   * @param[in] thread_count    thread count (0: hardware concurrency)
+   */
+  void Verify(uint32_t thread_count) const;
   /**
    * @brief verify tx sign (signature) on outpoint.
    * @param[in] outpoint    utxo target.
@@ -549,11 +593,39 @@ class CFD_EXPORT Psbt : public cfd::core::Psbt {
   std::vector<UtxoData> GetUtxoDataAll(
       NetType net_type = NetType::kMainnet) const;
 
+  /**
+   * @brief Decode the utxo list from a binary psbt stream.
+   * @details The psbt records are read one by one, so a full previous \
+   *    transaction (non_witness_utxo) is only held while its txid is \
+   *    verified and the spent output is extracted. The peak memory is \
+   *    bounded by the largest single record. The descriptor is not set. \
+   *    The stream is read up to the end of the last input map.
+   * @param[in,out] stream    binary psbt stream.
+   * @param[in] net_type      network type
+   * @return utxo list. (If the utxo is not set, amount and locking script \
+   *    are empty.)
+   */
+  static std::vector<UtxoData> DecodeUtxoDataByStream(
+      std::istream* stream, NetType net_type = NetType::kMainnet);
+
  private:
   /**
    * @brief utxo verify ignore map. (outpoint)
    */
   std::set<OutPoint> verify_ignore_map_;
+  /**
+   * @brief txin index map. (outpoint -> txin index)
+   * @details rebuilt lazily from the psbt base tx.
+   */
+  mutable std::map<OutPoint, uint32_t> txin_index_map_;
+  /**
+   * @brief txin index map dirty flag.
+   */
+  mutable bool is_txin_index_dirty_ = true;
+  /**
+   * @brief txin index map mutex.
+   */
+  mutable std::mutex txin_index_mutex_;
 
   /**
    * @brief Get default sequence from locktime.
@@ -561,6 +633,29 @@ class CFD_EXPORT Psbt : public cfd::core::Psbt {
    * @retval 0xffffffff     disable locktime
    */
   uint32_t GetDefaultSequence() const;
+
+  /**
+   * @brief Find the txin index from the txin index map.
+   * @param[in] outpoint    outpoint
+   * @param[out] index      txin index
+   * @retval true   exist txin
+   * @retval false  txin not found
+   */
+  bool FindTxInIndex(const OutPoint& outpoint, uint32_t* index) const;
+  /**
+   * @brief Mark the txin index map as dirty.
+   */
+  void MarkTxInIndexDirty();
+
+  /**
+   * @brief Get the finalized txin for verification.
+   * @param[in] tx      unsigned transaction
+   * @param[in] index   txin index
+   * @param[out] utxo   utxo data
+   * @return txin with final script.
+   */
+  TxIn GetVerifyTxIn(
+      const Transaction& tx, uint32_t index, UtxoData* utxo) const;
 };
 
 }  // namespace cfd
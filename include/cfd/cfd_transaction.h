@@ -8,6 +8,7 @@
 #define CFD_INCLUDE_CFD_CFD_TRANSACTION_H_
 
 #include <map>
+#include <mutex>  // NOLINT
 #include <set>
 #include <string>
 #include <vector>
@@ -93,6 +94,15 @@ class CFD_EXPORT TransactionContext : public Transaction {
    * @return Transaction context
    */
   TransactionContext& operator=(const TransactionContext& context) &;
+  /**
+   * @brief Copy the serialized transaction into the buffer.
+   * @details The transaction is serialized directly into the buffer.
+   *    If buffer is null or too small, only the data size is returned.
+   * @param[out] buffer       transaction byte buffer (nullable)
+   * @param[in] buffer_size   buffer size
+   * @return transaction byte data size
+   */
+  size_t CopyData(uint8_t* buffer, size_t buffer_size) const;
 
   /**
    * @brief Transaction's GetTxInIndex.
@@ -199,6 +209,67 @@ class CFD_EXPORT TransactionContext : public Transaction {
    */
   uint32_t GetVsizeIgnoreTxIn(bool use_witness = true) const;
 
+  /**
+   * @brief estimate a fee amount from this transaction.
+   * @param[in] utxos               using utxo data
+   * @param[out] txout_fee          tx fee amount (ignore utxo)
+   * @param[out] utxo_fee           utxo fee amount
+   * @param[in] effective_fee_rate  effective fee rate (minimum)
+   * @return tx fee (contains utxo)
+   */
+  Amount EstimateFee(
+      const std::vector<UtxoData>& utxos, Amount* txout_fee = nullptr,
+      Amount* utxo_fee = nullptr, double effective_fee_rate = 1) const;
+
+  /**
+   * @brief fund this transaction.
+   * @details The selected utxos are appended to txin, and the change is
+   *     appended to txout. The transaction is updated in place without
+   *     serializing.
+   * @param[in] utxos                    using utxo data
+   * @param[in] target_value             target value.
+   *    Amount more than the specified amount is set in txout.
+   *    default is 0 (disable).
+   * @param[in] selected_txin_utxos      selected txin utxo
+   * @param[in] reserve_address          address for adding txout.
+   *    Also serves as a change address.
+   * @param[in] effective_fee_rate       effective fee rate (minimum)
+   * @param[out] estimate_fee            estimate fee
+   * @param[in] filter                   utxo search filter
+   * @param[in] option_params            utxo search option
+   * @param[out] calculate_fee           calculate fee (before add dust amount)
+   * @return utxo list appended to txin.
+   */
+  std::vector<UtxoData> Fund(
+      const std::vector<UtxoData>& utxos, const Amount& target_value,
+      const std::vector<UtxoData>& selected_txin_utxos,
+      const Address& reserve_address, double effective_fee_rate = 20.0,
+      Amount* estimate_fee = nullptr, const UtxoFilter* filter = nullptr,
+      const CoinSelectionOption* option_params = nullptr,
+      Amount* calculate_fee = nullptr);
+  /**
+   * @brief fund copies of this transaction for each fee rate.
+   * @details The utxo pool and the estimated txin sizes are collected once
+   *     and shared by all fee rates. This transaction is not changed.
+   * @param[in] utxos                    using utxo data
+   * @param[in] target_value             target value.
+   * @param[in] selected_txin_utxos      selected txin utxo
+   * @param[in] reserve_address          address for adding txout.
+   * @param[in] fee_rates                effective fee rate list
+   * @param[out] estimate_fees           estimate fee list (fee_rates order)
+   * @param[in] filter                   utxo search filter
+   * @param[in] option_params            utxo search option.
+   *    The effective fee rate is overwritten by each fee rate.
+   * @return funded transaction list (fee_rates order)
+   */
+  std::vector<TransactionContext> FundByFeeRates(
+      const std::vector<UtxoData>& utxos, const Amount& target_value,
+      const std::vector<UtxoData>& selected_txin_utxos,
+      const Address& reserve_address, const std::vector<double>& fee_rates,
+      std::vector<Amount>* estimate_fees = nullptr,
+      const UtxoFilter* filter = nullptr,
+      const CoinSelectionOption* option_params = nullptr) const;
+
   // state-sequence-api
   /**
    * @brief add txin with utxo.
@@ -542,6 +613,58 @@ class CFD_EXPORT TransactionContext : public Transaction {
       const std::vector<OutPoint>& list, const OutPoint& outpoint) const;
 
  private:
+  friend class PayoutBatcher;
+  struct FundingPool;
+
+  /**
+   * @brief collect the utxo pool for funding.
+   * @param[in] utxos                    using utxo data
+   * @param[in] selected_txin_utxos      selected txin utxo
+   * @param[out] pool                    utxo pool
+   */
+  void CollectFundingPool(
+      const std::vector<UtxoData>& utxos,
+      const std::vector<UtxoData>& selected_txin_utxos,
+      FundingPool* pool) const;
+  /**
+   * @brief fund this transaction from the utxo pool.
+   * @param[in,out] pool                 utxo pool
+   * @param[in] target_value             target value.
+   * @param[in] reserve_address          address for adding txout.
+   * @param[in] effective_fee_rate       effective fee rate (minimum)
+   * @param[in] utxo_filter              utxo search filter
+   * @param[in] option                   utxo search option
+   * @param[out] estimate_fee            estimate fee
+   * @param[out] calculate_fee           calculate fee (before add dust amount)
+   * @return utxo list appended to txin.
+   */
+  std::vector<UtxoData> FundByPool(
+      FundingPool* pool, const Amount& target_value,
+      const Address& reserve_address, double effective_fee_rate,
+      const UtxoFilter& utxo_filter, const CoinSelectionOption& option,
+      Amount* estimate_fee, Amount* calculate_fee);
+
+  /**
+   * @brief find the txin index without the exception.
+   * @param[in] outpoint    TxIn txid and vout
+   * @param[out] index      txin index
+   * @retval true   exist
+   * @retval false  not exist
+   */
+  bool FindTxInIndex(const OutPoint& outpoint, uint32_t* index) const;
+  /**
+   * @brief find the first txout index without the exception.
+   * @param[in] locking_script    locking script
+   * @param[out] index            txout index
+   * @retval true   exist
+   * @retval false  not exist
+   */
+  bool FindTxOutIndex(const Script& locking_script, uint32_t* index) const;
+  /**
+   * @brief mark the txin index map to rebuild on the next miss.
+   */
+  void MarkTxInIndexDirty();
+
   /**
    * @brief utxo map.
    */
@@ -558,6 +681,96 @@ class CFD_EXPORT TransactionContext : public Transaction {
    * @brief utxo verify ignore map. (outpoint)
    */
   std::vector<OutPoint> verify_ignore_map_;
+  /**
+   * @brief txin index map. (outpoint, txin index)
+   */
+  mutable std::map<OutPoint, uint32_t> txin_index_map_;
+  /**
+   * @brief txin index map is changed.
+   */
+  mutable bool is_txin_index_dirty_ = true;
+  /**
+   * @brief txin index map mutex.
+   */
+  mutable std::mutex txin_index_mutex_;
+};
+
+/**
+ * @brief payout request data.
+ */
+struct PayoutRequest {
+  Address address;  //!< payout address
+  Amount amount;    //!< payout amount
+};
+
+/**
+ * @brief payout batch transaction data.
+ */
+struct PayoutBatchData {
+  /**
+   * @brief constructor.
+   */
+  PayoutBatchData() {}
+  /**
+   * @brief constructor.
+   * @param[in] version   Transaction version
+   * @param[in] locktime  Timestamp or block height
+   */
+  PayoutBatchData(uint32_t version, uint32_t locktime)
+      : transaction(version, locktime) {}
+
+  TransactionContext transaction;  //!< funded transaction
+  std::vector<UtxoData> utxos;     //!< utxo list appended to txin
+  std::vector<uint32_t> request_indexes;  //!< request index list of txout
+  Amount fee;                             //!< estimate fee
+};
+
+/**
+ * @brief Class for packing payout requests into funded transactions.
+ */
+class CFD_EXPORT PayoutBatcher {
+ public:
+  /**
+   * @brief constructor.
+   * @param[in] max_weight        maximum weight of a transaction. (0: unlimited)
+   * @param[in] max_txout_count   maximum payout txout count of a transaction.
+   *    (0: unlimited)
+   * @param[in] version           Transaction version
+   * @param[in] locktime          Timestamp or block height
+   */
+  explicit PayoutBatcher(
+      uint32_t max_weight, uint32_t max_txout_count = 0, uint32_t version = 2,
+      uint32_t locktime = 0);
+  /**
+   * @brief destructor.
+   */
+  virtual ~PayoutBatcher() {
+    // do nothing
+  }
+
+  /**
+   * @brief pack payout requests into transactions, and fund them.
+   * @details Requests are packed in order. Each transaction is funded from
+   *     the utxos left over by the preceding transactions.
+   * @param[in] requests             payout request list
+   * @param[in] utxos                shared utxo pool
+   * @param[in] reserve_address      change address
+   * @param[in] effective_fee_rate   effective fee rate (minimum)
+   * @param[in] filter               utxo search filter
+   * @param[in] option_params        utxo search option
+   * @return funded transaction list
+   */
+  std::vector<PayoutBatchData> CreateBatches(
+      const std::vector<PayoutRequest>& requests,
+      const std::vector<UtxoData>& utxos, const Address& reserve_address,
+      double effective_fee_rate = 20.0, const UtxoFilter* filter = nullptr,
+      const CoinSelectionOption* option_params = nullptr) const;
+
+ private:
+  uint32_t max_weight_;       //!< maximum weight
+  uint32_t max_txout_count_;  //!< maximum payout txout count
+  uint32_t version_;          //!< transaction version
+  uint32_t locktime_;         //!< transaction locktime
 };
 
 // ----------------------------------------------------------------------------
@@ -177,6 +177,23 @@ class CFD_EXPORT UtxoUtil {
    */
   static void ConvertToUtxo(
       const UtxoData& utxo_data, Utxo* utxo, UtxoData* dest = nullptr);
+  /**
+   * @brief convert to simple utxo list with multiple threads.
+   * @details The output order is the same as utxos. If errors is set,
+   *     a failed item is zero cleared and the error message is set to the
+   *     same index of errors. (empty message is success)
+   *     The library does not call this internally. The thread count is
+   *     chosen by the caller.
+   * @param[in] utxos           utxo data list
+   * @param[out] errors         error message list
+   * @param[in] thread_count    thread count
+   *     (1: calling thread only, 0: hardware concurrency)
+   * @return UTXO list
+   * @throw CfdException  if errors is null and conversion fails.
+   */
+  static std::vector<Utxo> ConvertToUtxoParallel(
+      const std::vector<UtxoData>& utxos,
+      std::vector<std::string>* errors = nullptr, uint32_t thread_count = 1);
 
  private:
   /**
@@ -125,6 +125,12 @@ class CFD_EXPORT CoinSelectionOption {
    * @return ignore fee asset flag.
    */
   bool HasIgnoreFeeAsset() const;
+  /**
+   * @brief Get the statistics collecting flag.
+   * @retval true   collect the statistics
+   * @retval false  not collect the statistics
+   */
+  bool IsCollectStatistics() const;
 
   /**
    * @brief Set the BnB using flag.
@@ -166,6 +172,12 @@ class CFD_EXPORT CoinSelectionOption {
    * @param[in] has_ignore_fee_asset    ignore fee asset
    */
   void SetIgnoreFeeAsset(bool has_ignore_fee_asset);
+  /**
+   * @brief Set the statistics collecting flag.
+   * @details The statistics are not collected by default.
+   * @param[in] is_collect    statistics collecting flag
+   */
+  void SetCollectStatistics(bool is_collect);
 
   /**
    * @brief Initializes size related information equivalent to bitcoin.
@@ -223,6 +235,7 @@ class CFD_EXPORT CoinSelectionOption {
   int64_t knapsack_minimum_change_;  //!< knapsack min change
   int64_t dust_fee_rate_;            //!< dust fee rate
   bool has_ignore_fee_asset_;        //!< ignore fee asset
+  bool is_collect_statistics_ = false;  //!< statistics collecting flag
 #ifndef CFD_DISABLE_ELEMENTS
   ConfidentialAssetId fee_asset_;  //!< asset to be used as a fee
   int exponent_ = 0;               //!< rangeproof exponent value
@@ -230,6 +243,22 @@ class CFD_EXPORT CoinSelectionOption {
 #endif  // CFD_DISABLE_ELEMENTS
 };
 
+/**
+ * @brief CoinSelection statistics data.
+ */
+struct CoinSelectionStatistics {
+  bool searched_bnb = false;  //!< Flag of whether you selected with BnB
+  uint32_t utxo_count = 0;    //!< utxo count after filtering
+  uint64_t bnb_tries = 0;     //!< BnB search tries
+  uint64_t bnb_backtracks = 0;       //!< BnB backtrack count
+  uint64_t knapsack_iterations = 0;  //!< knapsack subset iterations
+  int64_t waste = 0;                 //!< BnB waste metric
+  int64_t knapsack_excess = 0;       //!< knapsack excess amount over target
+  uint64_t bnb_elapsed_usec = 0;       //!< BnB elapsed time (usec)
+  uint64_t knapsack_elapsed_usec = 0;  //!< Knapsack elapsed time (usec)
+  uint64_t total_elapsed_usec = 0;     //!< total elapsed time (usec)
+};
+
 /**
  * @brief Class that performs CoinSelection calculation
  */
@@ -295,8 +324,19 @@ class CFD_EXPORT CoinSelection {
       AmountMap* map_utxo_fee_value = nullptr);
 #endif  // CFD_DISABLE_ELEMENTS
 
+  /**
+   * @brief Get the statistics of the last SelectCoins call.
+   * @details For the multi-asset version, the values of each asset \
+   *    are added up. The statistics are collected only when \
+   *    CoinSelectionOption::SetCollectStatistics is enabled.
+   * @return statistics data
+   */
+  const CoinSelectionStatistics& GetStatistics() const;
+
   /**
    * @brief Conversion to UTXO structure.
+   * @details For a list, set the fields to UtxoData and use \
+   *    UtxoUtil::ConvertToUtxoParallel.
    * @param[in] txid                txid
    * @param[in] vout                vout
    * @param[in] output_descriptor   output descriptor
@@ -313,6 +353,8 @@ class CFD_EXPORT CoinSelection {
 
   /**
    * @brief Conversion to UTXO structure.
+   * @details For a list, set the fields to UtxoData and use \
+   *    UtxoUtil::ConvertToUtxoParallel.
    * @param[in] block_height        block height
    * @param[in] block_hash          block hash
    * @param[in] txid                txid
@@ -334,6 +376,8 @@ class CFD_EXPORT CoinSelection {
 #ifndef CFD_DISABLE_ELEMENTS
   /**
    * @brief Conversion to UTXO structure.
+   * @details For a list, set the fields to UtxoData and use \
+   *    UtxoUtil::ConvertToUtxoParallel.
    * @param[in] block_height        block height
    * @param[in] block_hash          block hash
    * @param[in] txid                txid
@@ -413,6 +457,8 @@ class CFD_EXPORT CoinSelection {
  private:
   bool use_bnb_;                       //!< BnB using flag
   std::vector<bool> randomize_cache_;  //!< randomize cache
+  CoinSelectionStatistics statistics_;  //!< statistics of the last selection
+  bool is_collect_statistics_ = false;  //!< statistics collecting flag
 
   /**
    * Determine the UTXO list with the total amount closest to the collected amount
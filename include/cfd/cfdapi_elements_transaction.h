@@ -32,6 +32,7 @@
 namespace cfd {
 namespace api {
 
+using cfd::ElementsUtxoAndOption;
 using cfd::FeeCalculator;
 using cfd::core::AddressFormatData;
 using cfd::core::Amount;
@@ -187,19 +188,6 @@ struct IssuanceOutput {
   IssuanceParameter output;  //!< issuance output
 };
 
-/**
- * @brief Using utxo and option data in elements
- */
-struct ElementsUtxoAndOption {
-  UtxoData utxo;                       //!< utxo
-  bool is_issuance = false;            //!< use issuance/reissuance
-  bool is_blind_issuance = false;      //!< use blind issuance/reissuance
-  bool is_pegin = false;               //!< use pegin
-  uint32_t pegin_btc_tx_size = 0;      //!< btc pegin tx size
-  Script claim_script;                 //!< claim script for pegin
-  uint32_t pegin_txoutproof_size = 0;  //!< btc pegin txoutproof size
-};
-
 /**
  * @brief Elements用Transaction関連の関数群クラス
  */
@@ -593,6 +581,44 @@ class CFD_EXPORT ElementsTransactionApi {
       const std::vector<AddressFormatData>* prefix_list = nullptr,
       Amount* calculate_fee = nullptr) const;
 
+  /**
+   * @brief fund transaction on the transaction context.
+   * @details The transaction is updated in place without serializing.
+   *   If an exception occurs, the transaction state is undefined.
+   * @param[in,out] transaction          transaction context
+   * @param[in] utxos                    using utxo data
+   * @param[in] map_target_value         asset target value map.
+   *    Amount more than the specified amount is set in txout.
+   *    default is 0 (disable).
+   * @param[in] selected_txin_utxos      selected txin utxo
+   * @param[in] reserve_txout_address    address for adding txout.
+   *    Also serves as a change address.
+   * @param[in] fee_asset                using fee asset
+   * @param[in] is_blind_estimate_fee    using tx blinding
+   * @param[in] effective_fee_rate       effective fee rate (minimum)
+   * @param[out] estimate_fee            estimate fee
+   * @param[in] filter                   utxo search filter
+   * @param[in] option_params            utxo search option
+   * @param[out] append_txout_addresses  used txout additional address
+   * @param[in] net_type                 network type
+   * @param[in] prefix_list              address prefix list
+   * @param[out] calculate_fee           calculate fee (before add dust amount)
+   */
+  void FundTransaction(
+      ConfidentialTransactionContext* transaction,
+      const std::vector<UtxoData>& utxos,
+      const std::map<std::string, Amount>& map_target_value,
+      const std::vector<ElementsUtxoAndOption>& selected_txin_utxos,
+      const std::map<std::string, std::string>& reserve_txout_address,
+      const ConfidentialAssetId& fee_asset, bool is_blind_estimate_fee = true,
+      double effective_fee_rate = 1, Amount* estimate_fee = nullptr,
+      const UtxoFilter* filter = nullptr,
+      const CoinSelectionOption* option_params = nullptr,
+      std::vector<std::string>* append_txout_addresses = nullptr,
+      NetType net_type = NetType::kLiquidV1,
+      const std::vector<AddressFormatData>* prefix_list = nullptr,
+      Amount* calculate_fee = nullptr) const;
+
   // CreateDestroyAmountTransaction
   // see CreateRawTransaction and ConfidentialTxOut::CreateDestroyAmountTxOut
 };
@@ -0,0 +1,235 @@
+/* Copyright 2021 CryptoGarage */
+/**
+ * @file cfdcapi_async.h
+ *
+ * @brief API definition file of asynchronous execution for used in cfd-capi
+ * @details The heavy operation (e.g. CfdFinalizeBlindTx, \
+ *   CfdFinalizeFundRawTx, CfdFinalizeFundPsbt, CfdFinalizeCoinSelection) \
+ *   is executed on the bounded worker thread pool.
+ */
+#ifndef CFD_INCLUDE_CFDC_CFDCAPI_ASYNC_H_
+#define CFD_INCLUDE_CFDC_CFDCAPI_ASYNC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#if 0
+}
+#endif
+#endif /* __cplusplus */
+
+#include "cfdc/cfdcapi_common.h"
+
+/**
+ * @brief async task status.
+ */
+enum CfdAsyncTaskStatus {
+  /** task is waiting in the queue */
+  kCfdAsyncTaskPending = 0,
+  /** task is running */
+  kCfdAsyncTaskRunning = 1,
+  /** task is completed */
+  kCfdAsyncTaskCompleted = 2,
+  /** task is cancelled */
+  kCfdAsyncTaskCancelled = 3,
+};
+
+/**
+ * @brief async task function.
+ * @details The function is called on the worker thread. \
+ *   Use the passed handle for the cfd-capi call. \
+ *   Its error state is copied to the caller handle by CfdWaitAsyncTask.
+ * @param[in] handle      cfd handle of the worker thread.
+ * @param[in] context     user context.
+ * @return CfdErrorCode
+ */
+typedef int (*CfdAsyncTaskFunction)(void* handle, void* context);
+
+/**
+ * @brief async task completion callback.
+ * @details The callback is called once on completion or cancellation. \
+ *   On completion it runs on the worker thread, \
+ *   and on cancellation it runs on the cancelling thread. \
+ *   The status seen by CfdWaitAsyncTask changes after the callback returns.
+ * @param[in] context     user context.
+ * @param[in] status      task status. (CfdAsyncTaskStatus)
+ * @param[in] result      task result. (CfdErrorCode)
+ */
+typedef void (*CfdAsyncTaskCallback)(void* context, int status, int result);
+
+/**
+ * @brief create async worker pool.
+ * @param[in] handle          cfd handle.
+ * @param[in] thread_count    worker thread count. (0 is hardware concurrency)
+ * @param[in] max_queue_size  max pending task count. (0 is unlimited)
+ * @param[out] worker_handle  async worker handle.
+ *   Call 'CfdFreeAsyncWorker' after you are finished using it.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdCreateAsyncWorker(
+    void* handle, uint32_t thread_count, uint32_t max_queue_size,
+    void** worker_handle);
+
+/**
+ * @brief submit async task.
+ * @details If the pending queue is full, kCfdOutOfRangeError is returned \
+ *   without queueing. Retry after the running task is completed.
+ * @param[in] handle          cfd handle.
+ * @param[in] worker_handle   async worker handle.
+ * @param[in] function        task function.
+ * @param[in] callback        completion callback. (nullable)
+ * @param[in] context         user context. (nullable)
+ * @param[out] task_handle    async task handle. (nullable)
+ *   Call 'CfdFreeAsyncTask' after you are finished using it.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdSubmitAsyncTask(
+    void* handle, void* worker_handle, CfdAsyncTaskFunction function,
+    CfdAsyncTaskCallback callback, void* context, void** task_handle);
+
+/**
+ * @brief wait async task.
+ * @details If timeout_msec is 0, the status is polled without waiting. \
+ *   If the task failed, the error state is set to the handle.
+ * @param[in] handle          cfd handle.
+ * @param[in] task_handle     async task handle.
+ * @param[in] timeout_msec    timeout. (millisecond)
+ * @param[out] status         task status. (CfdAsyncTaskStatus)
+ * @param[out] result         task result. (CfdErrorCode, nullable)
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdWaitAsyncTask(
+    void* handle, void* task_handle, uint32_t timeout_msec, int* status,
+    int* result);
+
+/**
+ * @brief cancel async task.
+ * @details Only the pending task can be cancelled. \
+ *   If the task is already running, kCfdIllegalStateError is returned.
+ * @param[in] handle          cfd handle.
+ * @param[in] task_handle     async task handle.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdCancelAsyncTask(void* handle, void* task_handle);
+
+/**
+ * @brief free async task handle.
+ * @details The task itself is not cancelled.
+ * @param[in] handle          cfd handle.
+ * @param[in] task_handle     async task handle.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdFreeAsyncTask(void* handle, void* task_handle);
+
+/**
+ * @brief free async worker pool.
+ * @details The pending tasks are cancelled, \
+ *   and the running tasks are waited for completion.
+ * @param[in] handle          cfd handle.
+ * @param[in] worker_handle   async worker handle.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdFreeAsyncWorker(void* handle, void* worker_handle);
+
+#ifndef CFD_DISABLE_ELEMENTS
+/**
+ * @brief submit CfdFinalizeBlindTx as async task.
+ * @details The input string is copied on submit. \
+ *   The blind handle and the output buffer must be kept \
+ *   and not be used until the task is completed.
+ * @param[in] handle          cfd handle.
+ * @param[in] worker_handle   async worker handle.
+ * @param[in] blind_handle    blind handle.
+ * @param[in] tx_hex_string   transaction hex.
+ * @param[in] callback        completion callback. (nullable)
+ * @param[in] context         user context. (nullable)
+ * @param[out] tx_string      blinded transaction hex.
+ *   If 'CfdFreeStringBuffer' is implemented,
+ *   Call 'CfdFreeStringBuffer' after you are finished using it.
+ * @param[out] task_handle    async task handle. (nullable)
+ *   Call 'CfdFreeAsyncTask' after you are finished using it.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdSubmitFinalizeBlindTx(
+    void* handle, void* worker_handle, void* blind_handle,
+    const char* tx_hex_string, CfdAsyncTaskCallback callback, void* context,
+    char** tx_string, void** task_handle);
+#endif /* CFD_DISABLE_ELEMENTS */
+
+/**
+ * @brief submit CfdFinalizeFundRawTx as async task.
+ * @details The input string is copied on submit. \
+ *   The fund handle and the output buffers must be kept \
+ *   and not be used until the task is completed.
+ * @param[in] handle              cfd handle.
+ * @param[in] worker_handle       async worker handle.
+ * @param[in] fund_handle         fund handle.
+ * @param[in] tx_hex              transaction hex.
+ * @param[in] effective_fee_rate  effective fee rate.
+ * @param[in] callback            completion callback. (nullable)
+ * @param[in] context             user context. (nullable)
+ * @param[out] tx_fee             tx fee.
+ * @param[out] append_txout_count append txout count.
+ * @param[out] output_tx_hex      output transaction hex.
+ *   If 'CfdFreeStringBuffer' is implemented,
+ *   Call 'CfdFreeStringBuffer' after you are finished using it.
+ * @param[out] task_handle        async task handle. (nullable)
+ *   Call 'CfdFreeAsyncTask' after you are finished using it.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdSubmitFinalizeFundRawTx(
+    void* handle, void* worker_handle, void* fund_handle, const char* tx_hex,
+    double effective_fee_rate, CfdAsyncTaskCallback callback, void* context,
+    int64_t* tx_fee, uint32_t* append_txout_count, char** output_tx_hex,
+    void** task_handle);
+
+/**
+ * @brief submit CfdFinalizeFundPsbt as async task.
+ * @details The input string is copied on submit. \
+ *   The psbt handle, the fund handle and the output buffers must be kept \
+ *   and not be used until the task is completed.
+ * @param[in] handle                      cfd handle.
+ * @param[in] worker_handle               async worker handle.
+ * @param[in] psbt_handle                 psbt handle.
+ * @param[in] fund_handle                 fund handle.
+ * @param[in] change_address_descriptor   change address descriptor.
+ * @param[in] callback                    completion callback. (nullable)
+ * @param[in] context                     user context. (nullable)
+ * @param[out] tx_fee                     tx fee.
+ * @param[out] used_utxo_count            used utxo count.
+ * @param[out] task_handle                async task handle. (nullable)
+ *   Call 'CfdFreeAsyncTask' after you are finished using it.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdSubmitFinalizeFundPsbt(
+    void* handle, void* worker_handle, void* psbt_handle, void* fund_handle,
+    const char* change_address_descriptor, CfdAsyncTaskCallback callback,
+    void* context, int64_t* tx_fee, uint32_t* used_utxo_count,
+    void** task_handle);
+
+/**
+ * @brief submit CfdFinalizeCoinSelection as async task.
+ * @details The coin selection handle and the output buffer must be kept \
+ *   and not be used until the task is completed.
+ * @param[in] handle              cfd handle.
+ * @param[in] worker_handle       async worker handle.
+ * @param[in] coin_select_handle  coin select handle.
+ * @param[in] callback            completion callback. (nullable)
+ * @param[in] context             user context. (nullable)
+ * @param[out] utxo_fee_amount    utxo fee amount.
+ * @param[out] task_handle        async task handle. (nullable)
+ *   Call 'CfdFreeAsyncTask' after you are finished using it.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdSubmitFinalizeCoinSelection(
+    void* handle, void* worker_handle, void* coin_select_handle,
+    CfdAsyncTaskCallback callback, void* context, int64_t* utxo_fee_amount,
+    void** task_handle);
+
+#ifdef __cplusplus
+#if 0
+{
+#endif
+}
+#endif /* __cplusplus */
+
+#endif /* CFD_INCLUDE_CFDC_CFDCAPI_ASYNC_H_ NOLINT */
@@ -25,6 +25,8 @@ enum CfdCoinSelectionOption {
   kCfdCoinSelectionExponent = 1,
   /** blind option: minBits */
   kCfdCoinSelectionMinimumBits = 2,
+  /** collect the statistics (bool, default: false) */
+  kCfdCoinSelectionCollectStatistics = 3,
 };
 
 /** estimate fee option */
@@ -153,6 +155,33 @@ CFDC_API int CfdGetSelectedCoinAssetAmount(
     void* handle, void* coin_select_handle, uint32_t asset_index,
     int64_t* amount);
 
+/**
+ * @brief Get the statistics of the coin selection.
+ * @details Call after 'CfdFinalizeCoinSelection'. \
+ *   For multiple assets, the values of each asset are added up. \
+ *   The statistics are collected only when the \
+ *   'kCfdCoinSelectionCollectStatistics' option is set.
+ * @param[in] handle                  handle pointer.
+ * @param[in] coin_select_handle      coin selection handle.
+ * @param[out] searched_bnb           selected with BnB.
+ * @param[out] utxo_count             utxo count after filtering.
+ * @param[out] bnb_tries              BnB search tries.
+ * @param[out] bnb_backtracks         BnB backtrack count.
+ * @param[out] knapsack_iterations    knapsack subset iterations.
+ * @param[out] waste                  BnB waste metric.
+ * @param[out] knapsack_excess        knapsack excess amount over target.
+ * @param[out] bnb_elapsed_usec       BnB elapsed time. (usec)
+ * @param[out] knapsack_elapsed_usec  knapsack elapsed time. (usec)
+ * @param[out] total_elapsed_usec     total elapsed time. (usec)
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdGetCoinSelectionStatistics(
+    void* handle, void* coin_select_handle, bool* searched_bnb,
+    uint32_t* utxo_count, uint64_t* bnb_tries, uint64_t* bnb_backtracks,
+    uint64_t* knapsack_iterations, int64_t* waste, int64_t* knapsack_excess,
+    uint64_t* bnb_elapsed_usec, uint64_t* knapsack_elapsed_usec,
+    uint64_t* total_elapsed_usec);
+
 /**
  * @brief free coin selection handle.
  * @param[in] handle              handle pointer.
@@ -130,6 +130,8 @@ CFDC_API int CfdCopyErrorState(void* source, void* destination);
 
 /**
  * @brief Free cfd handle.
+ * @details The handle must be freed only once. The freed handle is \
+ *   not always detected, because its memory can be reused by a new handle.
  * @param[in] handle    handle pointer
  * @return CfdErrorCode
  */
@@ -152,6 +154,38 @@ CFDC_API int CfdFreeBuffer(void* address);
 CFDC_API int CfdFreeStringBuffer(char* address);
 #endif /* CFD_DISABLE_FREESTRING NOLINT */
 
+/**
+ * @brief Start the string arena on the handle.
+ * @details While the arena is active, the strings returned by the api \
+ *   called with this handle are allocated from the arena, on any thread. \
+ *   CfdFreeStringBuffer does nothing for the arena strings, \
+ *   even after CfdEndStringArena, CfdFreeHandle or on another thread. \
+ *   They are released by CfdResetStringArena or CfdFreeHandle, \
+ *   and must not be used after that. The arena blocks are reused \
+ *   by the next arena, and are kept until the process exit.
+ * @param[in] handle        handle pointer.
+ * @param[in] block_size    arena block size. (0 is default size)
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdBeginStringArena(void* handle, uint32_t block_size);
+
+/**
+ * @brief End the string arena on the handle.
+ * @details The arena strings are still available until \
+ *   CfdResetStringArena or CfdFreeHandle.
+ * @param[in] handle    handle pointer.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdEndStringArena(void* handle);
+
+/**
+ * @brief Release all strings on the string arena.
+ * @details The arena blocks are kept for the next request.
+ * @param[in] handle    handle pointer.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdResetStringArena(void* handle);
+
 /**
  * @brief Get last error code on cfd handle.
  * @param[in] handle    handle pointer.
@@ -82,6 +82,20 @@ CFDC_API int CfdCreatePsbtHandle(
     const char* tx_hex_string, uint32_t version, uint32_t locktime,
     void** psbt_handle);
 
+/**
+ * @brief Create PSBT handle from binary data.
+ * @param[in,out] handle      cfd handle.
+ * @param[in] net_type        network type.
+ * @param[in] psbt_bytes      psbt binary data.
+ * @param[in] psbt_size       psbt binary data size.
+ * @param[out] psbt_handle    psbt handle.
+ *   Call 'CfdFreePsbtHandle' after you are finished using it.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdCreatePsbtHandleByBytes(
+    void* handle, int net_type, const uint8_t* psbt_bytes, size_t psbt_size,
+    void** psbt_handle);
+
 /**
  * @brief Free PSBT handle.
  * @param[in,out] handle        cfd handle.
@@ -105,6 +119,22 @@ CFDC_API int CfdFreePsbtHandle(void* handle, void* psbt_handle);
 CFDC_API int CfdGetPsbtData(
     void* handle, void* psbt_handle, char** psbt_base64, char** psbt_hex);
 
+/**
+ * @brief Get a PSBT binary data.
+ * @details If psbt_buffer is null, only the data size is set.
+ *   If buffer_size is less than the data size, kCfdOutOfRangeError \
+ *   is returned with the data size.
+ * @param[in,out] handle        cfd handle.
+ * @param[in] psbt_handle       psbt handle.
+ * @param[out] psbt_buffer      psbt binary buffer. (nullable)
+ * @param[in] buffer_size       psbt binary buffer size.
+ * @param[out] data_size        psbt binary data size.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdGetPsbtBytes(
+    void* handle, void* psbt_handle, uint8_t* psbt_buffer, size_t buffer_size,
+    size_t* data_size);
+
 /**
  * @brief Get PSBT data.
  * @param[in,out] handle        cfd handle.
@@ -142,6 +172,29 @@ CFDC_API int CfdJoinPsbt(
 CFDC_API int CfdSignPsbt(
     void* handle, void* psbt_handle, const char* privkey, bool has_grind_r);
 
+/**
+ * @brief Add a privkey for the psbt sign.
+ * @details Sign is executed by 'CfdSignPsbtByPrivkeyList'.
+ * @param[in,out] handle        cfd handle.
+ * @param[in,out] psbt_handle   psbt handle.
+ * @param[in] privkey           privkey (wif or hex).
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdAddSignPsbtPrivkey(
+    void* handle, void* psbt_handle, const char* privkey);
+
+/**
+ * @brief Sign all inputs with the privkeys added by 'CfdAddSignPsbtPrivkey'.
+ * @details The inputs are signed with multiple threads.
+ * @param[in,out] handle        cfd handle.
+ * @param[in,out] psbt_handle   psbt handle.
+ * @param[in] has_grind_r       grind-r flag.
+ * @param[in] thread_count      thread count. (0: hardware concurrency)
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdSignPsbtByPrivkeyList(
+    void* handle, void* psbt_handle, bool has_grind_r, uint32_t thread_count);
+
 /**
  * @brief Combine a PSBT.
  * @param[in,out] handle            cfd handle.
@@ -152,6 +205,27 @@ CFDC_API int CfdSignPsbt(
 CFDC_API int CfdCombinePsbt(
     void* handle, void* psbt_handle, const char* psbt_combine_base64);
 
+/**
+ * @brief Add a combine target PSBT.
+ * @details Combine is executed by 'CfdFinalizeCombinePsbt'.
+ * @param[in,out] handle            cfd handle.
+ * @param[in,out] psbt_handle       psbt handle.
+ * @param[in] psbt_combine_base64   combine target psbt base64.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdAddCombinePsbtData(
+    void* handle, void* psbt_handle, const char* psbt_combine_base64);
+
+/**
+ * @brief Combine all PSBTs added by 'CfdAddCombinePsbtData'.
+ * @param[in,out] handle        cfd handle.
+ * @param[in,out] psbt_handle   psbt handle.
+ * @param[in] thread_count      thread count. (0: hardware concurrency)
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdFinalizeCombinePsbt(
+    void* handle, void* psbt_handle, uint32_t thread_count);
+
 /**
  * @brief Finalize a PSBT.
  * @param[in,out] handle        cfd handle.
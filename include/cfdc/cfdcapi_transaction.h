@@ -54,6 +54,82 @@ enum CfdFundTxOption {
   kCfdFundTxBlindMinimumBits = 6,
 };
 
+/** txin data for the bulk getter */
+struct CfdTxInData {
+  /** txid byte data (serialized byte order) */
+  uint8_t txid[32];
+  /** vout */
+  uint32_t vout;
+  /** sequence number */
+  uint32_t sequence;
+  /** script signature offset on the data buffer */
+  size_t script_sig_offset;
+  /** script signature size */
+  size_t script_sig_size;
+  /** first witness stack index on the witness list */
+  uint32_t witness_index;
+  /** witness stack count */
+  uint32_t witness_count;
+};
+
+/** txin sign data for the batch sign */
+struct CfdTxInSignData {
+  /** txid byte data (serialized byte order) */
+  uint8_t txid[32];
+  /** vout */
+  uint32_t vout;
+  /** hash type (used on the signature) */
+  int hash_type;
+  /** privkey hex or wif (nullable. if set, sign with privkey) */
+  const char* privkey;
+  /** pubkey hex (used on the signature) */
+  const char* pubkey;
+  /** signature hex (used on the signature) */
+  const char* signature;
+  /** use der encode (used on the signature) */
+  bool use_der_encode;
+  /** sighash type */
+  int sighash_type;
+  /** sighash anyone can pay flag */
+  bool sighash_anyone_can_pay;
+  /** utxo amount (used with the descriptor or the locking script) */
+  int64_t amount;
+  /** utxo value commitment hex (elements only, nullable) */
+  const char* commitment;
+  /** utxo descriptor (nullable. if set, the utxo is set on the tx) */
+  const char* descriptor;
+  /** utxo locking script hex (nullable. used if descriptor is empty) */
+  const char* locking_script;
+  /** aux rand for schnorr signature (bitcoin only, nullable) */
+  const char* aux_rand;
+  /** taproot annex hex (bitcoin only, nullable) */
+  const char* annex;
+};
+
+/** txout data for the bulk getter */
+struct CfdTxOutData {
+  /** satoshi value (blinded value is 0) */
+  int64_t value_satoshi;
+  /** asset byte data (elements only. bitcoin is all zero) */
+  uint8_t asset[33];
+  /** value commitment (elements blinded only. otherwise all zero) */
+  uint8_t value_commitment[33];
+  /** nonce byte data (elements only. empty nonce is all zero) */
+  uint8_t nonce[33];
+  /** locking script offset on the data buffer */
+  size_t locking_script_offset;
+  /** locking script size */
+  size_t locking_script_size;
+};
+
+/** byte range on the data buffer for the bulk getter */
+struct CfdTxDataRange {
+  /** offset on the data buffer */
+  size_t offset;
+  /** data size */
+  size_t size;
+};
+
 /**
  * @brief create initialized transaction.
  * @param[in] handle          cfd handle.
@@ -69,6 +145,22 @@ CFDC_API int CfdInitializeTransaction(
     void* handle, int net_type, uint32_t version, uint32_t locktime,
     const char* tx_hex_string, void** create_handle);
 
+/**
+ * @brief create initialized transaction from binary data.
+ * @param[in] handle          cfd handle.
+ * @param[in] net_type        network type.
+ * @param[in] version         transaction version.
+ * @param[in] locktime        lock time.
+ * @param[in] tx_bytes        transaction binary data. (nullable)
+ * @param[in] tx_size         transaction binary data size.
+ * @param[out] create_handle  create transaction handle.
+ *   Call 'CfdFreeTransactionHandle' after you are finished using it.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdInitializeTransactionByBytes(
+    void* handle, int net_type, uint32_t version, uint32_t locktime,
+    const uint8_t* tx_bytes, size_t tx_size, void** create_handle);
+
 /**
  * @brief add transaction input.
  * @param[in] handle          cfd handle.
@@ -318,6 +410,29 @@ CFDC_API int CfdAddScriptHashLastSignByHandle(
     void* handle, void* create_handle, const char* txid, uint32_t vout,
     int hash_type, const char* redeem_script);
 
+/**
+ * @brief Add the sign on multiple transaction inputs.
+ * @details If the privkey is set, sign with the privkey. \
+ *   The utxo is taken from the descriptor or the locking script \
+ *   of the entry, or from CfdSetTransactionUtxoData. \
+ *   (The utxo already set on the tx is used first.) \
+ *   Otherwise, add the pubkey and the signature. \
+ *   All entries are processed even if some entry fails, \
+ *   and the first failure is set to the last error.
+ * @param[in] handle            cfd handle.
+ * @param[in] create_handle     create transaction handle.
+ * @param[in] sign_list         txin sign data list.
+ * @param[in] sign_list_size    txin sign data list size.
+ * @param[in] has_grind_r       grind-r flag (used on the privkey).
+ * @param[out] result_list      result list. (CfdErrorCode, nullable)
+ *   The size is the same as sign_list_size.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdAddSignListByHandle(
+    void* handle, void* create_handle,
+    const struct CfdTxInSignData* sign_list, uint32_t sign_list_size,
+    bool has_grind_r, int* result_list);
+
 /**
  * @brief finalize and execute createrawtransaction.
  * @param[in] handle            cfd handle.
@@ -331,6 +446,23 @@ CFDC_API int CfdAddScriptHashLastSignByHandle(
 CFDC_API int CfdFinalizeTransaction(
     void* handle, void* create_handle, char** tx_hex_string);
 
+/**
+ * @brief finalize and get the transaction binary data.
+ * @details If tx_buffer is null, only the data size is set.
+ *   If buffer_size is less than the data size, kCfdOutOfRangeError \
+ *   is returned with the data size.
+ * @param[in] handle            cfd handle.
+ * @param[in] create_handle     create transaction handle.
+ * @param[out] tx_buffer        tx binary buffer. (nullable)
+ * @param[in] buffer_size       tx binary buffer size.
+ * @param[out] data_size        tx binary data size.
+ * @return CfdErrorCode
+ * @see CfdInitializeTransactionByBytes
+ */
+CFDC_API int CfdFinalizeTransactionBytes(
+    void* handle, void* create_handle, uint8_t* tx_buffer, size_t buffer_size,
+    size_t* data_size);
+
 /**
  * @brief free create transaction handle.
  * @param[in] handle          handle pointer.
@@ -765,6 +897,19 @@ CFDC_API int CfdInitializeTxDataHandle(
     void* handle, int net_type, const char* tx_hex_string,
     void** tx_data_handle);
 
+/**
+ * @brief Initialize handle for transaction binary data.
+ * @param[in] handle              cfd handle.
+ * @param[in] net_type            network type.
+ * @param[in] tx_bytes            tx binary data.
+ * @param[in] tx_size             tx binary data size.
+ * @param[out] tx_data_handle     transaction data handle.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdInitializeTxDataHandleByBytes(
+    void* handle, int net_type, const uint8_t* tx_bytes, size_t tx_size,
+    void** tx_data_handle);
+
 /**
  * @brief free transaction data handle.
  * @param[in] handle            handle pointer.
@@ -785,6 +930,22 @@ CFDC_API int CfdFreeTxDataHandle(void* handle, void* tx_data_handle);
 CFDC_API int CfdGetModifiedTxByHandle(
     void* handle, void* tx_data_handle, char** tx_hex_string);
 
+/**
+ * @brief get transaction binary data.
+ * @details If tx_buffer is null, only the data size is set.
+ *   If buffer_size is less than the data size, kCfdOutOfRangeError \
+ *   is returned with the data size.
+ * @param[in] handle            handle pointer.
+ * @param[in] tx_data_handle    transaction data handle.
+ * @param[out] tx_buffer        tx binary buffer. (nullable)
+ * @param[in] buffer_size       tx binary buffer size.
+ * @param[out] data_size        tx binary data size.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdGetModifiedTxBytesByHandle(
+    void* handle, void* tx_data_handle, uint8_t* tx_buffer, size_t buffer_size,
+    size_t* data_size);
+
 /**
  * @brief get transaction information.
  * @param[in] handle            cfd handle.
@@ -861,6 +1022,56 @@ CFDC_API int CfdGetTxOutByHandle(
     void* handle, void* tx_data_handle, uint32_t index, int64_t* value_satoshi,
     char** locking_script, char** asset);
 
+/**
+ * @brief get all transaction inputs.
+ * @details If txin_list, witness_list and buffer are all null, \
+ *   only the counts and the data size are set.
+ *   If a list or the buffer is too small, kCfdOutOfRangeError \
+ *   is returned with the counts and the data size.
+ * @param[in] handle              cfd handle.
+ * @param[in] tx_data_handle      transaction data handle.
+ * @param[in] stack_type          witness stack type. (CfdTxWitnessStackType)
+ * @param[out] txin_list          txin list. (nullable)
+ * @param[in] txin_list_size      txin list size.
+ * @param[out] witness_list       witness stack range list. (nullable)
+ * @param[in] witness_list_size   witness stack range list size.
+ * @param[out] buffer             script and witness data buffer. (nullable)
+ * @param[in] buffer_size         data buffer size.
+ * @param[out] txin_count         txin count.
+ * @param[out] witness_count      total witness stack count.
+ * @param[out] data_size          data size.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdGetTxInListByHandle(
+    void* handle, void* tx_data_handle, int stack_type,
+    struct CfdTxInData* txin_list, uint32_t txin_list_size,
+    struct CfdTxDataRange* witness_list, uint32_t witness_list_size,
+    uint8_t* buffer, size_t buffer_size, uint32_t* txin_count,
+    uint32_t* witness_count, size_t* data_size);
+
+/**
+ * @brief get all transaction outputs.
+ * @details If txout_list and buffer are both null, \
+ *   only the count and the data size are set. \
+ *   For elements, the blinded output has the value commitment \
+ *   instead of the satoshi value.
+ *   If the list or the buffer is too small, kCfdOutOfRangeError \
+ *   is returned with the count and the data size.
+ * @param[in] handle              cfd handle.
+ * @param[in] tx_data_handle      transaction data handle.
+ * @param[out] txout_list         txout list. (nullable)
+ * @param[in] txout_list_size     txout list size.
+ * @param[out] buffer             locking script buffer. (nullable)
+ * @param[in] buffer_size         data buffer size.
+ * @param[out] txout_count        txout count.
+ * @param[out] data_size          data size.
+ * @return CfdErrorCode
+ */
+CFDC_API int CfdGetTxOutListByHandle(
+    void* handle, void* tx_data_handle, struct CfdTxOutData* txout_list,
+    uint32_t txout_list_size, uint8_t* buffer, size_t buffer_size,
+    uint32_t* txout_count, size_t* data_size);
+
 /**
  * @brief get transaction input count.
  * @param[in] handle            cfd handle.
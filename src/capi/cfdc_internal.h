@@ -8,12 +8,15 @@
 #ifndef CFD_SRC_CAPI_CFDC_INTERNAL_H_
 #define CFD_SRC_CAPI_CFDC_INTERNAL_H_
 
+#include <atomic>
 #include <exception>
 #include <memory>
 #include <mutex>  // NOLINT
 #include <string>
 #include <vector>
 
+#include "cfd/cfd_elements_transaction.h"
+#include "cfd/cfd_transaction.h"
 #include "cfdc/cfdcapi_address.h"
 #include "cfdc/cfdcapi_common.h"
 #include "cfdcore/cfdcore_address.h"
@@ -105,6 +108,9 @@ struct CfdCapiTransactionData {
 
 /**
  * @brief allocate buffer.
+ * @details The buffer is taken from the thread-local size class pool.
+ *   The pool reuses the oldest released buffer after a few releases.
+ *   Define CFD_CAPI_DISABLE_BUFFER_POOL to use plain malloc.
  * @param[in] prefix  prefix string (max: 15 char)
  * @param[in] size    allocate size
  * @return buffer pointer
@@ -120,6 +126,118 @@ CFDC_API void* AllocBuffer(const std::string& prefix, uint32_t size);
 CFDC_API void FreeBuffer(
     void* address, const std::string& prefix, uint32_t size);
 
+//! buffer pool: max count per size class
+constexpr size_t kBufferPoolMaxCount = 64;
+//! vector pool: max count per type
+constexpr size_t kVectorPoolMaxCount = 16;
+//! vector pool: max capacity of the reused vector
+constexpr size_t kVectorPoolMaxCapacity = 1024;
+
+/**
+ * @brief thread-local pool of the vector.
+ * @details The vector cleared on release keeps its capacity for reuse.
+ *   When CFD_CAPI_DISABLE_BUFFER_POOL is defined, this is not used.
+ */
+template <typename T>
+class CfdCapiVectorPool {
+ public:
+  /**
+   * @brief destructor.
+   */
+  ~CfdCapiVectorPool() {
+    IsDestroyed() = true;
+    for (auto list : free_list_) delete list;
+  }
+  /**
+   * @brief Get the pool of the current thread.
+   * @return vector pool (null: destroyed on the thread exit)
+   */
+  static CfdCapiVectorPool<T>* GetInstance() {
+    if (IsDestroyed()) return nullptr;
+    static thread_local CfdCapiVectorPool<T> pool;
+    return &pool;
+  }
+  /**
+   * @brief Acquire the vector.
+   * @param[in] size  vector size
+   * @return vector
+   */
+  std::vector<T>* Acquire(size_t size) {
+    if (free_list_.empty()) return new std::vector<T>(size);
+    std::vector<T>* list = free_list_.back();
+    free_list_.pop_back();
+    list->resize(size);
+    return list;
+  }
+  /**
+   * @brief Release the vector.
+   * @param[in] list  vector
+   */
+  void Release(std::vector<T>* list) {
+    if ((free_list_.size() >= kVectorPoolMaxCount) ||
+        (list->capacity() > kVectorPoolMaxCapacity)) {
+      delete list;
+      return;
+    }
+    list->clear();
+    try {
+      free_list_.push_back(list);
+    } catch (...) {
+      delete list;
+    }
+  }
+
+ private:
+  std::vector<std::vector<T>*> free_list_;  //!< free vector list
+
+  /**
+   * @brief Get the destroyed flag of the pool on the current thread.
+   * @details The flag is trivially destructible, so it is available \
+   *    after the pool is destroyed.
+   * @return destroyed flag
+   */
+  static bool& IsDestroyed() {
+    static thread_local bool is_destroyed = false;
+    return is_destroyed;
+  }
+};
+
+/**
+ * @brief create the vector owned by the capi structure.
+ * @details The returned vector can also be released by delete.
+ * @param[in] size  vector size
+ * @return vector
+ */
+template <typename T>
+std::vector<T>* NewPooledVector(size_t size = 0) {
+#ifndef CFD_CAPI_DISABLE_BUFFER_POOL
+  CfdCapiVectorPool<T>* pool = CfdCapiVectorPool<T>::GetInstance();
+  if (pool != nullptr) return pool->Acquire(size);
+  return new std::vector<T>(size);
+#else
+  return new std::vector<T>(size);
+#endif  // CFD_CAPI_DISABLE_BUFFER_POOL
+}
+
+/**
+ * @brief delete the vector owned by the capi structure.
+ * @param[in] list  vector (nullable)
+ */
+template <typename T>
+void DeletePooledVector(std::vector<T>* list) {
+  if (list == nullptr) return;
+#ifndef CFD_CAPI_DISABLE_BUFFER_POOL
+  CfdCapiVectorPool<T>* pool = CfdCapiVectorPool<T>::GetInstance();
+  if (pool != nullptr) {
+    pool->Release(list);
+  } else {
+    delete list;  // after the pool is destroyed on the thread exit.
+  }
+#else
+  delete list;
+#endif  // CFD_CAPI_DISABLE_BUFFER_POOL
+}
+
 /**
  * @brief check buffer.
  * @param[in] address  buffer address.
@@ -206,6 +324,23 @@ CFDC_API void CheckNull(
  */
 CFDC_API char* CreateString(const std::string& message);
 
+/**
+ * @brief create string on the handle.
+ * @details If the string arena of the handle is active,
+ *   the string is allocated from the arena.
+ * @param[in] handle   handle pointer. (nullable)
+ * @param[in] message  message string.
+ * @return string buffer
+ */
+CFDC_API char* CreateString(void* handle, const std::string& message);
+
+/**
+ * @brief free string buffer.
+ * @details The string on any live string arena is not released.
+ * @param[in] address  string buffer.
+ */
+CFDC_API void FreeString(char* address);
+
 /**
  * @brief free heap buffer on error.
  * @param[in] pointer1  free address.
@@ -220,6 +355,62 @@ CFDC_API void FreeBufferOnError(
     char** pointer4 = nullptr, char** pointer5 = nullptr,
     char** pointer6 = nullptr);
 
+//! string arena default block size
+constexpr uint32_t kStringArenaBlockSize = 16384;
+//! string arena max block count on the process
+constexpr uint32_t kStringArenaBlockMaxCount = 4096;
+
+/**
+ * @brief string arena on the cfd handle.
+ * @details The strings are bump-allocated on the blocks.
+ *   The blocks are reused after the reset, and are returned to the process
+ *   block pool with the handle. The pooled blocks are kept until the process
+ *   exit, so the arena string is found by the address without the lock.
+ */
+class CfdCapiStringArena {
+ public:
+  /**
+   * @brief constructor.
+   * @param[in] block_size  block size.
+   */
+  explicit CfdCapiStringArena(uint32_t block_size);
+  /**
+   * @brief destructor.
+   * @details The blocks are returned to the process block pool.
+   */
+  ~CfdCapiStringArena();
+  /**
+   * @brief allocate the buffer.
+   * @details The new block is taken from the process block pool.
+   * @param[in] size  buffer size.
+   * @return buffer (null: inactive or the block pool is full)
+   */
+  char* Allocate(size_t size);
+  /**
+   * @brief release all strings on the arena.
+   */
+  void Reset();
+  /**
+   * @brief set the active state.
+   * @param[in] is_active  active state.
+   */
+  void SetActive(bool is_active);
+  /**
+   * @brief get the active state.
+   * @retval true   active (CfdBeginStringArena)
+   * @retval false  inactive
+   */
+  bool IsActive() const;
+
+ private:
+  mutable std::mutex mutex_;          //!< arena lock
+  std::vector<uint32_t> block_list_;  //!< pool index list of the blocks
+  size_t block_index_;                //!< current block index
+  size_t used_size_;                  //!< used size on block
+  size_t block_size_;                 //!< block size
+  bool is_active_;                    //!< active state
+};
+
 /**
  * @brief cfd-capiハンドル情報構造体.
  */
@@ -228,6 +419,10 @@ struct CfdCapiHandleData {
   int32_t error_code;          //!< error code
   bool is_outside;             //!< outside handle
   char error_message[256];     //!< error message
+  //! string arena (create by CfdBeginStringArena)
+  std::atomic<CfdCapiStringArena*> string_arena;
+  uint32_t shard_index;  //!< registry shard index
+  uint32_t slot_index;   //!< registry slot index
 };
 
 /**
@@ -262,8 +457,38 @@ CFDC_API int SetLastError(void* handle, const CfdException& exception);
  */
 CFDC_API void SetLastFatalError(void* handle, const std::exception& exception);
 
+/**
+ * @brief Get the read-only transaction parsed from the hex.
+ * @details The parsed transaction is cached on each thread,
+ *   so repeated calls with the same hex skip the re-parsing.
+ * @param[in] tx_hex    transaction hex
+ * @return transaction context
+ */
+CFDC_API std::shared_ptr<const cfd::TransactionContext> GetCachedTransaction(
+    const std::string& tx_hex);
+
+#ifndef CFD_DISABLE_ELEMENTS
+/**
+ * @brief Get the read-only confidential transaction parsed from the hex.
+ * @details The parsed transaction is cached on each thread,
+ *   so repeated calls with the same hex skip the re-parsing.
+ * @param[in] tx_hex    transaction hex
+ * @return confidential transaction context
+ */
+CFDC_API std::shared_ptr<const cfd::ConfidentialTransactionContext>
+GetCachedConfidentialTransaction(const std::string& tx_hex);
+#endif  // CFD_DISABLE_ELEMENTS
+
+//! handle registry shard count
+constexpr uint32_t kHandleShardCount = 16;
+
 /**
  * @brief cfd-capi管理クラス。
+ * @details The handles are registered on the sharded slot array.
+ *   Each thread uses its own shard, and the free slot is reused,
+ *   so the create and free are O(1) with low lock contention.
+ *   The handle is a raw pointer, so a stale handle whose memory is
+ *   reused by a new handle is not detected. (the new handle is freed)
  */
 class CfdCapiManager {
  public:
@@ -274,7 +499,7 @@ class CfdCapiManager {
   /**
    * @brief デストラクタ。
    */
-  virtual ~CfdCapiManager() { FreeAllList(&handle_list_); }
+  virtual ~CfdCapiManager();
 
   /**
    * @brief ハンドルを作成する。
@@ -284,6 +509,7 @@ class CfdCapiManager {
   void* CreateHandle(bool is_outside = false);
   /**
    * @brief ハンドルを解放する。
+   * @details The handle that is not on the registry slot is ignored.
    * @param[in] handle      ハンドル情報
    */
   void FreeHandle(void* handle);
@@ -316,14 +542,32 @@ class CfdCapiManager {
   CfdException GetLastError(void* handle);
 
  protected:
-  std::vector<CfdCapiHandleData*> handle_list_;  ///< ハンドル一覧
-  std::mutex mutex_;  ///< 排他制御用オブジェクト
+  /**
+   * @brief handle registry slot.
+   */
+  struct HandleSlot {
+    CfdCapiHandleData* handle;  //!< handle (null is free slot)
+  };
+  /**
+   * @brief handle registry shard.
+   */
+  struct HandleShard {
+    std::mutex mutex;                      //!< 排他制御用オブジェクト
+    std::vector<HandleSlot> slot_list;     //!< slot list
+    std::vector<uint32_t> free_slot_list;  //!< free slot index list
+  };
+  HandleShard shard_list_[kHandleShardCount];  ///< ハンドル一覧
 
+  /**
+   * @brief Get the shard index of the current thread.
+   * @return shard index
+   */
+  static uint32_t GetCurrentShardIndex();
   /**
    * @brief ハンドル一覧の解放を行う。
-   * @param[in,out] list  handle list
+   * @param[in,out] shard  handle shard
    */
-  static void FreeAllList(std::vector<CfdCapiHandleData*>* list);
+  static void FreeAllList(HandleShard* shard);
 };
 
 }  // namespace capi
@@ -182,16 +182,16 @@ int CfdCreateAddress(
 #endif  // CFD_DISABLE_ELEMENTS
     }
 
-    work_address = CreateString(addr.GetAddress());
+    work_address = CreateString(handle, addr.GetAddress());
     if (locking_script != nullptr) {
       if (!lock_script.IsEmpty()) {
-        work_locking_script = CreateString(lock_script.GetHex());
+        work_locking_script = CreateString(handle, lock_script.GetHex());
       }
     }
     if (p2sh_segwit_locking_script != nullptr) {
       if (!unlocking_script.IsEmpty()) {
         work_p2sh_segwit_locking_script =
-            CreateString(unlocking_script.GetHex());
+            CreateString(handle, unlocking_script.GetHex());
       }
     }
 
@@ -355,15 +355,15 @@ int CfdFinalizeMultisigScript(
       witness_script_obj = multisig_script;
     }
 
-    work_address = CreateString(addr.GetAddress());
+    work_address = CreateString(handle, addr.GetAddress());
     if (redeem_script != nullptr) {
       if (!redeem_script_obj.IsEmpty()) {
-        work_redeem_script = CreateString(redeem_script_obj.GetHex());
+        work_redeem_script = CreateString(handle, redeem_script_obj.GetHex());
       }
     }
     if (witness_script != nullptr) {
       if (!witness_script_obj.IsEmpty()) {
-        work_witness_script = CreateString(witness_script_obj.GetHex());
+        work_witness_script = CreateString(handle, witness_script_obj.GetHex());
       }
     }
 
@@ -516,17 +516,19 @@ int CfdGetDescriptorRootData(
     bool is_taproot = (desc_data.address_type == AddressType::kTaprootAddress);
     if (script_type != nullptr) *script_type = desc_data.type;
     if ((locking_script != nullptr) && (!desc_data.locking_script.IsEmpty())) {
-      work_locking_script = CreateString(desc_data.locking_script.GetHex());
+      work_locking_script =
+          CreateString(handle, desc_data.locking_script.GetHex());
     }
     if ((address != nullptr) && (!desc_data.address.GetAddress().empty())) {
       std::string addr = desc_data.address.GetAddress();
-      if (!addr.empty()) work_address = CreateString(addr);
+      if (!addr.empty()) work_address = CreateString(handle, addr);
     }
     if (hash_type != nullptr) {
       *hash_type = desc_data.address_type;
     }
     if ((redeem_script != nullptr) && (!desc_data.redeem_script.IsEmpty())) {
-      work_redeem_script = CreateString(desc_data.redeem_script.GetHex());
+      work_redeem_script =
+          CreateString(handle, desc_data.redeem_script.GetHex());
     }
     if (key_type != nullptr) {
       *key_type = desc_data.key_type;
@@ -559,24 +561,24 @@ int CfdGetDescriptorRootData(
     if (is_taproot && (schnorr_pubkey != nullptr)) {
       if (pubkey_obj.IsValid()) {
         auto spk = SchnorrPubkey::FromPubkey(pubkey_obj);
-        work_schnorr_pubkey = CreateString(spk.GetHex());
+        work_schnorr_pubkey = CreateString(handle, spk.GetHex());
       } else if (schnorr_pubkey_obj.IsValid()) {
-        work_schnorr_pubkey = CreateString(schnorr_pubkey_obj.GetHex());
+        work_schnorr_pubkey = CreateString(handle, schnorr_pubkey_obj.GetHex());
       }
     }
     if (is_taproot && desc_data.tree.IsValid()) {
-      work_tree_string = CreateString(desc_data.tree.ToString());
+      work_tree_string = CreateString(handle, desc_data.tree.ToString());
     } else if (is_taproot && !desc_data.branch.ToString().empty()) {
-      work_tree_string = CreateString(desc_data.branch.ToString());
+      work_tree_string = CreateString(handle, desc_data.branch.ToString());
     }
     if ((pubkey != nullptr) && (pubkey_obj.IsValid())) {
-      work_pubkey = CreateString(pubkey_obj.GetHex());
+      work_pubkey = CreateString(handle, pubkey_obj.GetHex());
     }
     if ((ext_pubkey != nullptr) && (ext_pubkey_obj.IsValid())) {
-      work_ext_pubkey = CreateString(ext_pubkey_obj.ToString());
+      work_ext_pubkey = CreateString(handle, ext_pubkey_obj.ToString());
     }
     if ((ext_privkey != nullptr) && (ext_privkey_obj.IsValid())) {
-      work_ext_privkey = CreateString(ext_privkey_obj.ToString());
+      work_ext_privkey = CreateString(handle, ext_privkey_obj.ToString());
     }
     if (is_multisig != nullptr) {
       *is_multisig = !buffer->multisig_key_list->empty();
@@ -648,17 +650,19 @@ int CfdGetDescriptorData(
     if (depth != nullptr) *depth = desc_data.depth;
     if (script_type != nullptr) *script_type = desc_data.type;
     if ((locking_script != nullptr) && (!desc_data.locking_script.IsEmpty())) {
-      work_locking_script = CreateString(desc_data.locking_script.GetHex());
+      work_locking_script =
+          CreateString(handle, desc_data.locking_script.GetHex());
     }
     if ((address != nullptr) && (!desc_data.address.GetAddress().empty())) {
       std::string addr = desc_data.address.GetAddress();
-      if (!addr.empty()) work_address = CreateString(addr);
+      if (!addr.empty()) work_address = CreateString(handle, addr);
     }
     if (hash_type != nullptr) {
       *hash_type = desc_data.address_type;
     }
     if ((redeem_script != nullptr) && (!desc_data.redeem_script.IsEmpty())) {
-      work_redeem_script = CreateString(desc_data.redeem_script.GetHex());
+      work_redeem_script =
+          CreateString(handle, desc_data.redeem_script.GetHex());
     }
     if (key_type != nullptr) {
       *key_type = desc_data.key_type;
@@ -687,15 +691,15 @@ int CfdGetDescriptorData(
         break;
     }
     if ((pubkey != nullptr) && (pubkey_obj.IsValid())) {
-      work_pubkey = CreateString(pubkey_obj.GetHex());
+      work_pubkey = CreateString(handle, pubkey_obj.GetHex());
     } else if ((pubkey != nullptr) && (schnorr_pubkey_obj.IsValid())) {
-      work_pubkey = CreateString(schnorr_pubkey_obj.GetHex());
+      work_pubkey = CreateString(handle, schnorr_pubkey_obj.GetHex());
     }
     if ((ext_pubkey != nullptr) && (ext_pubkey_obj.IsValid())) {
-      work_ext_pubkey = CreateString(ext_pubkey_obj.ToString());
+      work_ext_pubkey = CreateString(handle, ext_pubkey_obj.ToString());
     }
     if ((ext_privkey != nullptr) && (ext_privkey_obj.IsValid())) {
-      work_ext_privkey = CreateString(ext_privkey_obj.ToString());
+      work_ext_privkey = CreateString(handle, ext_privkey_obj.ToString());
     }
     if (is_multisig != nullptr) {
       if ((!buffer->multisig_key_list->empty()) && (index == last_index)) {
@@ -783,13 +787,13 @@ int CfdGetDescriptorMultisigKey(
         break;
     }
     if ((pubkey != nullptr) && (pubkey_obj.IsValid())) {
-      work_pubkey = CreateString(pubkey_obj.GetHex());
+      work_pubkey = CreateString(handle, pubkey_obj.GetHex());
     }
     if ((ext_pubkey != nullptr) && (ext_pubkey_obj.IsValid())) {
-      work_ext_pubkey = CreateString(ext_pubkey_obj.ToString());
+      work_ext_pubkey = CreateString(handle, ext_pubkey_obj.ToString());
     }
     if ((ext_privkey != nullptr) && (ext_privkey_obj.IsValid())) {
-      work_ext_privkey = CreateString(ext_privkey_obj.ToString());
+      work_ext_privkey = CreateString(handle, ext_privkey_obj.ToString());
     }
 
     if (work_pubkey != nullptr) *pubkey = work_pubkey;
@@ -876,7 +880,7 @@ int CfdGetDescriptorChecksum(
           CfdError::kCfdIllegalStateError, "Elements not supported.");
 #endif  // CFD_DISABLE_ELEMENTS
     }
-    *descriptor_added_checksum = CreateString(output_descriptor);
+    *descriptor_added_checksum = CreateString(handle, output_descriptor);
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -975,10 +979,11 @@ int CfdGetAddressFromMultisigKey(
           "Failed to parameter. index is maximum over.");
     }
     if (address != nullptr) {
-      work_address = CreateString(std::string(buffer->addresses[index]));
+      work_address =
+          CreateString(handle, std::string(buffer->addresses[index]));
     }
     if (pubkey != nullptr) {
-      work_pubkey = CreateString(std::string(buffer->pubkeys[index]));
+      work_pubkey = CreateString(handle, std::string(buffer->pubkeys[index]));
     }
 
     if (work_address != nullptr) *address = work_address;
@@ -1053,7 +1058,7 @@ int CfdGetAddressFromLockingScript(
           CfdError::kCfdIllegalStateError, "Elements not supported.");
 #endif  // CFD_DISABLE_ELEMENTS
     }
-    *address = CreateString(addr.GetAddress());
+    *address = CreateString(handle, addr.GetAddress());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     error_code = SetLastError(handle, except);
@@ -1159,8 +1164,9 @@ int CfdGetAddressInfo(
     if (witness_version != nullptr) {
       *witness_version = static_cast<int>(addr.GetWitnessVersion());
     }
-    work_locking_script = CreateString(addr.GetLockingScript().GetHex());
-    work_hash = CreateString(addr.GetHash().GetHex());
+    work_locking_script =
+        CreateString(handle, addr.GetLockingScript().GetHex());
+    work_hash = CreateString(handle, addr.GetHash().GetHex());
 
     if (locking_script != nullptr) {
       *locking_script = work_locking_script;
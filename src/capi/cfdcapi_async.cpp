@@ -0,0 +1,634 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcapi_async.cpp
+ *
+ * @brief implements asynchronous execution on cfd-capi.
+ */
+#ifndef CFD_DISABLE_CAPI
+#include "cfdc/cfdcapi_async.h"
+
+#include <algorithm>
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "capi/cfdc_internal.h"
+#include "cfd/cfd_common.h"
+#include "cfdc/cfdcapi_coin.h"
+#include "cfdc/cfdcapi_common.h"
+#include "cfdc/cfdcapi_elements_transaction.h"
+#include "cfdc/cfdcapi_psbt.h"
+#include "cfdc/cfdcapi_transaction.h"
+#include "cfdcore/cfdcore_exception.h"
+#include "cfdcore/cfdcore_logger.h"
+
+using cfd::core::CfdError;
+using cfd::core::CfdException;
+
+using cfd::core::logger::warn;
+
+// =============================================================================
+// internal c-api
+// =============================================================================
+namespace cfd {
+namespace capi {
+
+//! prefix: AsyncWorker
+constexpr const char* const kPrefixAsyncWorker = "AsyncWorker";
+//! prefix: AsyncTask
+constexpr const char* const kPrefixAsyncTask = "AsyncTask";
+
+class CfdCapiAsyncWorker;
+
+/**
+ * @brief async task.
+ */
+struct CfdCapiAsyncTask {
+  CfdAsyncTaskFunction function;             //!< task function
+  std::function<int(void*)> internal_function;  //!< built-in task function
+  CfdAsyncTaskCallback callback;             //!< completion callback
+  void* context;                             //!< user context
+  std::weak_ptr<CfdCapiAsyncWorker> worker;  //!< worker
+  int status;                                //!< task status
+  int result;                                //!< task result
+  std::string error_message;                 //!< error message
+  std::mutex mutex;                          //!< 排他制御用オブジェクト
+  std::condition_variable condition;         //!< status condition
+};
+
+/**
+ * @brief async worker shared state.
+ * @details The worker threads hold this state, so a detached thread \
+ *   can finish its loop after the worker object is released.
+ */
+struct CfdCapiAsyncWorkerState {
+  std::mutex mutex;                    //!< 排他制御用オブジェクト
+  std::condition_variable condition;   //!< queue condition
+  std::deque<std::shared_ptr<CfdCapiAsyncTask>> queue;  //!< pending queue
+  size_t max_queue_size;               //!< max pending task count
+  bool is_stop;                        //!< stop flag
+};
+
+/**
+ * @brief async worker thread pool.
+ */
+class CfdCapiAsyncWorker {
+ public:
+  /**
+   * @brief constructor.
+   * @param[in] thread_count    worker thread count.
+   * @param[in] max_queue_size  max pending task count. (0 is unlimited)
+   */
+  CfdCapiAsyncWorker(uint32_t thread_count, uint32_t max_queue_size)
+      : state_(std::make_shared<CfdCapiAsyncWorkerState>()) {
+    state_->max_queue_size = max_queue_size;
+    state_->is_stop = false;
+    try {
+      for (uint32_t index = 0; index < thread_count; ++index) {
+        thread_list_.emplace_back(&CfdCapiAsyncWorker::Run, state_);
+      }
+    } catch (...) {
+      Stop();
+      throw;
+    }
+  }
+  /**
+   * @brief destructor.
+   */
+  ~CfdCapiAsyncWorker() { Stop(); }
+
+  /**
+   * @brief Submit the task.
+   * @param[in] task  task
+   */
+  void Submit(const std::shared_ptr<CfdCapiAsyncTask>& task) {
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      if (state_->is_stop) {
+        warn(CFD_LOG_SOURCE, "async worker is stopped.");
+        throw CfdException(
+            CfdError::kCfdIllegalStateError,
+            "Failed to handle statement. async worker is stopped.");
+      }
+      if ((state_->max_queue_size != 0) &&
+          (state_->queue.size() >= state_->max_queue_size)) {
+        warn(CFD_LOG_SOURCE, "async task queue is full.");
+        throw CfdException(
+            CfdError::kCfdOutOfRangeError,
+            "Failed to parameter. async task queue is full.");
+      }
+      state_->queue.push_back(task);
+    }
+    state_->condition.notify_one();
+  }
+
+  /**
+   * @brief Cancel the pending task.
+   * @param[in] task  task
+   * @retval true   cancelled
+   * @retval false  already running or finished
+   */
+  bool Cancel(const std::shared_ptr<CfdCapiAsyncTask>& task) {
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      auto& queue = state_->queue;
+      auto ite = std::find(queue.begin(), queue.end(), task);
+      if (ite == queue.end()) return false;
+      queue.erase(ite);
+    }
+    Complete(task, kCfdAsyncTaskCancelled, kCfdIllegalStateError, "");
+    return true;
+  }
+
+  /**
+   * @brief Check the current thread is the worker thread.
+   * @retval true   worker thread
+   * @retval false  other thread
+   */
+  bool IsWorkerThread() const {
+    for (const auto& thread : thread_list_) {
+      if (thread.get_id() == std::this_thread::get_id()) return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief Complete the task.
+   * @details The callback runs before the status is published, so the \
+   *    waiting thread can release the context after the wait.
+   * @param[in] task            task
+   * @param[in] status          task status
+   * @param[in] result          task result
+   * @param[in] error_message   error message
+   */
+  static void Complete(
+      const std::shared_ptr<CfdCapiAsyncTask>& task, int status, int result,
+      const std::string& error_message) {
+    if (task->callback != nullptr) {
+      task->callback(task->context, status, result);
+    }
+    {
+      std::lock_guard<std::mutex> lock(task->mutex);
+      task->status = status;
+      task->result = result;
+      task->error_message = error_message;
+    }
+    task->condition.notify_all();
+  }
+
+ private:
+  std::shared_ptr<CfdCapiAsyncWorkerState> state_;  //!< shared state
+  std::vector<std::thread> thread_list_;  //!< worker thread list
+
+  /**
+   * @brief Stop the worker.
+   * @details The pending tasks are cancelled. \
+   *    If the last reference is released by a task on the worker thread \
+   *    (e.g. via CfdCancelAsyncTask), that thread is detached instead of \
+   *    joined, and exits its loop after the task returns.
+   */
+  void Stop() {
+    std::deque<std::shared_ptr<CfdCapiAsyncTask>> pending_list;
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      state_->is_stop = true;
+      pending_list.swap(state_->queue);
+    }
+    state_->condition.notify_all();
+    for (const auto& task : pending_list) {
+      Complete(task, kCfdAsyncTaskCancelled, kCfdIllegalStateError, "");
+    }
+    for (auto& thread : thread_list_) {
+      if (thread.get_id() == std::this_thread::get_id()) {
+        thread.detach();
+      } else if (thread.joinable()) {
+        thread.join();
+      }
+    }
+    thread_list_.clear();
+  }
+
+  /**
+   * @brief worker thread loop.
+   * @param[in] state   shared state
+   */
+  static void Run(std::shared_ptr<CfdCapiAsyncWorkerState> state) {
+    void* handle = nullptr;
+    int handle_result = CfdCreateHandle(&handle);
+    if (handle_result != kCfdSuccess) {
+      warn(CFD_LOG_SOURCE, "CfdCreateHandle NG[{}].", handle_result);
+    }
+    while (true) {
+      std::shared_ptr<CfdCapiAsyncTask> task;
+      {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->condition.wait(lock, [&state]() {
+          return state->is_stop || !state->queue.empty();
+        });
+        if (state->queue.empty()) break;
+        task = state->queue.front();
+        state->queue.pop_front();
+        std::lock_guard<std::mutex> task_lock(task->mutex);
+        task->status = kCfdAsyncTaskRunning;
+      }
+      if (handle_result != kCfdSuccess) {
+        Complete(
+            task, kCfdAsyncTaskCompleted, handle_result,
+            "Failed to create the worker handle.");
+        continue;
+      }
+
+      int result = kCfdUnknownError;
+      std::string error_message;
+      try {
+        if (task->internal_function) {
+          result = task->internal_function(handle);
+        } else {
+          result = task->function(handle, task->context);
+        }
+      } catch (const std::exception& std_except) {
+        result = kCfdUnknownError;
+        error_message = std_except.what();
+      } catch (...) {
+        result = kCfdUnknownError;
+        error_message = "unknown error.";
+      }
+      if ((result != kCfdSuccess) && error_message.empty()) {
+        char* message = nullptr;
+        if (CfdGetLastErrorMessage(handle, &message) == kCfdSuccess) {
+          error_message = message;
+          CfdFreeStringBuffer(message);
+        }
+      }
+      Complete(task, kCfdAsyncTaskCompleted, result, error_message);
+    }
+    if (handle != nullptr) CfdFreeHandle(handle);
+  }
+};
+
+/**
+ * @brief cfd-capi async worker handle.
+ */
+struct CfdCapiAsyncWorkerData {
+  char prefix[kPrefixLength];                   //!< buffer prefix
+  std::shared_ptr<CfdCapiAsyncWorker>* worker;  //!< worker
+};
+
+/**
+ * @brief cfd-capi async task handle.
+ */
+struct CfdCapiAsyncTaskData {
+  char prefix[kPrefixLength];               //!< buffer prefix
+  std::shared_ptr<CfdCapiAsyncTask>* task;  //!< task
+};
+
+/**
+ * @brief Submit the task to the worker.
+ * @param[in] handle              cfd handle.
+ * @param[in] worker_handle       async worker handle.
+ * @param[in] function            task function.
+ * @param[in] internal_function   built-in task function.
+ * @param[in] callback            completion callback.
+ * @param[in] context             user context.
+ * @param[out] task_handle        async task handle.
+ * @return CfdErrorCode
+ */
+static int SubmitAsyncTask(
+    void* handle, void* worker_handle, CfdAsyncTaskFunction function,
+    const std::function<int(void*)>& internal_function,
+    CfdAsyncTaskCallback callback, void* context, void** task_handle) {
+  int result = CfdErrorCode::kCfdUnknownError;
+  CfdCapiAsyncTaskData* buffer = nullptr;
+  try {
+    cfd::Initialize();
+    CheckBuffer(worker_handle, kPrefixAsyncWorker);
+    CfdCapiAsyncWorkerData* worker_data =
+        static_cast<CfdCapiAsyncWorkerData*>(worker_handle);
+    if ((function == nullptr) && !internal_function) {
+      warn(CFD_LOG_SOURCE, "function is null.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError,
+          "Failed to parameter. function is null.");
+    }
+    if (worker_data->worker == nullptr) {
+      warn(CFD_LOG_SOURCE, "worker is null.");
+      throw CfdException(
+          CfdError::kCfdIllegalStateError,
+          "Failed to handle statement. worker is null.");
+    }
+
+    auto task = std::make_shared<CfdCapiAsyncTask>();
+    task->function = function;
+    task->internal_function = internal_function;
+    task->callback = callback;
+    task->context = context;
+    task->worker = *(worker_data->worker);
+    task->status = kCfdAsyncTaskPending;
+    task->result = kCfdSuccess;
+    if (task_handle != nullptr) {
+      buffer = static_cast<CfdCapiAsyncTaskData*>(
+          AllocBuffer(kPrefixAsyncTask, sizeof(CfdCapiAsyncTaskData)));
+      buffer->task = new std::shared_ptr<CfdCapiAsyncTask>(task);
+    }
+    (*worker_data->worker)->Submit(task);
+    if (task_handle != nullptr) *task_handle = buffer;
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    result = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  if (buffer != nullptr) CfdFreeAsyncTask(handle, buffer);
+  return result;
+}
+
+}  // namespace capi
+}  // namespace cfd
+
+// =============================================================================
+// extern c-api
+// =============================================================================
+// API
+using cfd::capi::AllocBuffer;
+using cfd::capi::CfdCapiAsyncTask;
+using cfd::capi::CfdCapiAsyncTaskData;
+using cfd::capi::CfdCapiAsyncWorker;
+using cfd::capi::CfdCapiAsyncWorkerData;
+using cfd::capi::CheckBuffer;
+using cfd::capi::FreeBuffer;
+using cfd::capi::kPrefixAsyncTask;
+using cfd::capi::kPrefixAsyncWorker;
+using cfd::capi::SetLastError;
+using cfd::capi::SetLastFatalError;
+using cfd::capi::SubmitAsyncTask;
+
+extern "C" {
+
+int CfdCreateAsyncWorker(
+    void* handle, uint32_t thread_count, uint32_t max_queue_size,
+    void** worker_handle) {
+  int result = CfdErrorCode::kCfdUnknownError;
+  CfdCapiAsyncWorkerData* buffer = nullptr;
+  try {
+    cfd::Initialize();
+    if (worker_handle == nullptr) {
+      warn(CFD_LOG_SOURCE, "worker handle is null.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError,
+          "Failed to parameter. worker handle is null.");
+    }
+    if (thread_count == 0) {
+      thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    buffer = static_cast<CfdCapiAsyncWorkerData*>(
+        AllocBuffer(kPrefixAsyncWorker, sizeof(CfdCapiAsyncWorkerData)));
+    buffer->worker = new std::shared_ptr<CfdCapiAsyncWorker>(
+        std::make_shared<CfdCapiAsyncWorker>(thread_count, max_queue_size));
+    *worker_handle = buffer;
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    result = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  if (buffer != nullptr) CfdFreeAsyncWorker(handle, buffer);
+  return result;
+}
+
+int CfdSubmitAsyncTask(
+    void* handle, void* worker_handle, CfdAsyncTaskFunction function,
+    CfdAsyncTaskCallback callback, void* context, void** task_handle) {
+  return SubmitAsyncTask(
+      handle, worker_handle, function, nullptr, callback, context,
+      task_handle);
+}
+
+int CfdWaitAsyncTask(
+    void* handle, void* task_handle, uint32_t timeout_msec, int* status,
+    int* result) {
+  int ret = CfdErrorCode::kCfdUnknownError;
+  try {
+    cfd::Initialize();
+    CheckBuffer(task_handle, kPrefixAsyncTask);
+    CfdCapiAsyncTaskData* task_data =
+        static_cast<CfdCapiAsyncTaskData*>(task_handle);
+    if (status == nullptr) {
+      warn(CFD_LOG_SOURCE, "status is null.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError,
+          "Failed to parameter. status is null.");
+    }
+    if (task_data->task == nullptr) {
+      warn(CFD_LOG_SOURCE, "task is null.");
+      throw CfdException(
+          CfdError::kCfdIllegalStateError,
+          "Failed to handle statement. task is null.");
+    }
+
+    CfdCapiAsyncTask& task = **(task_data->task);
+    std::unique_lock<std::mutex> lock(task.mutex);
+    if (timeout_msec != 0) {
+      task.condition.wait_for(
+          lock, std::chrono::milliseconds(timeout_msec), [&task]() {
+            return (task.status == kCfdAsyncTaskCompleted) ||
+                   (task.status == kCfdAsyncTaskCancelled);
+          });
+    }
+    *status = task.status;
+    if (result != nullptr) *result = task.result;
+    if ((task.status == kCfdAsyncTaskCompleted) &&
+        (task.result != kCfdSuccess)) {
+      SetLastError(handle, task.result, task.error_message.c_str());
+    }
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    ret = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  return ret;
+}
+
+int CfdCancelAsyncTask(void* handle, void* task_handle) {
+  int result = CfdErrorCode::kCfdUnknownError;
+  try {
+    cfd::Initialize();
+    CheckBuffer(task_handle, kPrefixAsyncTask);
+    CfdCapiAsyncTaskData* task_data =
+        static_cast<CfdCapiAsyncTaskData*>(task_handle);
+    if (task_data->task == nullptr) {
+      warn(CFD_LOG_SOURCE, "task is null.");
+      throw CfdException(
+          CfdError::kCfdIllegalStateError,
+          "Failed to handle statement. task is null.");
+    }
+
+    const std::shared_ptr<CfdCapiAsyncTask>& task = *(task_data->task);
+    int status;
+    {
+      std::lock_guard<std::mutex> lock(task->mutex);
+      status = task->status;
+    }
+    if (status == kCfdAsyncTaskCancelled) return CfdErrorCode::kCfdSuccess;
+    if (status == kCfdAsyncTaskPending) {
+      // The freed worker has already cancelled its pending tasks.
+      std::shared_ptr<CfdCapiAsyncWorker> worker = task->worker.lock();
+      if ((worker == nullptr) || worker->Cancel(task)) {
+        return CfdErrorCode::kCfdSuccess;
+      }
+    }
+    warn(CFD_LOG_SOURCE, "task is already running.");
+    throw CfdException(
+        CfdError::kCfdIllegalStateError,
+        "Failed to handle statement. task is already running.");
+  } catch (const CfdException& except) {
+    result = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  return result;
+}
+
+int CfdFreeAsyncTask(void* handle, void* task_handle) {
+  int result = CfdErrorCode::kCfdUnknownError;
+  try {
+    cfd::Initialize();
+    if (task_handle != nullptr) {
+      CheckBuffer(task_handle, kPrefixAsyncTask);
+      CfdCapiAsyncTaskData* task_data =
+          static_cast<CfdCapiAsyncTaskData*>(task_handle);
+      if (task_data->task != nullptr) {
+        delete task_data->task;
+        task_data->task = nullptr;
+      }
+      FreeBuffer(task_handle, kPrefixAsyncTask, sizeof(CfdCapiAsyncTaskData));
+    }
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    result = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  return result;
+}
+
+int CfdFreeAsyncWorker(void* handle, void* worker_handle) {
+  int result = CfdErrorCode::kCfdUnknownError;
+  try {
+    cfd::Initialize();
+    if (worker_handle != nullptr) {
+      CheckBuffer(worker_handle, kPrefixAsyncWorker);
+      CfdCapiAsyncWorkerData* worker_data =
+          static_cast<CfdCapiAsyncWorkerData*>(worker_handle);
+      if (worker_data->worker != nullptr) {
+        if ((*worker_data->worker)->IsWorkerThread()) {
+          warn(CFD_LOG_SOURCE, "worker is freed on the worker thread.");
+          throw CfdException(
+              CfdError::kCfdIllegalStateError,
+              "Failed to handle statement. "
+              "worker is freed on the worker thread.");
+        }
+        delete worker_data->worker;
+        worker_data->worker = nullptr;
+      }
+      FreeBuffer(
+          worker_handle, kPrefixAsyncWorker, sizeof(CfdCapiAsyncWorkerData));
+    }
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    result = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  return result;
+}
+
+#ifndef CFD_DISABLE_ELEMENTS
+int CfdSubmitFinalizeBlindTx(
+    void* handle, void* worker_handle, void* blind_handle,
+    const char* tx_hex_string, CfdAsyncTaskCallback callback, void* context,
+    char** tx_string, void** task_handle) {
+  const bool is_null_tx = (tx_hex_string == nullptr);
+  const std::string tx_hex((is_null_tx) ? "" : tx_hex_string);
+  return SubmitAsyncTask(
+      handle, worker_handle, nullptr,
+      [blind_handle, is_null_tx, tx_hex, tx_string](void* task_cfd_handle) {
+        return CfdFinalizeBlindTx(
+            task_cfd_handle, blind_handle,
+            (is_null_tx) ? nullptr : tx_hex.c_str(), tx_string);
+      },
+      callback, context, task_handle);
+}
+#endif  // CFD_DISABLE_ELEMENTS
+
+int CfdSubmitFinalizeFundRawTx(
+    void* handle, void* worker_handle, void* fund_handle, const char* tx_hex,
+    double effective_fee_rate, CfdAsyncTaskCallback callback, void* context,
+    int64_t* tx_fee, uint32_t* append_txout_count, char** output_tx_hex,
+    void** task_handle) {
+  const bool is_null_tx = (tx_hex == nullptr);
+  const std::string tx((is_null_tx) ? "" : tx_hex);
+  return SubmitAsyncTask(
+      handle, worker_handle, nullptr,
+      [fund_handle, is_null_tx, tx, effective_fee_rate, tx_fee,
+       append_txout_count, output_tx_hex](void* task_cfd_handle) {
+        return CfdFinalizeFundRawTx(
+            task_cfd_handle, fund_handle, (is_null_tx) ? nullptr : tx.c_str(),
+            effective_fee_rate, tx_fee, append_txout_count, output_tx_hex);
+      },
+      callback, context, task_handle);
+}
+
+int CfdSubmitFinalizeFundPsbt(
+    void* handle, void* worker_handle, void* psbt_handle, void* fund_handle,
+    const char* change_address_descriptor, CfdAsyncTaskCallback callback,
+    void* context, int64_t* tx_fee, uint32_t* used_utxo_count,
+    void** task_handle) {
+  const bool is_null_desc = (change_address_descriptor == nullptr);
+  const std::string desc((is_null_desc) ? "" : change_address_descriptor);
+  return SubmitAsyncTask(
+      handle, worker_handle, nullptr,
+      [psbt_handle, fund_handle, is_null_desc, desc, tx_fee,
+       used_utxo_count](void* task_cfd_handle) {
+        return CfdFinalizeFundPsbt(
+            task_cfd_handle, psbt_handle, fund_handle,
+            (is_null_desc) ? nullptr : desc.c_str(), tx_fee, used_utxo_count);
+      },
+      callback, context, task_handle);
+}
+
+int CfdSubmitFinalizeCoinSelection(
+    void* handle, void* worker_handle, void* coin_select_handle,
+    CfdAsyncTaskCallback callback, void* context, int64_t* utxo_fee_amount,
+    void** task_handle) {
+  return SubmitAsyncTask(
+      handle, worker_handle, nullptr,
+      [coin_select_handle, utxo_fee_amount](void* task_cfd_handle) {
+        return CfdFinalizeCoinSelection(
+            task_cfd_handle, coin_select_handle, utxo_fee_amount);
+      },
+      callback, context, task_handle);
+}
+
+};  // extern "C"
+
+#endif  // CFD_DISABLE_CAPI
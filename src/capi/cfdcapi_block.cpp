@@ -166,7 +166,8 @@ int CfdGetBlockHash(void* handle, void* block_handle, char** block_hash) {
           CfdError::kCfdIllegalStateError,
           "Invalid handle state. block is null");
     } else if (block_data->net_type <= NetType::kRegtest) {
-      *block_hash = CreateString(block_data->block->GetBlockHash().GetHex());
+      *block_hash =
+          CreateString(handle, block_data->block->GetBlockHash().GetHex());
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
       throw CfdException(
@@ -219,10 +220,12 @@ int CfdGetBlockHeaderData(
     }
 
     if (prev_block_hash != nullptr) {
-      work_prev_block_hash = CreateString(header.prev_block_hash.GetHex());
+      work_prev_block_hash =
+          CreateString(handle, header.prev_block_hash.GetHex());
     }
     if (merkle_root_hash != nullptr) {
-      work_merkle_root_hash = CreateString(header.merkle_root_hash.GetHex());
+      work_merkle_root_hash =
+          CreateString(handle, header.merkle_root_hash.GetHex());
     }
 
     if (version != nullptr) *version = header.version;
@@ -274,7 +277,7 @@ int CfdGetTransactionFromBlock(
           "Invalid handle state. block is null");
     } else if (block_data->net_type <= NetType::kRegtest) {
       auto tx = block_data->block->GetTransaction(Txid(std::string(txid)));
-      *tx_hex = CreateString(tx.GetHex());
+      *tx_hex = CreateString(handle, tx.GetHex());
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
       throw CfdException(
@@ -323,7 +326,7 @@ int CfdGetTxOutProof(
           "Invalid handle state. block is null");
     } else if (block_data->net_type <= NetType::kRegtest) {
       auto proof = block_data->block->GetTxOutProof(Txid(txid));
-      *txout_proof = CreateString(proof.GetHex());
+      *txout_proof = CreateString(handle, proof.GetHex());
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
       throw CfdException(
@@ -451,7 +454,7 @@ int CfdGetTxidFromBlock(
           "Invalid handle state. block is null");
     } else if (block_data->net_type <= NetType::kRegtest) {
       auto txid_obj = block_data->block->GetTxid(index);
-      *txid = CreateString(txid_obj.GetHex());
+      *txid = CreateString(handle, txid_obj.GetHex());
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
       throw CfdException(
@@ -33,6 +33,7 @@ using cfd::AddressFactory;
 using cfd::AmountMap;
 using cfd::CoinSelection;
 using cfd::CoinSelectionOption;
+using cfd::CoinSelectionStatistics;
 using cfd::Utxo;
 using cfd::UtxoData;
 using cfd::UtxoFilter;
@@ -100,6 +101,10 @@ struct CfdCapiCoinSelection {
   std::vector<CfdCapiTargetAsset>* targets;  //!< target list
   //! target list
   std::vector<int32_t>* indexes;  //!< select index list
+  //! statistics collecting flag
+  bool is_collect_statistics;
+  //! statistics of the last coin selection
+  CoinSelectionStatistics statistics;
 };
 
 //! prefix: data for fee estimation
@@ -360,6 +365,9 @@ int CfdSetOptionCoinSelection(
           buffer->minimum_bits = static_cast<int>(int64_value);
         }
         break;
+      case CfdCoinSelectionOption::kCfdCoinSelectionCollectStatistics:
+        buffer->is_collect_statistics = bool_value;
+        break;
       default:
         warn(
             CFD_LOG_SOURCE, "illegal option key. [{}] d:{} b:{}", key,
@@ -414,6 +422,7 @@ int CfdFinalizeCoinSelection(
     option_params.SetLongTermFeeBaserate(buffer->long_term_fee_rate);
     option_params.SetDustFeeRate(buffer->dust_fee_rate);
     option_params.SetKnapsackMinimumChange(buffer->knapsack_min_change);
+    option_params.SetCollectStatistics(buffer->is_collect_statistics);
 #ifndef CFD_DISABLE_ELEMENTS
     option_params.SetBlindInfo(buffer->exponent, buffer->minimum_bits);
 #endif  // CFD_DISABLE_ELEMENTS
@@ -463,6 +472,8 @@ int CfdFinalizeCoinSelection(
       target.selected_amount = select_value.GetSatoshiValue();
     }
 
+    buffer->statistics = select_object.GetStatistics();
+
     // save return value from utxo_list
     buffer->indexes->reserve(utxo_list.size());
     for (const auto& utxo : utxo_list) {
@@ -559,6 +570,51 @@ int CfdGetSelectedCoinAssetAmount(
   return result;
 }
 
+int CfdGetCoinSelectionStatistics(
+    void* handle, void* coin_select_handle, bool* searched_bnb,
+    uint32_t* utxo_count, uint64_t* bnb_tries, uint64_t* bnb_backtracks,
+    uint64_t* knapsack_iterations, int64_t* waste, int64_t* knapsack_excess,
+    uint64_t* bnb_elapsed_usec, uint64_t* knapsack_elapsed_usec,
+    uint64_t* total_elapsed_usec) {
+  int result = CfdErrorCode::kCfdUnknownError;
+  try {
+    cfd::Initialize();
+    CheckBuffer(coin_select_handle, kPrefixCoinSelection);
+
+    CfdCapiCoinSelection* buffer =
+        static_cast<CfdCapiCoinSelection*>(coin_select_handle);
+    const CoinSelectionStatistics& statistics = buffer->statistics;
+    if (searched_bnb != nullptr) *searched_bnb = statistics.searched_bnb;
+    if (utxo_count != nullptr) *utxo_count = statistics.utxo_count;
+    if (bnb_tries != nullptr) *bnb_tries = statistics.bnb_tries;
+    if (bnb_backtracks != nullptr) *bnb_backtracks = statistics.bnb_backtracks;
+    if (knapsack_iterations != nullptr) {
+      *knapsack_iterations = statistics.knapsack_iterations;
+    }
+    if (waste != nullptr) *waste = statistics.waste;
+    if (knapsack_excess != nullptr) {
+      *knapsack_excess = statistics.knapsack_excess;
+    }
+    if (bnb_elapsed_usec != nullptr) {
+      *bnb_elapsed_usec = statistics.bnb_elapsed_usec;
+    }
+    if (knapsack_elapsed_usec != nullptr) {
+      *knapsack_elapsed_usec = statistics.knapsack_elapsed_usec;
+    }
+    if (total_elapsed_usec != nullptr) {
+      *total_elapsed_usec = statistics.total_elapsed_usec;
+    }
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    result = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  return result;
+}
+
 int CfdFreeCoinSelectionHandle(void* handle, void* coin_select_handle) {
   int result = CfdErrorCode::kCfdUnknownError;
   try {
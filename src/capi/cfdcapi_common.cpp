@@ -5,7 +5,12 @@
  * @brief cfd-capiで利用する共通処理の実装ファイル
  */
 #ifndef CFD_DISABLE_CAPI
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
 #include <exception>
+#include <mutex>  // NOLINT
 #include <string>
 #include <vector>
 
@@ -39,13 +44,144 @@ namespace capi {
 // -----------------------------------------------------------------------------
 // buffer API
 // -----------------------------------------------------------------------------
+#ifndef CFD_CAPI_DISABLE_BUFFER_POOL
+//! buffer pool: min size class shift (64 byte)
+constexpr uint32_t kBufferPoolMinSizeShift = 6;
+//! buffer pool: size class count (64 - 8192 byte)
+constexpr uint32_t kBufferPoolClassCount = 8;
+//! buffer pool: released buffer count kept out of the reuse
+constexpr size_t kBufferPoolQuarantineCount = 8;
+
+//! buffer pool destroyed flag on the current thread
+static thread_local bool is_buffer_pool_destroyed = false;
+
+/**
+ * @brief thread-local size class pool of the capi structure buffer.
+ * @details The pooled buffers are allocated by malloc with the class size,
+ *   so they can also be released by free.
+ *   The oldest released buffer is reused first, and the latest released
+ *   buffers are not reused, so a stale pointer to the released structure
+ *   does not hit the next structure at once.
+ */
+class CfdCapiBufferPool {
+ public:
+  /**
+   * @brief destructor.
+   */
+  ~CfdCapiBufferPool() {
+    is_buffer_pool_destroyed = true;
+    for (auto& free_list : free_list_) {
+      for (void* address : free_list) ::free(address);
+      free_list.clear();
+    }
+  }
+
+  /**
+   * @brief Allocate the buffer.
+   * @param[in] size  buffer size
+   * @return buffer (nullable)
+   */
+  void* Allocate(uint32_t size) {
+    uint32_t size_class = GetSizeClass(size);
+    if (size_class >= kBufferPoolClassCount) return ::malloc(size);
+    auto& free_list = free_list_[size_class];
+    if (free_list.size() <= kBufferPoolQuarantineCount) {
+      return ::malloc(GetClassSize(size_class));
+    }
+    void* address = free_list.front();
+    free_list.pop_front();
+    return address;
+  }
+
+  /**
+   * @brief Release the buffer.
+   * @param[in] address   buffer
+   * @param[in] size      buffer size
+   */
+  void Release(void* address, uint32_t size) {
+    uint32_t size_class = GetSizeClass(size);
+    if ((size_class >= kBufferPoolClassCount) ||
+        (free_list_[size_class].size() >= kBufferPoolMaxCount)) {
+      ::free(address);
+      return;
+    }
+    try {
+      free_list_[size_class].push_back(address);
+    } catch (...) {
+      ::free(address);
+    }
+  }
+
+ private:
+  std::deque<void*> free_list_[kBufferPoolClassCount];  //!< free list
+
+  /**
+   * @brief Get the size class.
+   * @param[in] size  buffer size
+   * @return size class
+   */
+  static uint32_t GetSizeClass(uint32_t size) {
+    uint32_t size_class = 0;
+    while ((size_class < kBufferPoolClassCount) &&
+           (GetClassSize(size_class) < size)) {
+      ++size_class;
+    }
+    return size_class;
+  }
+
+  /**
+   * @brief Get the buffer size of the size class.
+   * @param[in] size_class  size class
+   * @return buffer size
+   */
+  static uint32_t GetClassSize(uint32_t size_class) {
+    return uint32_t{1} << (kBufferPoolMinSizeShift + size_class);
+  }
+};
+
+//! capi structure buffer pool
+static thread_local CfdCapiBufferPool buffer_pool;
+#endif  // CFD_CAPI_DISABLE_BUFFER_POOL
+
+/**
+ * @brief allocate the raw buffer.
+ * @param[in] size  buffer size
+ * @return buffer (nullable)
+ */
+static void* AllocRawBuffer(uint32_t size) {
+#ifndef CFD_CAPI_DISABLE_BUFFER_POOL
+  if (is_buffer_pool_destroyed) return ::malloc(size);
+  return buffer_pool.Allocate(size);
+#else
+  return ::malloc(size);
+#endif  // CFD_CAPI_DISABLE_BUFFER_POOL
+}
+
+/**
+ * @brief free the raw buffer.
+ * @param[in] address   buffer
+ * @param[in] size      buffer size
+ */
+static void FreeRawBuffer(void* address, uint32_t size) {
+  ::memset(address, 0, size);
+#ifndef CFD_CAPI_DISABLE_BUFFER_POOL
+  if (is_buffer_pool_destroyed) {
+    ::free(address);  // after the pool is destroyed on the thread exit.
+    return;
+  }
+  buffer_pool.Release(address, size);
+#else
+  ::free(address);
+#endif  // CFD_CAPI_DISABLE_BUFFER_POOL
+}
+
 void* AllocBuffer(const std::string& prefix, uint32_t size) {
   if (prefix.empty() || (size <= sizeof(CfdCapiPrefixTemplate))) {
     warn(CFD_LOG_SOURCE, "parameter error.");
     throw CfdException(
         CfdError::kCfdIllegalArgumentError, "parameter illegal.");
   }
-  void* result = ::malloc(size);
+  void* result = AllocRawBuffer(size);
   if (result == nullptr) {
     warn(CFD_LOG_SOURCE, "malloc NG. prefix={}", prefix);
     throw CfdException(CfdError::kCfdMemoryFullError, "allocate buffer fail.");
@@ -64,8 +200,7 @@ void FreeBuffer(void* address, const std::string& prefix, uint32_t size) {
     throw CfdException(
         CfdError::kCfdIllegalArgumentError, "parameter illegal.");
   }
-  ::memset(address, 0, size);
-  ::free(address);
+  FreeRawBuffer(address, size);
 }
 
 void CheckBuffer(void* address, const std::string& prefix) {
@@ -263,6 +398,183 @@ bool IsEmptyString(const char* message) {
   }
 }
 
+// -----------------------------------------------------------------------------
+// CfdCapiStringArena
+// -----------------------------------------------------------------------------
+/// string arena lock (arena creation and release on the handle)
+static std::mutex string_arena_mutex;
+/// live string arena count
+static std::atomic<uint32_t> string_arena_count(0);
+/// string arena block pool lock (block acquisition and release)
+static std::mutex string_arena_pool_mutex;
+/// released block index list on the string arena block pool
+static std::vector<uint32_t> string_arena_free_block_list;
+/// string arena block begin address (append only)
+static std::atomic<uintptr_t>
+    string_arena_block_begin_list[kStringArenaBlockMaxCount];
+/// string arena block end address (append only)
+static std::atomic<uintptr_t>
+    string_arena_block_end_list[kStringArenaBlockMaxCount];
+/// string arena block count (published after the block address)
+static std::atomic<uint32_t> string_arena_block_count(0);
+
+/**
+ * @brief Acquire the block from the string arena block pool.
+ * @details The released block is reused first. The new block is kept \
+ *    until the process exit, so its address is never reused by malloc.
+ * @param[in] size      block size.
+ * @param[out] index    block pool index.
+ * @retval true   acquired
+ * @retval false  the block pool is full, or memory is full.
+ */
+static bool AcquireStringArenaBlock(size_t size, uint32_t* index) {
+  std::lock_guard<std::mutex> lock(string_arena_pool_mutex);
+  auto& free_list = string_arena_free_block_list;
+  for (auto ite = free_list.begin(); ite != free_list.end(); ++ite) {
+    uintptr_t begin = string_arena_block_begin_list[*ite];
+    uintptr_t end = string_arena_block_end_list[*ite];
+    if (end - begin >= size) {
+      *index = *ite;
+      free_list.erase(ite);
+      return true;
+    }
+  }
+  uint32_t count = string_arena_block_count;
+  if (count >= kStringArenaBlockMaxCount) return false;
+  free_list.reserve(count + 1);  // the release does not allocate.
+  char* block = static_cast<char*>(::malloc(size));
+  if (block == nullptr) return false;
+  string_arena_block_begin_list[count] = reinterpret_cast<uintptr_t>(block);
+  string_arena_block_end_list[count] =
+      reinterpret_cast<uintptr_t>(block) + size;
+  string_arena_block_count = count + 1;
+  *index = count;
+  return true;
+}
+
+/**
+ * @brief Release the block to the string arena block pool.
+ * @param[in] index     block pool index.
+ */
+static void ReleaseStringArenaBlock(uint32_t index) {
+  std::lock_guard<std::mutex> lock(string_arena_pool_mutex);
+  string_arena_free_block_list.push_back(index);
+}
+
+/**
+ * @brief Check if the address is on a string arena block.
+ * @details The blocks are append only, so it is checked without the lock. \
+ *    The block released with the handle is also found.
+ * @param[in] address   address.
+ * @retval true   on the string arena block
+ * @retval false  other
+ */
+static bool IsStringArenaAddress(const char* address) {
+  uintptr_t target = reinterpret_cast<uintptr_t>(address);
+  uint32_t count = string_arena_block_count;
+  for (uint32_t index = 0; index < count; ++index) {
+    if ((target >= string_arena_block_begin_list[index]) &&
+        (target < string_arena_block_end_list[index])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+CfdCapiStringArena::CfdCapiStringArena(uint32_t block_size)
+    : mutex_(),
+      block_list_(),
+      block_index_(0),
+      used_size_(0),
+      block_size_(
+          (block_size == 0) ? kStringArenaBlockSize
+                            : static_cast<size_t>(block_size)),
+      is_active_(false) {
+  // do nothing
+}
+
+CfdCapiStringArena::~CfdCapiStringArena() {
+  for (uint32_t index : block_list_) ReleaseStringArenaBlock(index);
+}
+
+char* CfdCapiStringArena::Allocate(size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!is_active_) return nullptr;
+  while (block_index_ < block_list_.size()) {
+    uint32_t index = block_list_[block_index_];
+    char* block = reinterpret_cast<char*>(
+        static_cast<uintptr_t>(string_arena_block_begin_list[index]));
+    size_t block_size = static_cast<size_t>(
+        string_arena_block_end_list[index] -
+        string_arena_block_begin_list[index]);
+    if (used_size_ + size <= block_size) {
+      char* addr = block + used_size_;
+      used_size_ += size;
+      return addr;
+    }
+    ++block_index_;
+    used_size_ = 0;
+  }
+  block_list_.reserve(block_list_.size() + 1);
+  uint32_t index = 0;
+  if (!AcquireStringArenaBlock(std::max(block_size_, size), &index)) {
+    return nullptr;
+  }
+  block_list_.push_back(index);
+  block_index_ = block_list_.size() - 1;
+  used_size_ = size;
+  return reinterpret_cast<char*>(
+      static_cast<uintptr_t>(string_arena_block_begin_list[index]));
+}
+
+void CfdCapiStringArena::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  block_index_ = 0;
+  used_size_ = 0;
+}
+
+void CfdCapiStringArena::SetActive(bool is_active) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  is_active_ = is_active;
+}
+
+bool CfdCapiStringArena::IsActive() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return is_active_;
+}
+
+/**
+ * @brief Get the string arena on the handle.
+ * @details Call with the string arena lock.
+ * @param[in] handle        handle pointer.
+ * @param[in] block_size    block size on creating.
+ * @param[in] is_create     create the arena if not exist.
+ * @return string arena (nullable)
+ */
+static CfdCapiStringArena* GetStringArena(
+    void* handle, uint32_t block_size, bool is_create) {
+  CheckBuffer(handle, kPrefixHandleData);
+  CfdCapiHandleData* handle_data = static_cast<CfdCapiHandleData*>(handle);
+  if ((handle_data->string_arena == nullptr) && is_create) {
+    handle_data->string_arena = new CfdCapiStringArena(block_size);
+    ++string_arena_count;
+  }
+  return handle_data->string_arena;
+}
+
+/**
+ * @brief Free the string arena on the handle.
+ * @param[in] handle_data   handle data.
+ */
+static void FreeStringArena(CfdCapiHandleData* handle_data) {
+  std::lock_guard<std::mutex> lock(string_arena_mutex);
+  CfdCapiStringArena* arena = handle_data->string_arena.exchange(nullptr);
+  if (arena != nullptr) {
+    delete arena;
+    --string_arena_count;
+  }
+}
+
 char* CreateString(const std::string& message) {
   size_t len = message.length();
   char* addr = static_cast<char*>(::malloc(len + 1));
@@ -275,6 +587,34 @@ char* CreateString(const std::string& message) {
   return addr;
 }
 
+char* CreateString(void* handle, const std::string& message) {
+  if ((handle != nullptr) && (string_arena_count != 0)) {
+    CfdCapiHandleData* handle_data = static_cast<CfdCapiHandleData*>(handle);
+    size_t prefix_len = strlen(kPrefixHandleData) + 1;
+    if (memcmp(handle_data->prefix, kPrefixHandleData, prefix_len) == 0) {
+      // only the arena of the handle is locked.
+      CfdCapiStringArena* arena = handle_data->string_arena;
+      size_t len = message.length();
+      char* addr = (arena != nullptr) ? arena->Allocate(len + 1) : nullptr;
+      if (addr != nullptr) {
+        message.copy(addr, len);
+        addr[len] = '\0';
+        return addr;
+      }
+    }
+  }
+  return CreateString(message);
+}
+
+void FreeString(char* address) {
+  if (address == nullptr) return;
+  // The arena string is released by the arena, even after the handle free.
+  if ((string_arena_block_count != 0) && IsStringArenaAddress(address)) {
+    return;
+  }
+  ::free(address);
+}
+
 void FreeBufferOnError(
     char** pointer1, char** pointer2, char** pointer3, char** pointer4,
     char** pointer5, char** pointer6) {
@@ -283,7 +623,7 @@ void FreeBufferOnError(
   for (size_t idx = 0; idx < 6; ++idx) {
     if (pointer_list[idx] != nullptr) {
       if (*(pointer_list[idx]) != nullptr) {
-        ::free(*(pointer_list[idx]));
+        FreeString(*(pointer_list[idx]));
         *(pointer_list[idx]) = nullptr;
       }
     }
@@ -318,34 +658,67 @@ void CheckNull(
 /// cfd-capiインスタンス
 static CfdCapiManager capi_instance;
 
-CfdCapiManager::CfdCapiManager() : handle_list_(), mutex_() {
+CfdCapiManager::CfdCapiManager() : shard_list_() {
   // do nothing
 }
 
-void CfdCapiManager::FreeAllList(std::vector<CfdCapiHandleData*>* list) {
-  if ((list != nullptr) && (!list->empty())) {
-    for (CfdCapiHandleData* handle : *list) {
-      ::free(handle);
+CfdCapiManager::~CfdCapiManager() {
+  for (auto& shard : shard_list_) FreeAllList(&shard);
+}
+
+uint32_t CfdCapiManager::GetCurrentShardIndex() {
+  static std::atomic<uint32_t> shard_counter(0);
+  static thread_local uint32_t shard_index =
+      shard_counter.fetch_add(1, std::memory_order_relaxed) %
+      kHandleShardCount;
+  return shard_index;
+}
+
+void CfdCapiManager::FreeAllList(HandleShard* shard) {
+  if (shard != nullptr) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    for (auto& slot : shard->slot_list) {
+      if (slot.handle != nullptr) {
+        FreeStringArena(slot.handle);
+        ::free(slot.handle);
+        slot.handle = nullptr;
+      }
     }
-    list->clear();
+    shard->slot_list.clear();
+    shard->free_slot_list.clear();
   }
 }
 
 void* CfdCapiManager::CreateHandle(bool is_outside) {
-  CfdCapiHandleData* handle;
+  CfdCapiHandleData* handle = static_cast<CfdCapiHandleData*>(
+      AllocBuffer(kPrefixHandleData, sizeof(CfdCapiHandleData)));
   if (is_outside) {
-    handle = static_cast<CfdCapiHandleData*>(
-        AllocBuffer(kPrefixHandleData, sizeof(CfdCapiHandleData)));
     handle->is_outside = true;
     return handle;
-  } else {
+  }
+
+  uint32_t shard_index = GetCurrentShardIndex();
+  HandleShard& shard = shard_list_[shard_index];
+  try {
     // 排他制御開始
-    std::lock_guard<std::mutex> lock(mutex_);
-    handle = static_cast<CfdCapiHandleData*>(
-        AllocBuffer(kPrefixHandleData, sizeof(CfdCapiHandleData)));
-    handle_list_.push_back(handle);
-    return handle;
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    uint32_t slot_index;
+    if (!shard.free_slot_list.empty()) {
+      slot_index = shard.free_slot_list.back();
+      shard.free_slot_list.pop_back();
+    } else {
+      slot_index = static_cast<uint32_t>(shard.slot_list.size());
+      shard.slot_list.push_back(HandleSlot{nullptr});
+    }
+    HandleSlot& slot = shard.slot_list[slot_index];
+    slot.handle = handle;
+    handle->shard_index = shard_index;
+    handle->slot_index = slot_index;
+  } catch (...) {
+    FreeRawBuffer(handle, sizeof(CfdCapiHandleData));
+    throw;
   }
+  return handle;
 }
 
 void CfdCapiManager::FreeHandle(void* handle) {
@@ -359,21 +732,22 @@ void CfdCapiManager::FreeHandle(void* handle) {
     }
 
     if (handle_data->is_outside) {  // outside handle
-      memset(handle, 0, sizeof(CfdCapiHandleData));
-      ::free(handle);
-    } else {
+      FreeStringArena(handle_data);
+      FreeRawBuffer(handle, sizeof(CfdCapiHandleData));
+    } else if (handle_data->shard_index < kHandleShardCount) {
+      HandleShard& shard = shard_list_[handle_data->shard_index];
       // 排他制御開始
-      std::lock_guard<std::mutex> lock(mutex_);
-
-      std::vector<CfdCapiHandleData*>::iterator ite;
-      for (ite = handle_list_.begin(); ite != handle_list_.end(); ++ite) {
-        if (handle == *ite) {
-          info(CFD_LOG_SOURCE, "capi FreeHandle. addr={:p}.", handle);
-          memset(handle, 0, sizeof(CfdCapiHandleData));
-          ::free(handle);
-          handle_list_.erase(ite);
-          break;
-        }
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      uint32_t slot_index = handle_data->slot_index;
+      if ((slot_index < shard.slot_list.size()) &&
+          (shard.slot_list[slot_index].handle == handle_data)) {
+        info(CFD_LOG_SOURCE, "capi FreeHandle. addr={:p}.", handle);
+        shard.free_slot_list.push_back(slot_index);
+        HandleSlot& slot = shard.slot_list[slot_index];
+        slot.handle = nullptr;
+        FreeStringArena(handle_data);
+        FreeRawBuffer(handle, sizeof(CfdCapiHandleData));
       }
     }
   }
@@ -588,7 +962,7 @@ extern "C" int CfdFreeHandle(void* handle) {
 extern "C" int CfdFreeBuffer(void* address) {
   try {
     cfd::Initialize();
-    if (address != nullptr) ::free(address);
+    cfd::capi::FreeString(static_cast<char*>(address));
     return kCfdSuccess;
   } catch (...) {
     return kCfdUnknownError;
@@ -598,13 +972,54 @@ extern "C" int CfdFreeBuffer(void* address) {
 extern "C" int CfdFreeStringBuffer(char* address) {
   try {
     cfd::Initialize();
-    if (address != nullptr) ::free(address);
+    cfd::capi::FreeString(address);
     return kCfdSuccess;
   } catch (...) {
     return kCfdUnknownError;
   }
 }
 
+extern "C" int CfdBeginStringArena(void* handle, uint32_t block_size) {
+  try {
+    cfd::Initialize();
+    std::lock_guard<std::mutex> lock(cfd::capi::string_arena_mutex);
+    cfd::capi::GetStringArena(handle, block_size, true)->SetActive(true);
+    return kCfdSuccess;
+  } catch (const CfdException& except) {
+    return except.GetErrorCode();
+  } catch (...) {
+    return kCfdUnknownError;
+  }
+}
+
+extern "C" int CfdEndStringArena(void* handle) {
+  try {
+    cfd::Initialize();
+    std::lock_guard<std::mutex> lock(cfd::capi::string_arena_mutex);
+    auto arena = cfd::capi::GetStringArena(handle, 0, false);
+    if (arena != nullptr) arena->SetActive(false);
+    return kCfdSuccess;
+  } catch (const CfdException& except) {
+    return except.GetErrorCode();
+  } catch (...) {
+    return kCfdUnknownError;
+  }
+}
+
+extern "C" int CfdResetStringArena(void* handle) {
+  try {
+    cfd::Initialize();
+    std::lock_guard<std::mutex> lock(cfd::capi::string_arena_mutex);
+    auto arena = cfd::capi::GetStringArena(handle, 0, false);
+    if (arena != nullptr) arena->Reset();
+    return kCfdSuccess;
+  } catch (const CfdException& except) {
+    return except.GetErrorCode();
+  } catch (...) {
+    return kCfdUnknownError;
+  }
+}
+
 extern "C" int CfdGetLastErrorCode(void* handle) {
   try {
     CfdException last_error = cfd::capi::capi_instance.GetLastError(handle);
@@ -666,7 +1081,7 @@ extern "C" int CfdRequestExecuteJson(
     }
 
     if (!result.empty() && (response_json_string != nullptr)) {
-      *response_json_string = cfd::capi::CreateString(result);
+      *response_json_string = cfd::capi::CreateString(handle, result);
     }
     return kCfdSuccess;
   } catch (const CfdException& except) {
@@ -701,7 +1116,7 @@ extern "C" int CfdSerializeByteData(
     }
 
     ByteData data(buffer);
-    *output = cfd::capi::CreateString(data.Serialize().GetHex());
+    *output = cfd::capi::CreateString(handle, data.Serialize().GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -742,12 +1157,12 @@ extern "C" int CfdEncryptAES(
 
     if (cfd::capi::IsEmptyString(cbc_iv)) {
       auto aes_data = cfd::core::CryptoUtil::EncryptAes256(key_data, data);
-      *output = cfd::capi::CreateString(aes_data.GetHex());
+      *output = cfd::capi::CreateString(handle, aes_data.GetHex());
     } else {
       ByteData iv(cbc_iv);
       auto aes_data =
           cfd::core::CryptoUtil::EncryptAes256Cbc(key_data, iv, data);
-      *output = cfd::capi::CreateString(aes_data.GetHex());
+      *output = cfd::capi::CreateString(handle, aes_data.GetHex());
     }
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -788,12 +1203,12 @@ extern "C" int CfdDecryptAES(
 
     if (cfd::capi::IsEmptyString(cbc_iv)) {
       auto aes_data = cfd::core::CryptoUtil::DecryptAes256(key_data, data);
-      *output = cfd::capi::CreateString(aes_data.GetHex());
+      *output = cfd::capi::CreateString(handle, aes_data.GetHex());
     } else {
       ByteData iv(cbc_iv);
       auto aes_data =
           cfd::core::CryptoUtil::DecryptAes256Cbc(key_data, iv, data);
-      *output = cfd::capi::CreateString(aes_data.GetHex());
+      *output = cfd::capi::CreateString(handle, aes_data.GetHex());
     }
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -824,7 +1239,7 @@ extern "C" int CfdEncodeBase64(
     }
     ByteData data(buffer);
     auto base64 = cfd::core::CryptoUtil::EncodeBase64(data);
-    *output = cfd::capi::CreateString(base64);
+    *output = cfd::capi::CreateString(handle, base64);
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     return cfd::capi::SetLastError(handle, except);
@@ -853,7 +1268,7 @@ extern "C" int CfdDecodeBase64(
           "Failed to parameter. output is null.");
     }
     auto data = cfd::core::CryptoUtil::DecodeBase64(std::string(base64));
-    *output = cfd::capi::CreateString(data.GetHex());
+    *output = cfd::capi::CreateString(handle, data.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     return cfd::capi::SetLastError(handle, except);
@@ -884,10 +1299,10 @@ extern "C" int CfdEncodeBase58(
     ByteData data(buffer);
     if (use_checksum) {
       auto base58 = cfd::core::CryptoUtil::EncodeBase58Check(data);
-      *output = cfd::capi::CreateString(base58);
+      *output = cfd::capi::CreateString(handle, base58);
     } else {
       auto base58 = cfd::core::CryptoUtil::EncodeBase58(data);
-      *output = cfd::capi::CreateString(base58);
+      *output = cfd::capi::CreateString(handle, base58);
     }
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -919,10 +1334,10 @@ extern "C" int CfdDecodeBase58(
     if (use_checksum) {
       auto data =
           cfd::core::CryptoUtil::DecodeBase58Check(std::string(base58));
-      *output = cfd::capi::CreateString(data.GetHex());
+      *output = cfd::capi::CreateString(handle, data.GetHex());
     } else {
       auto data = cfd::core::CryptoUtil::DecodeBase58(std::string(base58));
-      *output = cfd::capi::CreateString(data.GetHex());
+      *output = cfd::capi::CreateString(handle, data.GetHex());
     }
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -958,7 +1373,7 @@ extern "C" int CfdRipemd160(
     } else {
       data = cfd::core::HashUtil::Ripemd160(ByteData(message));
     }
-    *output = cfd::capi::CreateString(data.GetHex());
+    *output = cfd::capi::CreateString(handle, data.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     return cfd::capi::SetLastError(handle, except);
@@ -993,7 +1408,7 @@ extern "C" int CfdSha256(
     } else {
       data = cfd::core::HashUtil::Sha256(ByteData(message));
     }
-    *output = cfd::capi::CreateString(data.GetHex());
+    *output = cfd::capi::CreateString(handle, data.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     return cfd::capi::SetLastError(handle, except);
@@ -1028,7 +1443,7 @@ extern "C" int CfdHash160(
     } else {
       data = cfd::core::HashUtil::Hash160(ByteData(message));
     }
-    *output = cfd::capi::CreateString(data.GetHex());
+    *output = cfd::capi::CreateString(handle, data.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     return cfd::capi::SetLastError(handle, except);
@@ -1063,7 +1478,7 @@ extern "C" int CfdHash256(
     } else {
       data = cfd::core::HashUtil::Sha256D(ByteData(message));
     }
-    *output = cfd::capi::CreateString(data.GetHex());
+    *output = cfd::capi::CreateString(handle, data.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     return cfd::capi::SetLastError(handle, except);
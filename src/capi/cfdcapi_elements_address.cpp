@@ -94,7 +94,8 @@ int CfdCreateConfidentialAddress(
 
     ElementsConfidentialAddress confidential_addr;
     confidential_addr = factory.GetConfidentialAddress(addr, key);
-    *confidential_address = CreateString(confidential_addr.GetAddress());
+    *confidential_address =
+        CreateString(handle, confidential_addr.GetAddress());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -131,11 +132,11 @@ int CfdParseConfidentialAddress(
       *network_type = ConvertFromCfdNetType(addr.GetNetType());
     }
     if (address != nullptr) {
-      work_address = CreateString(addr.GetAddress());
+      work_address = CreateString(handle, addr.GetAddress());
     }
     if (confidential_key != nullptr) {
       work_confidential_key =
-          CreateString(confidential_addr.GetConfidentialKey().GetHex());
+          CreateString(handle, confidential_addr.GetConfidentialKey().GetHex());
     }
 
     if (work_address != nullptr) *address = work_address;
@@ -212,10 +213,10 @@ int CfdGetPeginAddress(
     auto addr = ElementsAddressFactory::CreatePegInAddress(
         net_type, addr_type, tweak_fedpegscript);
 
-    work_address = CreateString(addr.GetAddress());
-    work_script = CreateString(claim_script_obj.GetHex());
+    work_address = CreateString(handle, addr.GetAddress());
+    work_script = CreateString(handle, claim_script_obj.GetHex());
     if (tweaked_fedpeg_script != nullptr) {
-      work_fedpeg_script = CreateString(tweak_fedpegscript.GetHex());
+      work_fedpeg_script = CreateString(handle, tweak_fedpegscript.GetHex());
     }
 
     *pegin_address = work_address;
@@ -259,10 +260,10 @@ int CfdGetPegoutAddress(
         mainchain_net_type, elements_net_type, descriptor, bip32_counter,
         addr_type, &desc);
     if (mainchain_address != nullptr) {
-      work_address = CreateString(addr.GetAddress());
+      work_address = CreateString(handle, addr.GetAddress());
     }
     if (base_descriptor != nullptr) {
-      work_descriptor = CreateString(desc.ToString(false));
+      work_descriptor = CreateString(handle, desc.ToString(false));
     }
 
     if (base_descriptor != nullptr) *base_descriptor = work_descriptor;
@@ -153,8 +153,10 @@ using cfd::capi::ConvertHashToAddressType;
 using cfd::capi::ConvertNetType;
 using cfd::capi::ConvertToIssuanceParameter;
 using cfd::capi::CreateString;
+using cfd::capi::DeletePooledVector;
 using cfd::capi::FreeBuffer;
 using cfd::capi::FreeBufferOnError;
+using cfd::capi::GetCachedConfidentialTransaction;
 using cfd::capi::IsElementsNetType;
 using cfd::capi::IsEmptyString;
 using cfd::capi::kEmpty32Bytes;
@@ -163,6 +165,7 @@ using cfd::capi::kPrefixBlindTxData;
 using cfd::capi::kPrefixMultisigSignData;
 using cfd::capi::kPrefixTransactionData;
 using cfd::capi::kPubkeyHexSize;
+using cfd::capi::NewPooledVector;
 using cfd::capi::SetLastError;
 using cfd::capi::SetLastFatalError;
 
@@ -181,7 +184,7 @@ int CfdInitializeConfidentialTx(
     }
 
     ConfidentialTransactionController ctxc(version, locktime);
-    *tx_string = CreateString(ctxc.GetHex());
+    *tx_string = CreateString(handle, ctxc.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -221,7 +224,7 @@ int CfdAddConfidentialTxIn(
 
     ConfidentialTransactionController ctxc(tx_hex_string);
     ctxc.AddTxIn(Txid(txid), vout, sequence);
-    *tx_string = CreateString(ctxc.GetHex());
+    *tx_string = CreateString(handle, ctxc.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -295,7 +298,7 @@ int CfdAddConfidentialTxOut(
       ctxc.UpdateFeeAmount(amount, asset_obj);
     }
 
-    *tx_string = CreateString(ctxc.GetHex());
+    *tx_string = CreateString(handle, ctxc.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -375,7 +378,7 @@ int CfdUpdateConfidentialTxOut(
 
     ctx.SetTxOutCommitment(
         index, asset_obj, value, nonce_obj, ByteData(), ByteData());
-    *tx_string = CreateString(ctx.GetHex());
+    *tx_string = CreateString(handle, ctx.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -406,17 +409,18 @@ int CfdGetConfidentialTxInfo(
           "Failed to parameter. tx is null or empty.");
     }
 
-    ConfidentialTransactionController ctxc(tx_hex_string);
-    const ConfidentialTransaction& tx = ctxc.GetTransaction();
+    auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+    const ConfidentialTransactionContext& tx = *cache_tx;
 
     if (txid != nullptr) {
-      work_txid = CreateString(tx.GetTxid().GetHex());
+      work_txid = CreateString(handle, tx.GetTxid().GetHex());
     }
     if (wtxid != nullptr) {
-      work_wtxid = CreateString(Txid(tx.GetWitnessHash()).GetHex());
+      work_wtxid = CreateString(handle, Txid(tx.GetWitnessHash()).GetHex());
     }
     if (wit_hash != nullptr) {
-      work_wit_hash = CreateString(Txid(tx.GetWitnessOnlyHash()).GetHex());
+      work_wit_hash =
+          CreateString(handle, Txid(tx.GetWitnessOnlyHash()).GetHex());
     }
     if (size != nullptr) {
       *size = tx.GetTotalSize();
@@ -463,12 +467,12 @@ int CfdGetConfidentialTxIn(
           "Failed to parameter. tx is null or empty.");
     }
 
-    ConfidentialTransactionController ctxc(tx_hex_string);
-    const ConfidentialTransaction& tx = ctxc.GetTransaction();
+    auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+    const ConfidentialTransactionContext& tx = *cache_tx;
     const ConfidentialTxInReference ref = tx.GetTxIn(index);
 
     if (txid != nullptr) {
-      work_txid = CreateString(ref.GetTxid().GetHex());
+      work_txid = CreateString(handle, ref.GetTxid().GetHex());
     }
     if (vout != nullptr) {
       *vout = ref.GetVout();
@@ -477,7 +481,7 @@ int CfdGetConfidentialTxIn(
       *sequence = ref.GetSequence();
     }
     if (script_sig != nullptr) {
-      work_script_sig = CreateString(ref.GetUnlockingScript().GetHex());
+      work_script_sig = CreateString(handle, ref.GetUnlockingScript().GetHex());
     }
 
     if (work_txid != nullptr) *txid = work_txid;
@@ -515,8 +519,8 @@ int CfdGetConfidentialTxInWitness(
           "Failed to parameter. stack data is null.");
     }
 
-    ConfidentialTransactionController ctxc(tx_hex_string);
-    const ConfidentialTransaction& tx = ctxc.GetTransaction();
+    auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+    const ConfidentialTransactionContext& tx = *cache_tx;
     const ConfidentialTxInReference ref = tx.GetTxIn(txin_index);
 
     const std::vector<ByteData> witness_stack =
@@ -527,7 +531,7 @@ int CfdGetConfidentialTxInWitness(
           CfdError::kCfdOutOfRangeError,
           "Failed to parameter. stackIndex out of witness stack.");
     }
-    *stack_data = CreateString(witness_stack[stack_index].GetHex());
+    *stack_data = CreateString(handle, witness_stack[stack_index].GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -559,7 +563,8 @@ int CfdGetConfidentialTxInPeginWitness(
           "Failed to parameter. stack data is null.");
     }
 
-    ConfidentialTransactionContext tx(tx_hex_string);
+    auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+    const ConfidentialTransactionContext& tx = *cache_tx;
     const ConfidentialTxInReference ref = tx.GetTxIn(txin_index);
 
     const std::vector<ByteData> witness_stack =
@@ -570,7 +575,7 @@ int CfdGetConfidentialTxInPeginWitness(
           CfdError::kCfdOutOfRangeError,
           "Failed to parameter. stackIndex out of pegin witness.");
     }
-    *stack_data = CreateString(witness_stack[stack_index].GetHex());
+    *stack_data = CreateString(handle, witness_stack[stack_index].GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -604,15 +609,17 @@ int CfdGetTxInIssuanceInfo(
           "Failed to parameter. tx is null or empty.");
     }
 
-    ConfidentialTransactionController ctxc(tx_hex_string);
-    const ConfidentialTransaction& tx = ctxc.GetTransaction();
+    auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+    const ConfidentialTransactionContext& tx = *cache_tx;
     const ConfidentialTxInReference ref = tx.GetTxIn(index);
 
     if (entropy != nullptr) {
-      work_entropy = CreateString(BlindFactor(ref.GetAssetEntropy()).GetHex());
+      work_entropy =
+          CreateString(handle, BlindFactor(ref.GetAssetEntropy()).GetHex());
     }
     if (nonce != nullptr) {
-      work_nonce = CreateString(BlindFactor(ref.GetBlindingNonce()).GetHex());
+      work_nonce =
+          CreateString(handle, BlindFactor(ref.GetBlindingNonce()).GetHex());
     }
     const ConfidentialValue& asset_obj = ref.GetIssuanceAmount();
     const ConfidentialValue& token_obj = ref.GetInflationKeys();
@@ -622,7 +629,7 @@ int CfdGetTxInIssuanceInfo(
                           : asset_obj.GetAmount().GetSatoshiValue();
     }
     if (asset_value != nullptr) {
-      work_asset_value = CreateString(asset_obj.GetHex());
+      work_asset_value = CreateString(handle, asset_obj.GetHex());
     }
     if ((token_amount != nullptr) && (!token_obj.HasBlinding())) {
       *token_amount = (token_obj.HasBlinding())
@@ -630,15 +637,15 @@ int CfdGetTxInIssuanceInfo(
                           : token_obj.GetAmount().GetSatoshiValue();
     }
     if (token_value != nullptr) {
-      work_token_value = CreateString(token_obj.GetHex());
+      work_token_value = CreateString(handle, token_obj.GetHex());
     }
     if (asset_rangeproof != nullptr) {
       work_asset_rangeproof =
-          CreateString(ref.GetIssuanceAmountRangeproof().GetHex());
+          CreateString(handle, ref.GetIssuanceAmountRangeproof().GetHex());
     }
     if (token_rangeproof != nullptr) {
       work_token_rangeproof =
-          CreateString(ref.GetInflationKeysRangeproof().GetHex());
+          CreateString(handle, ref.GetInflationKeysRangeproof().GetHex());
     }
 
     if (work_entropy != nullptr) *entropy = work_entropy;
@@ -690,31 +697,33 @@ int CfdGetConfidentialTxOut(
           "Failed to parameter. tx is null or empty.");
     }
 
-    ConfidentialTransactionController ctxc(tx_hex_string);
-    const ConfidentialTransaction& tx = ctxc.GetTransaction();
+    auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+    const ConfidentialTransactionContext& tx = *cache_tx;
     const ConfidentialTxOutReference ref = tx.GetTxOut(index);
 
     if (asset_string != nullptr) {
-      work_asset_string = CreateString(ref.GetAsset().GetHex());
+      work_asset_string = CreateString(handle, ref.GetAsset().GetHex());
     }
     ConfidentialValue value = ref.GetConfidentialValue();
     if ((value_satoshi != nullptr) && (!value.HasBlinding())) {
       *value_satoshi = value.GetAmount().GetSatoshiValue();
     }
     if (value_commitment != nullptr) {
-      work_value_commitment = CreateString(value.GetHex());
+      work_value_commitment = CreateString(handle, value.GetHex());
     }
     if (nonce != nullptr) {
-      work_nonce = CreateString(ref.GetNonce().GetHex());
+      work_nonce = CreateString(handle, ref.GetNonce().GetHex());
     }
     if (locking_script != nullptr) {
-      work_locking_script = CreateString(ref.GetLockingScript().GetHex());
+      work_locking_script =
+          CreateString(handle, ref.GetLockingScript().GetHex());
     }
     if (surjection_proof != nullptr) {
-      work_surjection_proof = CreateString(ref.GetSurjectionProof().GetHex());
+      work_surjection_proof =
+          CreateString(handle, ref.GetSurjectionProof().GetHex());
     }
     if (rangeproof != nullptr) {
-      work_rangeproof = CreateString(ref.GetRangeProof().GetHex());
+      work_rangeproof = CreateString(handle, ref.GetRangeProof().GetHex());
     }
 
     if (work_asset_string != nullptr) *asset_string = work_asset_string;
@@ -757,8 +766,8 @@ int CfdGetConfidentialTxInCount(
           "Failed to parameter. tx is null or empty.");
     }
 
-    ConfidentialTransactionController ctxc(tx_hex_string);
-    const ConfidentialTransaction& tx = ctxc.GetTransaction();
+    auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+    const ConfidentialTransactionContext& tx = *cache_tx;
 
     if (count != nullptr) {
       *count = tx.GetTxInCount();
@@ -787,7 +796,8 @@ int CfdGetConfidentialTxInWitnessCount(
           "Failed to parameter. tx is null or empty.");
     }
 
-    ConfidentialTransactionContext tx(tx_hex_string);
+    auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+    const ConfidentialTransactionContext& tx = *cache_tx;
     const ConfidentialTxInReference ref = tx.GetTxIn(txin_index);
 
     if (count != nullptr) {
@@ -817,7 +827,8 @@ int CfdGetConfidentialTxInPeginWitnessCount(
           "Failed to parameter. tx is null or empty.");
     }
 
-    ConfidentialTransactionContext tx(tx_hex_string);
+    auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+    const ConfidentialTransactionContext& tx = *cache_tx;
     const ConfidentialTxInReference ref = tx.GetTxIn(txin_index);
     if (count != nullptr) {
       *count = ref.GetPeginWitnessStackNum();
@@ -845,7 +856,8 @@ int CfdGetConfidentialTxOutCount(
           "Failed to parameter. tx is null or empty.");
     }
 
-    ConfidentialTransactionContext tx(tx_hex_string);
+    auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+    const ConfidentialTransactionContext& tx = *cache_tx;
 
     if (count != nullptr) {
       *count = tx.GetTxOutCount();
@@ -880,7 +892,8 @@ int CfdGetConfidentialTxInIndex(
           "Failed to parameter. txid is null or empty.");
     }
 
-    ConfidentialTransactionContext tx(tx_hex_string);
+    auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+    const ConfidentialTransactionContext& tx = *cache_tx;
     OutPoint outpoint(Txid(txid), vout);
     if (index != nullptr) {
       *index = tx.GetTxInIndex(outpoint);
@@ -909,7 +922,8 @@ int CfdGetConfidentialTxOutIndex(
           "Failed to parameter. tx is null or empty.");
     }
 
-    ConfidentialTransactionContext tx(tx_hex_string);
+    auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+    const ConfidentialTransactionContext& tx = *cache_tx;
     bool is_find = false;
 
     if (!IsEmptyString(direct_locking_script)) {
@@ -1023,9 +1037,10 @@ int CfdSetRawReissueAsset(
         api.SetRawReissueAsset(tx_hex_string, issuances, &outputs);
 
     if (!outputs.empty() && (asset_string != nullptr)) {
-      work_asset_string = CreateString(outputs[0].output.asset.GetHex());
+      work_asset_string =
+          CreateString(handle, outputs[0].output.asset.GetHex());
     }
-    work_tx_string = CreateString(ctxc.GetHex());
+    work_tx_string = CreateString(handle, ctxc.GetHex());
 
     if (work_asset_string != nullptr) *asset_string = work_asset_string;
     *tx_string = work_tx_string;
@@ -1073,7 +1088,7 @@ int CfdGetIssuanceBlindingKey(
         Privkey(std::string(master_blinding_key)), Txid(txid),
         static_cast<int32_t>(vout));
 
-    *blinding_key = CreateString(privkey.GetHex());
+    *blinding_key = CreateString(handle, privkey.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1114,7 +1129,7 @@ int CfdGetDefaultBlindingKey(
     Privkey privkey = ElementsConfidentialAddress::GetBlindingKey(
         Privkey(std::string(master_blinding_key)),
         Script(std::string(locking_script)));
-    *blinding_key = CreateString(privkey.GetHex());
+    *blinding_key = CreateString(handle, privkey.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1141,9 +1156,9 @@ int CfdInitializeBlindTx(void* handle, void** blind_handle) {
 
     buffer = static_cast<CfdCapiBlindTxData*>(
         AllocBuffer(kPrefixBlindTxData, sizeof(CfdCapiBlindTxData)));
-    buffer->txin_blind_keys = new std::vector<TxInBlindParameters>();
-    buffer->txout_blind_keys = new std::vector<TxOutBlindKeys>();
-    buffer->blinder_list = new std::vector<BlindData>();
+    buffer->txin_blind_keys = NewPooledVector<TxInBlindParameters>();
+    buffer->txout_blind_keys = NewPooledVector<TxOutBlindKeys>();
+    buffer->blinder_list = NewPooledVector<BlindData>();
     buffer->minimum_range_value = 1;                 // = 1,
     buffer->exponent = 0;                            // = 0
     buffer->minimum_bits = cfd::capi::kMinimumBits;  // = 36(old)
@@ -1427,7 +1442,7 @@ int CfdFinalizeBlindTx(
         utxo_info_map, issuance_key_map, confidential_key_list,
         direct_key_list, buffer->minimum_range_value, buffer->exponent,
         buffer->minimum_bits, blinder_list_ptr);
-    *tx_string = CreateString(ctxc.GetHex());
+    *tx_string = CreateString(handle, ctxc.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1479,20 +1494,21 @@ int CfdGetBlindTxBlindData(
     auto& data = (*buffer->blinder_list)[index];
     if (vout != nullptr) *vout = data.vout;
     if (asset != nullptr) {
-      work_asset = CreateString(data.asset.GetHex());
+      work_asset = CreateString(handle, data.asset.GetHex());
     }
     if (value_satoshi != nullptr) {
       *value_satoshi = data.value.GetAmount().GetSatoshiValue();
     }
     if (asset_blind_factor != nullptr) {
-      work_asset_blind_factor = CreateString(data.abf.GetHex());
+      work_asset_blind_factor = CreateString(handle, data.abf.GetHex());
     }
     if (value_blind_factor != nullptr) {
-      work_value_blind_factor = CreateString(data.vbf.GetHex());
+      work_value_blind_factor = CreateString(handle, data.vbf.GetHex());
     }
     if ((issuance_txid != nullptr) && (issuance_vout != nullptr)) {
       *issuance_vout = data.issuance_outpoint.GetVout();
-      work_txid = CreateString(data.issuance_outpoint.GetTxid().GetHex());
+      work_txid =
+          CreateString(handle, data.issuance_outpoint.GetTxid().GetHex());
     }
     if (is_issuance_asset != nullptr) *is_issuance_asset = data.is_issuance;
     if (is_issuance_token != nullptr) {
@@ -1525,15 +1541,15 @@ int CfdFreeBlindHandle(void* handle, void* blind_handle) {
       CfdCapiBlindTxData* blind_tx_struct =
           static_cast<CfdCapiBlindTxData*>(blind_handle);
       if (blind_tx_struct->txin_blind_keys != nullptr) {
-        delete blind_tx_struct->txin_blind_keys;
+        DeletePooledVector(blind_tx_struct->txin_blind_keys);
         blind_tx_struct->txin_blind_keys = nullptr;
       }
       if (blind_tx_struct->txout_blind_keys != nullptr) {
-        delete blind_tx_struct->txout_blind_keys;
+        DeletePooledVector(blind_tx_struct->txout_blind_keys);
         blind_tx_struct->txout_blind_keys = nullptr;
       }
       if (blind_tx_struct->blinder_list != nullptr) {
-        delete blind_tx_struct->blinder_list;
+        DeletePooledVector(blind_tx_struct->blinder_list);
         blind_tx_struct->blinder_list = nullptr;
       }
     }
@@ -1591,7 +1607,7 @@ int CfdAddConfidentialTxSign(
     ConfidentialTransactionController ctxc = api.AddSign(
         std::string(tx_hex_string), Txid(std::string(txid)), vout, sign_list,
         is_witness, clear_stack);
-    *tx_string = CreateString(ctxc.GetHex());
+    *tx_string = CreateString(handle, ctxc.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1735,7 +1751,7 @@ int CfdFinalizeElementsMultisigSign(
     ConfidentialTransactionController ctxc = api.AddMultisigSign(
         std::string(tx_hex_string), Txid(std::string(txid)), vout, sign_list,
         addr_type, witness_script_obj, redeem_script_obj, clear_stack);
-    *tx_string = CreateString(ctxc.GetHex());
+    *tx_string = CreateString(handle, ctxc.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1812,7 +1828,7 @@ int CfdAddConfidentialTxSignWithPrivkeySimple(
         outpoint, Pubkey(pubkey), privkey_obj, sighashtype, value, addr_type,
         has_grind_r);
 
-    *tx_string = CreateString(tx.GetHex());
+    *tx_string = CreateString(handle, tx.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1913,7 +1929,7 @@ int CfdCreateConfidentialSighash(
     std::string sighash_bytes = api.CreateSignatureHash(
         std::string(tx_hex_string), Txid(std::string(txid)), vout, key_data,
         value, core_hash_type, sighashtype);
-    *sighash = CreateString(sighash_bytes);
+    *sighash = CreateString(handle, sighash_bytes);
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     return SetLastError(handle, except);
@@ -1954,16 +1970,18 @@ int CfdUnblindTxOut(
 
     if (!unblind_data.asset.IsEmpty()) {
       if (asset != nullptr) {
-        work_asset = CreateString(unblind_data.asset.GetHex());
+        work_asset = CreateString(handle, unblind_data.asset.GetHex());
       }
       if (value != nullptr) {
         *value = unblind_data.value.GetAmount().GetSatoshiValue();
       }
       if (asset_blind_factor != nullptr) {
-        work_asset_blind_factor = CreateString(unblind_data.abf.GetHex());
+        work_asset_blind_factor =
+            CreateString(handle, unblind_data.abf.GetHex());
       }
       if (value_blind_factor != nullptr) {
-        work_value_blind_factor = CreateString(unblind_data.vbf.GetHex());
+        work_value_blind_factor =
+            CreateString(handle, unblind_data.vbf.GetHex());
       }
     }
 
@@ -2033,32 +2051,34 @@ int CfdUnblindIssuance(
 
     if (!unblind_asset.asset.IsEmpty()) {
       if (asset != nullptr) {
-        work_asset = CreateString(unblind_asset.asset.GetHex());
+        work_asset = CreateString(handle, unblind_asset.asset.GetHex());
       }
       if (asset_value != nullptr) {
         *asset_value = unblind_asset.value.GetAmount().GetSatoshiValue();
       }
       if (asset_blind_factor != nullptr) {
-        work_asset_blind_factor = CreateString(unblind_asset.abf.GetHex());
+        work_asset_blind_factor =
+            CreateString(handle, unblind_asset.abf.GetHex());
       }
       if (asset_value_blind_factor != nullptr) {
         work_asset_value_blind_factor =
-            CreateString(unblind_asset.vbf.GetHex());
+            CreateString(handle, unblind_asset.vbf.GetHex());
       }
     }
     if (!unblind_token.asset.IsEmpty()) {
       if (token != nullptr) {
-        work_token = CreateString(unblind_token.asset.GetHex());
+        work_token = CreateString(handle, unblind_token.asset.GetHex());
       }
       if (token_value != nullptr) {
         *token_value = unblind_token.value.GetAmount().GetSatoshiValue();
       }
       if (token_blind_factor != nullptr) {
-        work_token_blind_factor = CreateString(unblind_token.abf.GetHex());
+        work_token_blind_factor =
+            CreateString(handle, unblind_token.abf.GetHex());
       }
       if (token_value_blind_factor != nullptr) {
         work_token_value_blind_factor =
-            CreateString(unblind_token.vbf.GetHex());
+            CreateString(handle, unblind_token.vbf.GetHex());
       }
     }
 
@@ -2251,7 +2271,7 @@ int CfdGetConfidentialValueHex(
     if (ignore_version_info) {  // erase first 1byte (2 char)
       hex_str = hex_str.substr(2);
     }
-    *value_hex = CreateString(hex_str);
+    *value_hex = CreateString(handle, hex_str);
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -2292,7 +2312,7 @@ int CfdGetAssetCommitment(
     BlindFactor abf(asset_blind_factor);
     ConfidentialAssetId commitment =
         ConfidentialAssetId::GetCommitment(asset_obj, abf);
-    *asset_commitment = CreateString(commitment.GetHex());
+    *asset_commitment = CreateString(handle, commitment.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -2334,7 +2354,7 @@ int CfdGetValueCommitment(
     BlindFactor vbf(value_blind_factor);
     ConfidentialValue commitment =
         ConfidentialValue::GetCommitment(amount, asset, vbf);
-    *value_commitment = CreateString(commitment.GetHex());
+    *value_commitment = CreateString(handle, commitment.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -2374,13 +2394,14 @@ int CfdGetConfidentialTxInfoByHandle(
     ConfidentialTransactionContext* tx =
         static_cast<ConfidentialTransactionContext*>(tx_data->tx_obj);
     if (txid != nullptr) {
-      work_txid = CreateString(tx->GetTxid().GetHex());
+      work_txid = CreateString(handle, tx->GetTxid().GetHex());
     }
     if (wtxid != nullptr) {
-      work_wtxid = CreateString(Txid(tx->GetWitnessHash()).GetHex());
+      work_wtxid = CreateString(handle, Txid(tx->GetWitnessHash()).GetHex());
     }
     if (wit_hash != nullptr) {
-      work_wit_hash = CreateString(Txid(tx->GetWitnessOnlyHash()).GetHex());
+      work_wit_hash =
+          CreateString(handle, Txid(tx->GetWitnessOnlyHash()).GetHex());
     }
     if (size != nullptr) {
       *size = tx->GetTotalSize();
@@ -2481,7 +2502,7 @@ int CfdGetPegoutMainchainAddress(
     ConfidentialTransactionContext* tx =
         static_cast<ConfidentialTransactionContext*>(tx_data->tx_obj);
     auto addr = tx->GetTxOutPegoutAddress(index, mainchain_net_type);
-    *mainchain_address = CreateString(addr.GetAddress());
+    *mainchain_address = CreateString(handle, addr.GetAddress());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     ret = SetLastError(handle, except);
@@ -2525,10 +2546,12 @@ int CfdGetTxInIssuanceInfoByHandle(
     const ConfidentialTxInReference ref = tx->GetTxIn(index);
 
     if (entropy != nullptr) {
-      work_entropy = CreateString(BlindFactor(ref.GetAssetEntropy()).GetHex());
+      work_entropy =
+          CreateString(handle, BlindFactor(ref.GetAssetEntropy()).GetHex());
     }
     if (nonce != nullptr) {
-      work_nonce = CreateString(BlindFactor(ref.GetBlindingNonce()).GetHex());
+      work_nonce =
+          CreateString(handle, BlindFactor(ref.GetBlindingNonce()).GetHex());
     }
     const ConfidentialValue& asset_obj = ref.GetIssuanceAmount();
     const ConfidentialValue& token_obj = ref.GetInflationKeys();
@@ -2538,7 +2561,7 @@ int CfdGetTxInIssuanceInfoByHandle(
                           : asset_obj.GetAmount().GetSatoshiValue();
     }
     if (asset_value != nullptr) {
-      work_asset_value = CreateString(asset_obj.GetHex());
+      work_asset_value = CreateString(handle, asset_obj.GetHex());
     }
     if ((token_amount != nullptr) && (!token_obj.HasBlinding())) {
       *token_amount = (token_obj.HasBlinding())
@@ -2546,15 +2569,15 @@ int CfdGetTxInIssuanceInfoByHandle(
                           : token_obj.GetAmount().GetSatoshiValue();
     }
     if (token_value != nullptr) {
-      work_token_value = CreateString(token_obj.GetHex());
+      work_token_value = CreateString(handle, token_obj.GetHex());
     }
     if (asset_rangeproof != nullptr) {
       work_asset_rangeproof =
-          CreateString(ref.GetIssuanceAmountRangeproof().GetHex());
+          CreateString(handle, ref.GetIssuanceAmountRangeproof().GetHex());
     }
     if (token_rangeproof != nullptr) {
       work_token_rangeproof =
-          CreateString(ref.GetInflationKeysRangeproof().GetHex());
+          CreateString(handle, ref.GetInflationKeysRangeproof().GetHex());
     }
 
     if (work_entropy != nullptr) *entropy = work_entropy;
@@ -2626,26 +2649,28 @@ int CfdGetConfidentialTxOutByHandle(
     const ConfidentialTxOutReference ref = tx->GetTxOut(index);
 
     if (asset_string != nullptr) {
-      work_asset_string = CreateString(ref.GetAsset().GetHex());
+      work_asset_string = CreateString(handle, ref.GetAsset().GetHex());
     }
     ConfidentialValue value = ref.GetConfidentialValue();
     if ((value_satoshi != nullptr) && (!value.HasBlinding())) {
       *value_satoshi = value.GetAmount().GetSatoshiValue();
     }
     if (value_commitment != nullptr) {
-      work_value_commitment = CreateString(value.GetHex());
+      work_value_commitment = CreateString(handle, value.GetHex());
     }
     if (nonce != nullptr) {
-      work_nonce = CreateString(ref.GetNonce().GetHex());
+      work_nonce = CreateString(handle, ref.GetNonce().GetHex());
     }
     if (locking_script != nullptr) {
-      work_locking_script = CreateString(ref.GetLockingScript().GetHex());
+      work_locking_script =
+          CreateString(handle, ref.GetLockingScript().GetHex());
     }
     if (surjection_proof != nullptr) {
-      work_surjection_proof = CreateString(ref.GetSurjectionProof().GetHex());
+      work_surjection_proof =
+          CreateString(handle, ref.GetSurjectionProof().GetHex());
     }
     if (rangeproof != nullptr) {
-      work_rangeproof = CreateString(ref.GetRangeProof().GetHex());
+      work_rangeproof = CreateString(handle, ref.GetRangeProof().GetHex());
     }
 
     if (work_asset_string != nullptr) *asset_string = work_asset_string;
@@ -2824,10 +2849,10 @@ int CfdSetIssueAsset(
         outpoint, issuance_data.amount, issuance_data, token_data.amount,
         token_data, is_blind_asset, contract_hash_obj);
 
-    work_entropy = CreateString(data.entropy.GetHex());
-    work_asset = CreateString(data.asset.GetHex());
+    work_entropy = CreateString(handle, data.entropy.GetHex());
+    work_asset = CreateString(handle, data.asset.GetHex());
     if (token_string != nullptr) {
-      work_token = CreateString(data.token.GetHex());
+      work_token = CreateString(handle, data.token.GetHex());
     }
 
     *entropy = work_entropy;
@@ -2904,7 +2929,7 @@ int CfdSetReissueAsset(
         BlindFactor(blinding_nonce), BlindFactor(entropy));
 
     if (asset_string != nullptr) {
-      *asset_string = CreateString(data.asset.GetHex());
+      *asset_string = CreateString(handle, data.asset.GetHex());
     }
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -3085,7 +3110,8 @@ int CfdAddTxPegoutOutput(
         elements_net_type, &btc_derive_address);
 
     if (mainchain_address != nullptr) {
-      *mainchain_address = CreateString(btc_derive_address.GetAddress());
+      *mainchain_address =
+          CreateString(handle, btc_derive_address.GetAddress());
     }
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -3130,13 +3156,13 @@ int CfdUnblindTxOutData(
     auto unblind_data = txout.Unblind(blinding_key_obj);
 
     if (asset != nullptr) {
-      work_asset = CreateString(unblind_data.asset.GetHex());
+      work_asset = CreateString(handle, unblind_data.asset.GetHex());
     }
     if (asset_blind_factor != nullptr) {
-      work_asset_blinder = CreateString(unblind_data.abf.GetHex());
+      work_asset_blinder = CreateString(handle, unblind_data.abf.GetHex());
     }
     if (value_blind_factor != nullptr) {
-      work_value_blinder = CreateString(unblind_data.vbf.GetHex());
+      work_value_blinder = CreateString(handle, unblind_data.vbf.GetHex());
     }
     if (amount != nullptr) {
       *amount = unblind_data.value.GetAmount().GetSatoshiValue();
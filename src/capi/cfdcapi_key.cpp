@@ -152,7 +152,7 @@ int CfdCalculateEcSignature(
     }
     ByteData data = SignatureUtil::CalculateEcSignature(
         ByteData256(sighash), private_key, has_grind_r);
-    *signature = CreateString(data.GetHex());
+    *signature = CreateString(handle, data.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -250,8 +250,8 @@ int CfdSignEcdsaAdaptor(
     AdaptorPair pair =
         AdaptorUtil::Sign(ByteData256(msg), Privkey(sk), Pubkey(adaptor));
 
-    work_signature = CreateString(pair.signature.GetData().GetHex());
-    work_proof = CreateString(pair.proof.GetData().GetHex());
+    work_signature = CreateString(handle, pair.signature.GetData().GetHex());
+    work_proof = CreateString(handle, pair.proof.GetData().GetHex());
 
     *adaptor_signature = work_signature;
     *adaptor_proof = work_proof;
@@ -295,7 +295,7 @@ int CfdAdaptEcdsaAdaptor(
     ByteData sig = AdaptorUtil::Adapt(
         AdaptorSignature(adaptor_signature), Privkey(adaptor_secret));
 
-    *signature = CreateString(sig.GetHex());
+    *signature = CreateString(handle, sig.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -342,7 +342,7 @@ int CfdExtractEcdsaAdaptorSecret(
         AdaptorSignature(adaptor_signature), ByteData(signature),
         Pubkey(adaptor));
 
-    *adaptor_secret = CreateString(secret.GetHex());
+    *adaptor_secret = CreateString(handle, secret.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -428,7 +428,7 @@ int CfdGetSchnorrPubkeyFromPrivkey(
     Privkey privkey_obj = Privkey(std::string(privkey));
     SchnorrPubkey schnorr_pubkey =
         SchnorrPubkey::FromPrivkey(privkey_obj, parity);
-    *pubkey = CreateString(schnorr_pubkey.GetHex());
+    *pubkey = CreateString(handle, schnorr_pubkey.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -462,7 +462,7 @@ int CfdGetSchnorrPubkeyFromPubkey(
     Pubkey pubkey_obj = Pubkey(std::string(pubkey));
     SchnorrPubkey schnorr_pubkey_obj =
         SchnorrPubkey::FromPubkey(pubkey_obj, parity);
-    *schnorr_pubkey = CreateString(schnorr_pubkey_obj.GetHex());
+    *schnorr_pubkey = CreateString(handle, schnorr_pubkey_obj.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -505,7 +505,7 @@ int CfdSchnorrPubkeyTweakAdd(
     SchnorrPubkey pubkey_obj = SchnorrPubkey(std::string(pubkey));
     SchnorrPubkey schnorr_pubkey =
         pubkey_obj.CreateTweakAdd(tweak_obj, parity);
-    *output = CreateString(schnorr_pubkey.GetHex());
+    *output = CreateString(handle, schnorr_pubkey.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -545,10 +545,10 @@ int CfdSchnorrKeyPairTweakAdd(
     SchnorrPubkey schnorr_pubkey = SchnorrPubkey::CreateTweakAddFromPrivkey(
         privkey_obj, tweak_obj, &tweaked_privkey_obj, tweaked_parity);
     if (tweaked_pubkey != nullptr) {
-      work_pubkey = CreateString(schnorr_pubkey.GetHex());
+      work_pubkey = CreateString(handle, schnorr_pubkey.GetHex());
     }
     if (tweaked_privkey != nullptr) {
-      work_privkey = CreateString(tweaked_privkey_obj.GetHex());
+      work_privkey = CreateString(handle, tweaked_privkey_obj.GetHex());
     }
 
     if (tweaked_pubkey != nullptr) *tweaked_pubkey = work_pubkey;
@@ -643,7 +643,7 @@ int CfdSignSchnorr(
           ByteData256(msg), Privkey(sk), ByteData256(aux_rand));
     }
 
-    *signature = CreateString(schnorr_sig.GetHex());
+    *signature = CreateString(handle, schnorr_sig.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -689,7 +689,7 @@ int CfdSignSchnorrWithNonce(
     SchnorrSignature schnorr_sig = SchnorrUtil::SignWithNonce(
         ByteData256(msg), Privkey(sk), Privkey(nonce));
 
-    *signature = CreateString(schnorr_sig.GetHex());
+    *signature = CreateString(handle, schnorr_sig.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -723,7 +723,7 @@ int CfdAddSighashTypeInSchnorrSignature(
     SigHashType sighash_type_obj = SigHashType::Create(
         static_cast<uint8_t>(sighash_type), anyone_can_pay);
     sig.SetSigHashType(sighash_type_obj);
-    *added_signature = CreateString(sig.GetData(true).GetHex());
+    *added_signature = CreateString(handle, sig.GetData(true).GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -800,7 +800,7 @@ int CfdComputeSchnorrSigPoint(
     Pubkey sig_point = SchnorrUtil::ComputeSigPoint(
         ByteData256(msg), SchnorrPubkey(nonce), SchnorrPubkey(pubkey));
 
-    *sigpoint = CreateString(sig_point.GetHex());
+    *sigpoint = CreateString(handle, sig_point.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -879,8 +879,8 @@ int CfdSplitSchnorrSignature(
     }
 
     SchnorrSignature sig = SchnorrSignature(std::string(signature));
-    work_nonce = CreateString(sig.GetNonce().GetHex());
-    work_key = CreateString(sig.GetPrivkey().GetHex());
+    work_nonce = CreateString(handle, sig.GetNonce().GetHex());
+    work_key = CreateString(handle, sig.GetPrivkey().GetHex());
 
     *nonce = work_nonce;
     *key = work_key;
@@ -917,7 +917,7 @@ int CfdEncodeSignatureByDer(
     SigHashType type = SigHashType::Create(
         static_cast<uint8_t>(sighash_type), sighash_anyone_can_pay);
     ByteData der_sig = CryptoUtil::ConvertSignatureToDer(signature, type);
-    *der_signature = CreateString(der_sig.GetHex());
+    *der_signature = CreateString(handle, der_sig.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -952,7 +952,7 @@ int CfdDecodeSignatureFromDer(
     SigHashType type;
     ByteData sig =
         CryptoUtil::ConvertSignatureFromDer(ByteData(der_signature), &type);
-    *signature = CreateString(sig.GetHex());
+    *signature = CreateString(handle, sig.GetHex());
     if (sighash_type) *sighash_type = static_cast<int>(type.GetSigHashFlag());
     if (sighash_anyone_can_pay)
       *sighash_anyone_can_pay = type.IsAnyoneCanPay();
@@ -987,7 +987,7 @@ int CfdNormalizeSignature(
     }
 
     ByteData result = CryptoUtil::NormalizeSignature(ByteData(signature));
-    *normalized_signature = CreateString(result.GetHex());
+    *normalized_signature = CreateString(handle, result.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1026,13 +1026,13 @@ int CfdCreateKeyPair(
         api.CreateKeyPair(is_compressed, &pubkey_obj, &privkey_wif, net_type);
 
     if (wif != nullptr) {
-      work_wif = CreateString(privkey_wif);
+      work_wif = CreateString(handle, privkey_wif);
     }
     if (privkey != nullptr) {
-      work_privkey = CreateString(key.GetHex());
+      work_privkey = CreateString(handle, key.GetHex());
     }
     if (pubkey != nullptr) {
-      work_pubkey = CreateString(pubkey_obj.GetHex());
+      work_pubkey = CreateString(handle, pubkey_obj.GetHex());
     }
 
     if (work_privkey != nullptr) *privkey = work_privkey;
@@ -1081,7 +1081,7 @@ int CfdGetPrivkeyFromWif(
     }
     Privkey key = Privkey::FromWif(
         wif, net_type, (wif_len != kPrivkeyWifUncompressSize));
-    *privkey = CreateString(key.GetHex());
+    *privkey = CreateString(handle, key.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1123,7 +1123,7 @@ int CfdGetPrivkeyWif(
     }
     Privkey key(privkey);
     std::string privkey_wif = key.ConvertWif(net_type, is_compressed);
-    *wif = CreateString(privkey_wif);
+    *wif = CreateString(handle, privkey_wif);
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1154,7 +1154,7 @@ int CfdParsePrivkeyWif(
     KeyApi api;
     Privkey key =
         api.GetPrivkeyFromWif(wif, &temp_nettype, &temp_is_compressed);
-    if (privkey != nullptr) *privkey = CreateString(key.GetHex());
+    if (privkey != nullptr) *privkey = CreateString(handle, key.GetHex());
     if (is_compressed != nullptr) {
       *is_compressed = temp_is_compressed;
     }
@@ -1202,7 +1202,7 @@ int CfdGetPubkeyFromPrivkey(
     } else {
       key = api.GetPubkeyFromPrivkey(privkey, is_compressed);
     }
-    *pubkey = CreateString(key);
+    *pubkey = CreateString(handle, key);
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1234,7 +1234,7 @@ int CfdGetPubkeyFingerprint(
     }
 
     Pubkey key(pubkey);
-    *fingerprint = CreateString(key.GetFingerprint().GetHex());
+    *fingerprint = CreateString(handle, key.GetFingerprint().GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1265,7 +1265,7 @@ int CfdCompressPubkey(void* handle, const char* pubkey, char** output) {
     }
 
     Pubkey key(pubkey);
-    *output = CreateString(key.Compress().GetHex());
+    *output = CreateString(handle, key.Compress().GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1296,7 +1296,7 @@ int CfdUncompressPubkey(void* handle, const char* pubkey, char** output) {
     }
 
     Pubkey key(pubkey);
-    *output = CreateString(key.Uncompress().GetHex());
+    *output = CreateString(handle, key.Uncompress().GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1397,7 +1397,7 @@ int CfdFinalizeCombinePubkey(
       key_list.emplace_back(pubkey);
     }
     Pubkey key = Pubkey::CombinePubkey(key_list);
-    *output = CreateString(key.GetHex());
+    *output = CreateString(handle, key.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1459,7 +1459,7 @@ int CfdPubkeyTweakAdd(
 
     Pubkey key(pubkey);
     ByteData256 tweak_data(tweak);
-    *output = CreateString(key.CreateTweakAdd(tweak_data).GetHex());
+    *output = CreateString(handle, key.CreateTweakAdd(tweak_data).GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1498,7 +1498,7 @@ int CfdPubkeyTweakMul(
 
     Pubkey key(pubkey);
     ByteData256 tweak_data(tweak);
-    *output = CreateString(key.CreateTweakMul(tweak_data).GetHex());
+    *output = CreateString(handle, key.CreateTweakMul(tweak_data).GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1529,7 +1529,7 @@ int CfdNegatePubkey(void* handle, const char* pubkey, char** output) {
     }
 
     Pubkey key(pubkey);
-    *output = CreateString(key.CreateNegate().GetHex());
+    *output = CreateString(handle, key.CreateNegate().GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1569,7 +1569,7 @@ int CfdPrivkeyTweakAdd(
     KeyApi api;
     Privkey key = api.GetPrivkey(std::string(privkey), nullptr, nullptr);
     ByteData256 tweak_data(tweak);
-    *output = CreateString(key.CreateTweakAdd(tweak_data).GetHex());
+    *output = CreateString(handle, key.CreateTweakAdd(tweak_data).GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1609,7 +1609,7 @@ int CfdPrivkeyTweakMul(
     KeyApi api;
     Privkey key = api.GetPrivkey(std::string(privkey), nullptr, nullptr);
     ByteData256 tweak_data(tweak);
-    *output = CreateString(key.CreateTweakMul(tweak_data).GetHex());
+    *output = CreateString(handle, key.CreateTweakMul(tweak_data).GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1641,7 +1641,7 @@ int CfdNegatePrivkey(void* handle, const char* privkey, char** output) {
 
     KeyApi api;
     Privkey key = api.GetPrivkey(std::string(privkey), nullptr, nullptr);
-    *output = CreateString(key.CreateNegate().GetHex());
+    *output = CreateString(handle, key.CreateNegate().GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1685,7 +1685,7 @@ int CfdCreateExtkeyFromSeed(
     HDWalletApi api;
     std::string key = api.CreateExtkeyFromSeed(
         ByteData(seed_hex), net_type, output_key_type);
-    *extkey = CreateString(key);
+    *extkey = CreateString(handle, key);
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1754,24 +1754,24 @@ CFDC_API int CfdCreateExtkey(
         ExtPrivkey extprivkey(
             net_type, parent_privkey, privkey, ByteData256(chain_code_str),
             depth, child_number);
-        *extkey = CreateString(extprivkey.ToString());
+        *extkey = CreateString(handle, extprivkey.ToString());
       } else {
         ExtPrivkey extprivkey(
             net_type, ByteData(fingerprint_str), privkey,
             ByteData256(chain_code_str), depth, child_number);
-        *extkey = CreateString(extprivkey.ToString());
+        *extkey = CreateString(handle, extprivkey.ToString());
       }
     } else {
       if (fingerprint_str.empty()) {
         ExtPubkey extpubkey(
             net_type, Pubkey(parent_key_str), Pubkey(key_str),
             ByteData256(chain_code_str), depth, child_number);
-        *extkey = CreateString(extpubkey.ToString());
+        *extkey = CreateString(handle, extpubkey.ToString());
       } else {
         ExtPubkey extpubkey(
             net_type, ByteData(fingerprint_str), Pubkey(key_str),
             ByteData256(chain_code_str), depth, child_number);
-        *extkey = CreateString(extpubkey.ToString());
+        *extkey = CreateString(handle, extpubkey.ToString());
       }
     }
 
@@ -1817,7 +1817,7 @@ int CfdCreateExtkeyFromParent(
     HDWalletApi api;
     std::string key = api.CreateExtkeyFromParent(
         extkey, net_type, output_key_type, child_number, hardened);
-    *child_extkey = CreateString(key);
+    *child_extkey = CreateString(handle, key);
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1865,7 +1865,7 @@ int CfdCreateExtkeyFromParentPath(
     HDWalletApi api;
     std::string key = api.CreateExtkeyFromPathString(
         extkey, net_type, output_key_type, path_string);
-    *child_extkey = CreateString(key);
+    *child_extkey = CreateString(handle, key);
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1906,7 +1906,7 @@ int CfdCreateExtPubkey(
     }
     HDWalletApi api;
     std::string key = api.CreateExtPubkey(extkey, net_type);
-    *ext_pubkey = CreateString(key);
+    *ext_pubkey = CreateString(handle, key);
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1946,11 +1946,11 @@ int CfdGetPrivkeyFromExtkey(
     std::string key;
     if (privkey != nullptr) {
       key = api.GetPrivkeyFromExtkey(extkey, net_type, false);
-      work_privkey = CreateString(key);
+      work_privkey = CreateString(handle, key);
     }
     if (wif != nullptr) {
       key = api.GetPrivkeyFromExtkey(extkey, net_type, true);
-      work_wif = CreateString(key);
+      work_wif = CreateString(handle, key);
     }
 
     if (work_privkey != nullptr) *privkey = work_privkey;
@@ -1997,7 +1997,7 @@ int CfdGetPubkeyFromExtkey(
     }
     HDWalletApi api;
     std::string key = api.GetPubkeyFromExtkey(extkey, net_type);
-    *pubkey = CreateString(key);
+    *pubkey = CreateString(handle, key);
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -2060,8 +2060,8 @@ int CfdGetParentExtkeyPathData(
       }
     }
 
-    work_key_path_data = CreateString(parent_info);
-    work_child_key = CreateString(child_key_string);
+    work_key_path_data = CreateString(handle, parent_info);
+    work_child_key = CreateString(handle, child_key_string);
 
     if (key_path_data != nullptr) *key_path_data = work_key_path_data;
     if (child_key != nullptr) *child_key = work_child_key;
@@ -2114,14 +2114,16 @@ int CfdGetExtkeyInfo(
     if (hdkey_top == "prv") {
       ExtPrivkey ext_privkey(extkey_string);
       if (version != nullptr) {
-        work_version = CreateString(ext_privkey.GetVersionData().GetHex());
+        work_version =
+            CreateString(handle, ext_privkey.GetVersionData().GetHex());
       }
       if (fingerprint != nullptr) {
         work_fingerprint =
-            CreateString(ext_privkey.GetFingerprintData().GetHex());
+            CreateString(handle, ext_privkey.GetFingerprintData().GetHex());
       }
       if (chain_code != nullptr) {
-        work_chain_code = CreateString(ext_privkey.GetChainCode().GetHex());
+        work_chain_code =
+            CreateString(handle, ext_privkey.GetChainCode().GetHex());
       }
       work_depth = ext_privkey.GetDepth();
       work_child_number = ext_privkey.GetChildNum();
@@ -2130,14 +2132,16 @@ int CfdGetExtkeyInfo(
     } else {
       ExtPubkey ext_pubkey(extkey_string);
       if (version != nullptr) {
-        work_version = CreateString(ext_pubkey.GetVersionData().GetHex());
+        work_version =
+            CreateString(handle, ext_pubkey.GetVersionData().GetHex());
       }
       if (fingerprint != nullptr) {
         work_fingerprint =
-            CreateString(ext_pubkey.GetFingerprintData().GetHex());
+            CreateString(handle, ext_pubkey.GetFingerprintData().GetHex());
       }
       if (chain_code != nullptr) {
-        work_chain_code = CreateString(ext_pubkey.GetChainCode().GetHex());
+        work_chain_code =
+            CreateString(handle, ext_pubkey.GetChainCode().GetHex());
       }
       work_depth = ext_pubkey.GetDepth();
       work_child_number = ext_pubkey.GetChildNum();
@@ -2177,7 +2181,7 @@ int CfdGetMnemonicWords(
     HDWalletApi api;
     std::vector<std::string> wordlist = api.GetMnemonicWordlist(lang);
     auto words = StringUtil::Join(wordlist, " ");
-    *mnemonic_words = CreateString(words);
+    *mnemonic_words = CreateString(handle, words);
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -2252,7 +2256,7 @@ int CfdGetMnemonicWord(
           "Failed to parameter. index is maximum over.");
     }
 
-    *mnemonic_word = CreateString((*buffer->wordlist)[index]);
+    *mnemonic_word = CreateString(handle, (*buffer->wordlist)[index]);
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     return SetLastError(handle, except);
@@ -2321,9 +2325,9 @@ int CfdConvertMnemonicToSeed(
     ByteData seed_data = api.ConvertMnemonicToSeed(
         mnemonic_words, passphrase_str, strict_check, lang,
         use_ideographic_space, &entropy_data);
-    work_entropy = CreateString(entropy_data.GetHex());
+    work_entropy = CreateString(handle, entropy_data.GetHex());
 
-    *seed = CreateString(seed_data.GetHex());
+    *seed = CreateString(handle, seed_data.GetHex());
     if (entropy != nullptr) *entropy = work_entropy;
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -2368,7 +2372,7 @@ int CfdConvertEntropyToMnemonic(
       if (!mnemonic_str.empty()) mnemonic_str += " ";
       mnemonic_str += word;
     }
-    *mnemonic = CreateString(mnemonic_str);
+    *mnemonic = CreateString(handle, mnemonic_str);
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
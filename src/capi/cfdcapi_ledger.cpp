@@ -245,7 +245,7 @@ int CfdFinalizeTxSerializeHashForLedger(
       ByteData256 hashed_data = HashUtil::Sha256(serialize_data);
       serialize_data = hashed_data.GetData();
     }
-    *serialize_hex = CreateString(serialize_data.GetHex());
+    *serialize_hex = CreateString(handle, serialize_data.GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -7,6 +7,7 @@
 #ifndef CFD_DISABLE_CAPI
 #include "cfdc/cfdcapi_psbt.h"
 
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -97,6 +98,12 @@ struct CfdCapiPsbtHandle {
   NetType net_type;            //!< network type
   //! psbt object
   Psbt* psbt;
+  //! combine target psbt list
+  std::vector<Psbt>* combine_list;
+  //! sign privkey list
+  std::vector<Privkey>* sign_privkey_list;
+  //! read-only snapshot of the serialized psbt (null: updated after it)
+  std::vector<uint8_t>* serialized_snapshot;
 };
 
 /**
@@ -230,6 +237,35 @@ static void ConvertToKeyData(
   }
 }
 
+/**
+ * @brief Get the psbt object for update.
+ * @details The serialized psbt snapshot is dropped on any update.
+ * @param[in,out] psbt_obj    psbt handle object.
+ * @return psbt object.
+ */
+static Psbt* GetUpdatePsbt(CfdCapiPsbtHandle* psbt_obj) {
+  if (psbt_obj->serialized_snapshot != nullptr) {
+    delete psbt_obj->serialized_snapshot;
+    psbt_obj->serialized_snapshot = nullptr;
+  }
+  return psbt_obj->psbt;
+}
+
+/**
+ * @brief Get the read-only snapshot of the serialized psbt.
+ * @details The whole psbt is serialized again after any update.
+ * @param[in,out] psbt_obj    psbt handle object.
+ * @return serialized psbt.
+ */
+static const std::vector<uint8_t>& GetPsbtSnapshot(
+    CfdCapiPsbtHandle* psbt_obj) {
+  if (psbt_obj->serialized_snapshot == nullptr) {
+    psbt_obj->serialized_snapshot =
+        new std::vector<uint8_t>(psbt_obj->psbt->GetData().GetBytes());
+  }
+  return *psbt_obj->serialized_snapshot;
+}
+
 }  // namespace capi
 }  // namespace cfd
 
@@ -246,13 +282,17 @@ using cfd::capi::CheckBuffer;
 using cfd::capi::ConvertNetType;
 using cfd::capi::ConvertToKeyData;
 using cfd::capi::CreateString;
+using cfd::capi::DeletePooledVector;
 using cfd::capi::FreeBuffer;
 using cfd::capi::FreeBufferOnError;
+using cfd::capi::GetPsbtSnapshot;
+using cfd::capi::GetUpdatePsbt;
 using cfd::capi::IsEmptyString;
 using cfd::capi::kPrefixPsbtByteDataList;
 using cfd::capi::kPrefixPsbtFundHandle;
 using cfd::capi::kPrefixPsbtHandle;
 using cfd::capi::kPrefixPsbtPubkeyList;
+using cfd::capi::NewPooledVector;
 using cfd::capi::ParsePubkey;
 using cfd::capi::SetLastError;
 using cfd::capi::SetLastFatalError;
@@ -315,6 +355,51 @@ int CfdCreatePsbtHandle(
   return result;
 }
 
+int CfdCreatePsbtHandleByBytes(
+    void* handle, int net_type, const uint8_t* psbt_bytes, size_t psbt_size,
+    void** psbt_handle) {
+  int result = CfdErrorCode::kCfdUnknownError;
+  CfdCapiPsbtHandle* buffer = nullptr;
+  try {
+    cfd::Initialize();
+
+    if (psbt_handle == nullptr) {
+      warn(CFD_LOG_SOURCE, "psbt_handle is null.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError,
+          "Failed to parameter. psbt_handle is null.");
+    }
+    if ((psbt_bytes == nullptr) || (psbt_size == 0)) {
+      warn(CFD_LOG_SOURCE, "psbt_bytes is null or empty.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError,
+          "Failed to parameter. psbt_bytes is null or empty.");
+    }
+    bool is_bitcoin = false;
+    NetType network_type = ConvertNetType(net_type, &is_bitcoin);
+    if (!is_bitcoin) {
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
+    }
+
+    buffer = static_cast<CfdCapiPsbtHandle*>(
+        AllocBuffer(kPrefixPsbtHandle, sizeof(CfdCapiPsbtHandle)));
+    buffer->psbt = new Psbt(ByteData(
+        std::vector<uint8_t>(psbt_bytes, psbt_bytes + psbt_size)));
+    buffer->net_type = network_type;
+    *psbt_handle = buffer;
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    result = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  CfdFreePsbtHandle(handle, buffer);
+  return result;
+}
+
 int CfdFreePsbtHandle(void* handle, void* psbt_handle) {
   int result = CfdErrorCode::kCfdUnknownError;
   try {
@@ -327,6 +412,18 @@ int CfdFreePsbtHandle(void* handle, void* psbt_handle) {
         delete psbt_data->psbt;
         psbt_data->psbt = nullptr;
       }
+      if (psbt_data->combine_list != nullptr) {
+        delete psbt_data->combine_list;
+        psbt_data->combine_list = nullptr;
+      }
+      if (psbt_data->sign_privkey_list != nullptr) {
+        delete psbt_data->sign_privkey_list;
+        psbt_data->sign_privkey_list = nullptr;
+      }
+      if (psbt_data->serialized_snapshot != nullptr) {
+        delete psbt_data->serialized_snapshot;
+        psbt_data->serialized_snapshot = nullptr;
+      }
       FreeBuffer(psbt_handle, kPrefixPsbtHandle, sizeof(CfdCapiPsbtHandle));
     }
     return CfdErrorCode::kCfdSuccess;
@@ -356,11 +453,13 @@ int CfdGetPsbtData(
           "Failed to handle statement. psbt is null.");
     }
 
+    const std::vector<uint8_t>& psbt_bytes = GetPsbtSnapshot(psbt_obj);
     if (psbt_base64 != nullptr) {
-      work_base64 = CreateString(psbt_obj->psbt->GetBase64());
+      work_base64 =
+          CreateString(handle, CryptoUtil::EncodeBase64(ByteData(psbt_bytes)));
     }
     if (psbt_hex != nullptr) {
-      work_hex = CreateString(psbt_obj->psbt->GetData().GetHex());
+      work_hex = CreateString(handle, StringUtil::ByteToString(psbt_bytes));
     }
     if (psbt_base64 != nullptr) *psbt_base64 = work_base64;
     if (psbt_hex != nullptr) *psbt_hex = work_hex;
@@ -376,6 +475,48 @@ int CfdGetPsbtData(
   return result;
 }
 
+int CfdGetPsbtBytes(
+    void* handle, void* psbt_handle, uint8_t* psbt_buffer, size_t buffer_size,
+    size_t* data_size) {
+  int result = CfdErrorCode::kCfdUnknownError;
+  try {
+    cfd::Initialize();
+    CheckBuffer(psbt_handle, kPrefixPsbtHandle);
+    CfdCapiPsbtHandle* psbt_obj = static_cast<CfdCapiPsbtHandle*>(psbt_handle);
+    if (data_size == nullptr) {
+      warn(CFD_LOG_SOURCE, "data_size is null.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError,
+          "Failed to parameter. data_size is null.");
+    }
+    if (psbt_obj->psbt == nullptr) {
+      warn(CFD_LOG_SOURCE, "psbt is null.");
+      throw CfdException(
+          CfdError::kCfdIllegalStateError,
+          "Failed to handle statement. psbt is null.");
+    }
+
+    const std::vector<uint8_t>& bytes = GetPsbtSnapshot(psbt_obj);
+    *data_size = bytes.size();
+    if (psbt_buffer == nullptr) return CfdErrorCode::kCfdSuccess;
+    if (buffer_size < bytes.size()) {
+      warn(CFD_LOG_SOURCE, "psbt_buffer is too small.");
+      throw CfdException(
+          CfdError::kCfdOutOfRangeError,
+          "Failed to parameter. psbt_buffer is too small.");
+    }
+    memcpy(psbt_buffer, bytes.data(), bytes.size());
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    result = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  return result;
+}
+
 int CfdGetPsbtGlobalData(
     void* handle, void* psbt_handle, uint32_t* psbt_version, char** base_tx,
     uint32_t* txin_count, uint32_t* txout_count) {
@@ -397,7 +538,7 @@ int CfdGetPsbtGlobalData(
     auto tx = psbt_obj->psbt->GetTransaction();
     if (txin_count != nullptr) *txin_count = tx.GetTxInCount();
     if (txout_count != nullptr) *txout_count = tx.GetTxOutCount();
-    if (base_tx != nullptr) *base_tx = CreateString(tx.GetHex());
+    if (base_tx != nullptr) *base_tx = CreateString(handle, tx.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -430,7 +571,7 @@ int CfdJoinPsbt(
     }
 
     Psbt join_psbt(psbt_join_base64);
-    psbt_obj->psbt->Join(join_psbt);
+    GetUpdatePsbt(psbt_obj)->Join(join_psbt);
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -469,7 +610,74 @@ int CfdSignPsbt(
     } else {
       privkey_obj = Privkey(privkey_str);
     }
-    psbt_obj->psbt->Sign(privkey_obj, has_grind_r);
+    GetUpdatePsbt(psbt_obj)->Sign(privkey_obj, has_grind_r);
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    result = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  return result;
+}
+
+int CfdAddSignPsbtPrivkey(
+    void* handle, void* psbt_handle, const char* privkey) {
+  int result = CfdErrorCode::kCfdUnknownError;
+  try {
+    cfd::Initialize();
+    CheckBuffer(psbt_handle, kPrefixPsbtHandle);
+    CfdCapiPsbtHandle* psbt_obj = static_cast<CfdCapiPsbtHandle*>(psbt_handle);
+    if (IsEmptyString(privkey)) {
+      warn(CFD_LOG_SOURCE, "privkey is null or empty.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError,
+          "Failed to parameter. privkey is null or empty.");
+    }
+
+    std::string privkey_str(privkey);
+    Privkey privkey_obj;
+    if (Privkey::HasWif(privkey_str)) {
+      privkey_obj = Privkey::FromWif(privkey_str);
+    } else {
+      privkey_obj = Privkey(privkey_str);
+    }
+    if (psbt_obj->sign_privkey_list == nullptr) {
+      psbt_obj->sign_privkey_list = new std::vector<Privkey>();
+    }
+    psbt_obj->sign_privkey_list->push_back(privkey_obj);
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    result = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  return result;
+}
+
+int CfdSignPsbtByPrivkeyList(
+    void* handle, void* psbt_handle, bool has_grind_r, uint32_t thread_count) {
+  int result = CfdErrorCode::kCfdUnknownError;
+  try {
+    cfd::Initialize();
+    CheckBuffer(psbt_handle, kPrefixPsbtHandle);
+    CfdCapiPsbtHandle* psbt_obj = static_cast<CfdCapiPsbtHandle*>(psbt_handle);
+    if (psbt_obj->psbt == nullptr) {
+      warn(CFD_LOG_SOURCE, "psbt is null.");
+      throw CfdException(
+          CfdError::kCfdIllegalStateError,
+          "Failed to handle statement. psbt is null.");
+    }
+
+    if (psbt_obj->sign_privkey_list != nullptr) {
+      GetUpdatePsbt(psbt_obj)->Sign(
+          *psbt_obj->sign_privkey_list, has_grind_r, thread_count);
+      delete psbt_obj->sign_privkey_list;
+      psbt_obj->sign_privkey_list = nullptr;
+    }
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -502,7 +710,73 @@ int CfdCombinePsbt(
     }
 
     Psbt combine_psbt(psbt_combine_base64);
-    psbt_obj->psbt->Combine(combine_psbt);
+    GetUpdatePsbt(psbt_obj)->Combine(combine_psbt);
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    result = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  return result;
+}
+
+int CfdAddCombinePsbtData(
+    void* handle, void* psbt_handle, const char* psbt_combine_base64) {
+  int result = CfdErrorCode::kCfdUnknownError;
+  try {
+    cfd::Initialize();
+    CheckBuffer(psbt_handle, kPrefixPsbtHandle);
+    CfdCapiPsbtHandle* psbt_obj = static_cast<CfdCapiPsbtHandle*>(psbt_handle);
+    if (IsEmptyString(psbt_combine_base64)) {
+      warn(CFD_LOG_SOURCE, "psbt_combine_base64 is null or empty.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError,
+          "Failed to parameter. psbt_combine_base64 is null or empty.");
+    }
+    if (psbt_obj->psbt == nullptr) {
+      warn(CFD_LOG_SOURCE, "psbt is null.");
+      throw CfdException(
+          CfdError::kCfdIllegalStateError,
+          "Failed to handle statement. psbt is null.");
+    }
+
+    Psbt combine_psbt(psbt_combine_base64);
+    if (psbt_obj->combine_list == nullptr) {
+      psbt_obj->combine_list = new std::vector<Psbt>();
+    }
+    psbt_obj->combine_list->push_back(combine_psbt);
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    result = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  return result;
+}
+
+int CfdFinalizeCombinePsbt(
+    void* handle, void* psbt_handle, uint32_t thread_count) {
+  int result = CfdErrorCode::kCfdUnknownError;
+  try {
+    cfd::Initialize();
+    CheckBuffer(psbt_handle, kPrefixPsbtHandle);
+    CfdCapiPsbtHandle* psbt_obj = static_cast<CfdCapiPsbtHandle*>(psbt_handle);
+    if (psbt_obj->psbt == nullptr) {
+      warn(CFD_LOG_SOURCE, "psbt is null.");
+      throw CfdException(
+          CfdError::kCfdIllegalStateError,
+          "Failed to handle statement. psbt is null.");
+    }
+
+    if (psbt_obj->combine_list != nullptr) {
+      GetUpdatePsbt(psbt_obj)->Combine(*psbt_obj->combine_list, thread_count);
+      delete psbt_obj->combine_list;
+      psbt_obj->combine_list = nullptr;
+    }
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -527,7 +801,7 @@ int CfdFinalizePsbt(void* handle, void* psbt_handle) {
           "Failed to handle statement. psbt is null.");
     }
 
-    psbt_obj->psbt->Finalize();
+    GetUpdatePsbt(psbt_obj)->Finalize();
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -559,7 +833,7 @@ int CfdExtractPsbtTransaction(
           "Failed to handle statement. psbt is null.");
     }
 
-    *transaction = CreateString(psbt_obj->psbt->Extract().GetHex());
+    *transaction = CreateString(handle, psbt_obj->psbt->Extract().GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -676,7 +950,7 @@ int CfdAddPsbtTxInWithPubkey(
       locking_script_obj = Script(locking_script);
     }
 
-    psbt_obj->psbt->AddTxIn(outpoint, sequence);
+    GetUpdatePsbt(psbt_obj)->AddTxIn(outpoint, sequence);
     can_restore_psbt = true;
 
     if (!IsEmptyString(full_tx_hex)) {
@@ -687,10 +961,10 @@ int CfdAddPsbtTxInWithPubkey(
             CfdError::kCfdIllegalArgumentError,
             "Failed to parameter. unmatch locking script.");
       }
-      psbt_obj->psbt->SetTxInUtxo(outpoint, tx, Script(), key_list);
+      GetUpdatePsbt(psbt_obj)->SetTxInUtxo(outpoint, tx, Script(), key_list);
     } else if (!locking_script_obj.IsEmpty()) {
       TxOut txout(Amount(amount), locking_script_obj);
-      psbt_obj->psbt->SetTxInUtxo(
+      GetUpdatePsbt(psbt_obj)->SetTxInUtxo(
           outpoint, TxOutReference(txout), Script(), key_list);
     }
     return CfdErrorCode::kCfdSuccess;
@@ -701,7 +975,7 @@ int CfdAddPsbtTxInWithPubkey(
   } catch (...) {
     SetLastFatalError(handle, "unknown error.");
   }
-  if (can_restore_psbt) *(psbt_obj->psbt) = backup_psbt;
+  if (can_restore_psbt) *GetUpdatePsbt(psbt_obj) = backup_psbt;
   return result;
 }
 
@@ -762,7 +1036,7 @@ int CfdAddPsbtTxInWithScript(
       }
     }
 
-    psbt_obj->psbt->AddTxIn(outpoint, sequence);
+    GetUpdatePsbt(psbt_obj)->AddTxIn(outpoint, sequence);
     can_restore_psbt = true;
 
     if (!IsEmptyString(full_tx_hex)) {
@@ -773,10 +1047,10 @@ int CfdAddPsbtTxInWithScript(
             CfdError::kCfdIllegalArgumentError,
             "Failed to parameter. unmatch locking script.");
       }
-      psbt_obj->psbt->SetTxInUtxo(outpoint, tx, script, key_list);
+      GetUpdatePsbt(psbt_obj)->SetTxInUtxo(outpoint, tx, script, key_list);
     } else if (!locking_script_obj.IsEmpty()) {
       TxOut txout(Amount(amount), locking_script_obj);
-      psbt_obj->psbt->SetTxInUtxo(
+      GetUpdatePsbt(psbt_obj)->SetTxInUtxo(
           outpoint, TxOutReference(txout), script, key_list);
     }
     return CfdErrorCode::kCfdSuccess;
@@ -787,7 +1061,7 @@ int CfdAddPsbtTxInWithScript(
   } catch (...) {
     SetLastFatalError(handle, "unknown error.");
   }
-  if (can_restore_psbt) *(psbt_obj->psbt) = backup_psbt;
+  if (can_restore_psbt) *GetUpdatePsbt(psbt_obj) = backup_psbt;
   return result;
 }
 
@@ -816,17 +1090,18 @@ int CfdSetPsbtTxInUtxo(
     std::vector<KeyData> key_list;
     if (!IsEmptyString(full_tx_hex)) {
       Transaction tx(full_tx_hex);
-      psbt_obj->psbt->SetTxInUtxo(outpoint, tx, redeem_script, key_list);
+      GetUpdatePsbt(psbt_obj)->SetTxInUtxo(
+          outpoint, tx, redeem_script, key_list);
     } else if (!IsEmptyString(locking_script)) {
       Script script(locking_script);
       TxOut txout(Amount(amount), script);
       auto pubkeys = psbt_obj->psbt->GetTxInKeyDataList(outpoint);
       if (script.IsWitnessProgram() || (!redeem_script.IsEmpty()) ||
           (!pubkeys.empty())) {
-        psbt_obj->psbt->SetTxInUtxo(
+        GetUpdatePsbt(psbt_obj)->SetTxInUtxo(
             outpoint, TxOutReference(txout), redeem_script, key_list);
       } else {  // on P2SH-segwit
-        psbt_obj->psbt->SetTxInWitnessUtxoDirect(
+        GetUpdatePsbt(psbt_obj)->SetTxInWitnessUtxoDirect(
             outpoint, TxOutReference(txout));
       }
     }
@@ -874,14 +1149,14 @@ int CfdSetPsbtTxInBip32Pubkey(
     auto script = psbt_obj->psbt->GetTxInRedeemScript(outpoint, true);
     auto tx = psbt_obj->psbt->GetTxInUtxoFull(outpoint, true);
     if (tx.GetTxOutCount() > vout) {
-      psbt_obj->psbt->SetTxInUtxo(outpoint, tx, script, key_list);
+      GetUpdatePsbt(psbt_obj)->SetTxInUtxo(outpoint, tx, script, key_list);
     } else {
       auto txout = psbt_obj->psbt->GetTxInUtxo(outpoint, true);
       if (!txout.GetLockingScript().IsEmpty()) {
-        psbt_obj->psbt->SetTxInUtxo(
+        GetUpdatePsbt(psbt_obj)->SetTxInUtxo(
             outpoint, TxOutReference(txout), script, key_list);
       } else {
-        psbt_obj->psbt->SetTxInBip32KeyDirect(outpoint, key_list[0]);
+        GetUpdatePsbt(psbt_obj)->SetTxInBip32KeyDirect(outpoint, key_list[0]);
       }
     }
     return CfdErrorCode::kCfdSuccess;
@@ -930,7 +1205,8 @@ int CfdSetPsbtSignature(
     OutPoint outpoint(Txid(txid), vout);
 
     KeyData key = KeyData(Pubkey(pubkey), std::string(), ByteData());
-    psbt_obj->psbt->SetTxInSignature(outpoint, key, ByteData(der_signature));
+    GetUpdatePsbt(psbt_obj)->SetTxInSignature(
+        outpoint, key, ByteData(der_signature));
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -964,7 +1240,7 @@ int CfdSetPsbtSighashType(
     }
     OutPoint outpoint(Txid(txid), vout);
 
-    psbt_obj->psbt->SetTxInSighashType(
+    GetUpdatePsbt(psbt_obj)->SetTxInSighashType(
         outpoint, SigHashType(static_cast<SigHashAlgorithm>(sighash_type)));
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -1033,7 +1309,7 @@ int CfdSetPsbtFinalizeScript(
     } else {
       script_stack.emplace_back(ByteData(scriptsig));
     }
-    psbt_obj->psbt->SetTxInFinalScript(outpoint, script_stack);
+    GetUpdatePsbt(psbt_obj)->SetTxInFinalScript(outpoint, script_stack);
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -1066,7 +1342,7 @@ int CfdClearPsbtSignData(
     }
     OutPoint outpoint(Txid(txid), vout);
 
-    psbt_obj->psbt->ClearTxInSignData(outpoint);
+    GetUpdatePsbt(psbt_obj)->ClearTxInSignData(outpoint);
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -1184,14 +1460,15 @@ int CfdGetPsbtUtxoDataByIndex(
     auto txin = psbt_obj->psbt->GetTransaction().GetTxIn(index);
     OutPoint outpoint = txin.GetOutPoint();
     if (txid != nullptr) {
-      work_txid = CreateString(outpoint.GetTxid().GetHex());
+      work_txid = CreateString(handle, outpoint.GetTxid().GetHex());
     }
     if (vout != nullptr) *vout = outpoint.GetVout();
 
     auto utxo = psbt_obj->psbt->GetUtxoData(index);
     if (!utxo.locking_script.IsEmpty()) {
       if (locking_script != nullptr) {
-        work_locking_script = CreateString(utxo.locking_script.GetHex());
+        work_locking_script =
+            CreateString(handle, utxo.locking_script.GetHex());
       }
       if (amount != nullptr) *amount = utxo.amount.GetSatoshiValue();
     }
@@ -1199,14 +1476,14 @@ int CfdGetPsbtUtxoDataByIndex(
     Script script = psbt_obj->psbt->GetTxInRedeemScript(index, true);
     if ((!script.IsEmpty()) && (!script.IsP2wpkhScript()) &&
         (redeem_script != nullptr)) {
-      work_redeem_script = CreateString(script.GetHex());
+      work_redeem_script = CreateString(handle, script.GetHex());
     }
 
     auto tx = psbt_obj->psbt->GetTxInUtxoFull(index, true);
     TxOutReference txout;
     if (tx.GetTxOutCount() > outpoint.GetVout()) {
       txout = tx.GetTxOut(outpoint.GetVout());
-      if (full_tx_hex != nullptr) work_tx = CreateString(tx.GetHex());
+      if (full_tx_hex != nullptr) work_tx = CreateString(handle, tx.GetHex());
     }
 
     auto key_list = psbt_obj->psbt->GetTxInKeyDataList(index);
@@ -1242,7 +1519,7 @@ int CfdGetPsbtUtxoDataByIndex(
       }
     }
     if ((!utxo.descriptor.empty()) && (descriptor != nullptr)) {
-      work_descriptor = CreateString(utxo.descriptor);
+      work_descriptor = CreateString(handle, utxo.descriptor);
     }
 
     if (txid != nullptr) *txid = work_txid;
@@ -1298,10 +1575,10 @@ int CfdAddPsbtTxOutWithPubkey(
             "Failed to parameter. " + err_msg);
       }
 
-      txout_index = psbt_obj->psbt->AddTxOutData(
+      txout_index = GetUpdatePsbt(psbt_obj)->AddTxOutData(
           Amount(amount), ref.GenerateAddress(psbt_obj->net_type), key);
     } else if (!script.IsEmpty()) {
-      txout_index = psbt_obj->psbt->AddTxOut(script, Amount(amount));
+      txout_index = GetUpdatePsbt(psbt_obj)->AddTxOut(script, Amount(amount));
     } else {
       warn(CFD_LOG_SOURCE, "locking_script is null or empty.");
       throw CfdException(
@@ -1376,7 +1653,7 @@ int CfdAddPsbtTxOutWithScript(
             "Failed to parameter. " + err_msg);
       }
 
-      txout_index = psbt_obj->psbt->AddTxOutData(
+      txout_index = GetUpdatePsbt(psbt_obj)->AddTxOutData(
           Amount(amount), addr, temp_redeem_script, key_list);
     } else if ((!redeem_script_obj.IsEmpty()) && (!script.IsEmpty())) {
       AddressFactory factory(psbt_obj->net_type);
@@ -1420,10 +1697,10 @@ int CfdAddPsbtTxOutWithScript(
             "Failed to parameter. " + err_msg);
       }
       std::vector<KeyData> key_list;
-      txout_index = psbt_obj->psbt->AddTxOutData(
+      txout_index = GetUpdatePsbt(psbt_obj)->AddTxOutData(
           Amount(amount), addr, redeem_script_obj, key_list);
     } else if (!script.IsEmpty()) {
-      txout_index = psbt_obj->psbt->AddTxOut(script, Amount(amount));
+      txout_index = GetUpdatePsbt(psbt_obj)->AddTxOut(script, Amount(amount));
     } else {
       warn(CFD_LOG_SOURCE, "locking_script is null or empty.");
       throw CfdException(
@@ -1468,7 +1745,7 @@ int CfdSetPsbtTxOutBip32Pubkey(
     ConvertToKeyData(pubkey, fingerprint, bip32_path, &key_list);
 
     auto script = psbt_obj->psbt->GetTxOutScript(index, true);
-    psbt_obj->psbt->SetTxOutData(index, script, key_list);
+    GetUpdatePsbt(psbt_obj)->SetTxOutData(index, script, key_list);
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -1578,7 +1855,7 @@ int CfdGetPsbtPubkeyRecord(
             "Failed to parameter. kind is invalid.");
     }
 
-    *value = CreateString(data.GetHex());
+    *value = CreateString(handle, data.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -1717,9 +1994,10 @@ int CfdGetPsbtBip32Data(
     }
 
     if (fingerprint != nullptr) {
-      work_fingerprint = CreateString(key.GetFingerprint().GetHex());
+      work_fingerprint = CreateString(handle, key.GetFingerprint().GetHex());
     }
-    if (bip32_path != nullptr) work_path = CreateString(key.GetBip32Path());
+    if (bip32_path != nullptr) work_path =
+        CreateString(handle, key.GetBip32Path());
 
     if (fingerprint != nullptr) *fingerprint = work_fingerprint;
     if (bip32_path != nullptr) *bip32_path = work_path;
@@ -1799,7 +2077,7 @@ int CfdGetPsbtPubkeyList(
 
     buffer = static_cast<CfdCapiPsbtPubkeyListHandle*>(AllocBuffer(
         kPrefixPsbtPubkeyList, sizeof(CfdCapiPsbtPubkeyListHandle)));
-    buffer->key_list = new std::vector<KeyData>();
+    buffer->key_list = NewPooledVector<KeyData>();
     buffer->has_bip32_list = has_bip32_list;
     buffer->has_xpub_list = has_xpub_list;
     *(buffer->key_list) = key_list;
@@ -1849,15 +2127,15 @@ int CfdGetPsbtPubkeyListData(
     auto key = list_handle->key_list->at(index);
     if (list_handle->has_xpub_list) {
       auto extkey = key.GetExtPubkey();
-      work_pubkey = CreateString(extkey.ToString());
+      work_pubkey = CreateString(handle, extkey.ToString());
       if (pubkey_hex != nullptr) {
-        work_pubkey_hex = CreateString(extkey.GetData().GetHex());
+        work_pubkey_hex = CreateString(handle, extkey.GetData().GetHex());
       }
     } else {
       auto pubkey_obj = key.GetPubkey();
-      work_pubkey = CreateString(pubkey_obj.GetHex());
+      work_pubkey = CreateString(handle, pubkey_obj.GetHex());
       if (pubkey_hex != nullptr) {
-        work_pubkey_hex = CreateString(pubkey_obj.GetHex());
+        work_pubkey_hex = CreateString(handle, pubkey_obj.GetHex());
       }
     }
 
@@ -1912,14 +2190,15 @@ int CfdGetPsbtPubkeyListBip32Data(
 
     auto key = list_handle->key_list->at(index);
     if (list_handle->has_xpub_list) {
-      work_pubkey = CreateString(key.GetExtPubkey().ToString());
+      work_pubkey = CreateString(handle, key.GetExtPubkey().ToString());
     } else {
-      work_pubkey = CreateString(key.GetPubkey().GetHex());
+      work_pubkey = CreateString(handle, key.GetPubkey().GetHex());
     }
     if (fingerprint != nullptr) {
-      work_fingerprint = CreateString(key.GetFingerprint().GetHex());
+      work_fingerprint = CreateString(handle, key.GetFingerprint().GetHex());
     }
-    if (bip32_path != nullptr) work_path = CreateString(key.GetBip32Path());
+    if (bip32_path != nullptr) work_path =
+        CreateString(handle, key.GetBip32Path());
 
     *pubkey = work_pubkey;
     if (fingerprint != nullptr) *fingerprint = work_fingerprint;
@@ -1945,7 +2224,7 @@ int CfdFreePsbtPubkeyList(void* handle, void* pubkey_list_handle) {
       CfdCapiPsbtPubkeyListHandle* list_handle =
           static_cast<CfdCapiPsbtPubkeyListHandle*>(pubkey_list_handle);
       if (list_handle->key_list != nullptr) {
-        delete list_handle->key_list;
+        DeletePooledVector(list_handle->key_list);
         list_handle->key_list = nullptr;
       }
       FreeBuffer(
@@ -2014,7 +2293,7 @@ int CfdGetPsbtByteDataList(
 
     buffer = static_cast<CfdCapiPsbtByteDataListHandle*>(AllocBuffer(
         kPrefixPsbtByteDataList, sizeof(CfdCapiPsbtByteDataListHandle)));
-    buffer->data_list = new std::vector<ByteData>();
+    buffer->data_list = NewPooledVector<ByteData>();
     *(buffer->data_list) = data_list;
     *list_num = static_cast<uint32_t>(data_list.size());
     *data_list_handle = buffer;
@@ -2057,7 +2336,7 @@ int CfdGetPsbtByteDataItem(
     }
 
     auto byte_data = list_handle->data_list->at(index);
-    *data = CreateString(byte_data.GetHex());
+    *data = CreateString(handle, byte_data.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -2078,7 +2357,7 @@ int CfdFreePsbtByteDataList(void* handle, void* data_list_handle) {
       CfdCapiPsbtByteDataListHandle* list_handle =
           static_cast<CfdCapiPsbtByteDataListHandle*>(data_list_handle);
       if (list_handle->data_list != nullptr) {
-        delete list_handle->data_list;
+        DeletePooledVector(list_handle->data_list);
         list_handle->data_list = nullptr;
       }
       FreeBuffer(
@@ -2159,7 +2438,7 @@ int CfdAddPsbtGlobalXpubkey(
           key_data.GetExtPubkey(), std::string(bip32_path),
           ByteData(fingerprint));
     }
-    psbt_obj->psbt->SetGlobalXpubkey(key_data);
+    GetUpdatePsbt(psbt_obj)->SetGlobalXpubkey(key_data);
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -2197,11 +2476,11 @@ int CfdSetPsbtRedeemScript(
     switch (type) {
       case kCfdPsbtRecordTypeInput: {
         auto txout = psbt_obj->psbt->GetTxInUtxo(index);
-        psbt_obj->psbt->SetTxInUtxo(
+        GetUpdatePsbt(psbt_obj)->SetTxInUtxo(
             index, TxOutReference(txout), script, key_list);
       } break;
       case kCfdPsbtRecordTypeOutput:
-        psbt_obj->psbt->SetTxOutData(index, script, key_list);
+        GetUpdatePsbt(psbt_obj)->SetTxOutData(index, script, key_list);
         break;
       default:
         warn(CFD_LOG_SOURCE, "type is invalid: {}", type);
@@ -2251,13 +2530,13 @@ int CfdAddPsbtRecord(
     ByteData data(value);
     switch (type) {
       case kCfdPsbtRecordTypeGlobal:
-        psbt_obj->psbt->SetGlobalRecord(key_data, data);
+        GetUpdatePsbt(psbt_obj)->SetGlobalRecord(key_data, data);
         break;
       case kCfdPsbtRecordTypeInput:
-        psbt_obj->psbt->SetTxInRecord(index, key_data, data);
+        GetUpdatePsbt(psbt_obj)->SetTxInRecord(index, key_data, data);
         break;
       case kCfdPsbtRecordTypeOutput:
-        psbt_obj->psbt->SetTxOutRecord(index, key_data, data);
+        GetUpdatePsbt(psbt_obj)->SetTxOutRecord(index, key_data, data);
         break;
       default:
         warn(CFD_LOG_SOURCE, "type is invalid: {}", type);
@@ -2323,7 +2602,7 @@ int CfdGetPsbtRecord(
             "Failed to parameter. type is invalid.");
     }
 
-    *value = CreateString(data.GetHex());
+    *value = CreateString(handle, data.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -2616,7 +2895,7 @@ int CfdFinalizeFundPsbt(
       change_address_ptr = &change_address;
     }
 
-    auto used_utxos = psbt_obj->psbt->FundTransaction(
+    auto used_utxos = GetUpdatePsbt(psbt_obj)->FundTransaction(
         *(buffer->utxos), buffer->fee_rate, change_address_ptr, &tx_fee_value,
         &option_params, &filter, psbt_obj->net_type);
     {
@@ -2689,13 +2968,15 @@ int CfdGetFundPsbtUsedUtxo(
     if (vout != nullptr) *vout = utxo.vout;
     if (amount != nullptr) *amount = utxo.amount.GetSatoshiValue();
 
-    if (txid != nullptr) work_txid = CreateString(utxo.txid.GetHex());
+    if (txid != nullptr) work_txid = CreateString(handle, utxo.txid.GetHex());
 #ifndef CFD_DISABLE_ELEMENTS
-    if (asset != nullptr) work_asset = CreateString(utxo.asset.GetHex());
+    if (asset != nullptr) work_asset =
+        CreateString(handle, utxo.asset.GetHex());
 #endif  // CFD_DISABLE_ELEMENTS
-    if (descriptor != nullptr) work_descriptor = CreateString(utxo.descriptor);
+    if (descriptor != nullptr) work_descriptor =
+        CreateString(handle, utxo.descriptor);
     if (scriptsig_template != nullptr) {
-      work_scriptsig = CreateString(utxo.scriptsig_template.GetHex());
+      work_scriptsig = CreateString(handle, utxo.scriptsig_template.GetHex());
     }
 
     if (txid != nullptr) *txid = work_txid;
@@ -196,7 +196,7 @@ int CfdGetScriptItem(
     }
 
     const std::string& item_str = buffer->script_items->at(index);
-    *script_item = CreateString(item_str);
+    *script_item = CreateString(handle, item_str);
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     return SetLastError(handle, except);
@@ -254,7 +254,7 @@ int CfdConvertScriptAsmToHex(
     }
     Script script = sb.Build();
 
-    *script_hex = CreateString(script.GetHex());
+    *script_hex = CreateString(handle, script.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     return SetLastError(handle, except);
@@ -425,7 +425,7 @@ int CfdFinalizeMultisigScriptSig(
     TransactionApi api;
     std::string multisig_scriptsig =
         api.CreateMultisigScriptSig(sign_list, redeem_script_obj);
-    *scriptsig = CreateString(multisig_scriptsig);
+    *scriptsig = CreateString(handle, multisig_scriptsig);
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -649,7 +649,7 @@ int CfdSetTapScriptByWitnessStack(
     for (const auto& node : nodes) new_tree.AddBranch(node);
 
     if (internal_pubkey != nullptr) {
-      work_internal_pubkey = CreateString(internal_pubkey_obj.GetHex());
+      work_internal_pubkey = CreateString(handle, internal_pubkey_obj.GetHex());
     }
 
     tree = new_tree;
@@ -836,22 +836,24 @@ int CfdGetBaseTapLeaf(
       auto& branch = buffer->branch_buffer->at(0);
       if (branch.HasTapLeaf()) {
         if (tapscript != nullptr) {
-          work_tapscript = CreateString(branch.GetScript().GetHex());
+          work_tapscript = CreateString(handle, branch.GetScript().GetHex());
         }
         if (leaf_version != nullptr) *leaf_version = branch.GetLeafVersion();
       } else {
         if (leaf_version != nullptr) *leaf_version = 0;
       }
       if (tap_leaf_hash != nullptr) {
-        work_tap_leaf_hash = CreateString(branch.GetBaseHash().GetHex());
+        work_tap_leaf_hash =
+            CreateString(handle, branch.GetBaseHash().GetHex());
       }
     } else {
       auto& tree = buffer->tree_buffer->at(0);
       if (tapscript != nullptr) {
-        work_tapscript = CreateString(tree.GetScript().GetHex());
+        work_tapscript = CreateString(handle, tree.GetScript().GetHex());
       }
       if (tap_leaf_hash != nullptr) {
-        work_tap_leaf_hash = CreateString(tree.GetTapLeafHash().GetHex());
+        work_tap_leaf_hash =
+            CreateString(handle, tree.GetTapLeafHash().GetHex());
       }
       if (leaf_version != nullptr) *leaf_version = tree.GetLeafVersion();
     }
@@ -940,10 +942,10 @@ int CfdGetTapBranchData(
     }
 
     if (has_leaf && (tapscript != nullptr)) {
-      work_tapscript = CreateString(branch_data.GetScript().GetHex());
+      work_tapscript = CreateString(handle, branch_data.GetScript().GetHex());
     }
     if (branch_hash != nullptr) {
-      work_branch_hash = CreateString(hash_obj.GetHex());
+      work_branch_hash = CreateString(handle, hash_obj.GetHex());
     }
 
     if (leaf_version != nullptr) {
@@ -999,7 +1001,7 @@ int CfdGetTapBranchHandle(
     TapBranch& branch_data = branches.at(index_from_leaf);
     ByteData256 hash_obj = branch_data.GetCurrentBranchHash();
     if (branch_hash != nullptr) {
-      work_branch_hash = CreateString(hash_obj.GetHex());
+      work_branch_hash = CreateString(handle, hash_obj.GetHex());
     }
 
     work_branch_buffer = static_cast<CfdCapiTapscriptTree*>(
@@ -1053,7 +1055,8 @@ int CfdGetTaprootScriptTreeHash(
     } else {
       auto& tree = buffer->tree_buffer->at(0);
       if (tap_leaf_hash != nullptr) {
-        work_tap_leaf_hash = CreateString(tree.GetTapLeafHash().GetHex());
+        work_tap_leaf_hash =
+            CreateString(handle, tree.GetTapLeafHash().GetHex());
       }
       branch = tree;
     }
@@ -1062,10 +1065,10 @@ int CfdGetTaprootScriptTreeHash(
         SchnorrPubkey(internal_pubkey), branch, &tapscript_hash);
 
     if (hash != nullptr) {
-      work_hash = CreateString(tapscript_hash.GetHex());
+      work_hash = CreateString(handle, tapscript_hash.GetHex());
     }
     if (control_block != nullptr) {
-      work_control_block = CreateString(control.GetHex());
+      work_control_block = CreateString(handle, control.GetHex());
     }
 
     if (hash != nullptr) *hash = work_hash;
@@ -1119,7 +1122,7 @@ int CfdGetTaprootTweakedPrivkey(
       privkey = Privkey(internal_privkey);
     }
     auto taproot_privkey = branch.GetTweakedPrivkey(privkey);
-    *tweaked_privkey = CreateString(taproot_privkey.GetHex());
+    *tweaked_privkey = CreateString(handle, taproot_privkey.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -1147,7 +1150,7 @@ int CfdGetTaprootScriptTreeSrting(
     }
 
     if (tree_string != nullptr) {
-      *tree_string = CreateString(tree_str);
+      *tree_string = CreateString(handle, tree_str);
     }
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
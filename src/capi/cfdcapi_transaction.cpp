@@ -7,8 +7,13 @@
 #ifndef CFD_DISABLE_CAPI
 #include "cfdc/cfdcapi_transaction.h"
 
+#include <algorithm>
+#include <cstring>
 #include <exception>
+#include <functional>
+#include <limits>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -161,8 +166,307 @@ struct CfdCapiSplitTxOutData {
   std::vector<std::string>* nonce_list;      //!< nonce list
 };
 
+//! parsed transaction cache size on each thread
+constexpr size_t kTransactionCacheSize = 4;
+
+/**
+ * @brief parsed transaction cache entry.
+ */
+template <class TransactionType>
+struct CfdCapiTransactionCache {
+  size_t hash;                                //!< tx hex hash
+  std::string tx_hex;                         //!< tx hex
+  std::shared_ptr<const TransactionType> tx;  //!< parsed transaction
+};
+
+/**
+ * @brief Get the parsed transaction from the cache list.
+ * @details The cache list is ordered by the most recently used.
+ * @param[in] tx_hex            transaction hex
+ * @param[in,out] cache_list    cache list
+ * @return parsed transaction
+ */
+template <class TransactionType>
+static std::shared_ptr<const TransactionType> GetCachedTransactionObject(
+    const std::string& tx_hex,
+    std::vector<CfdCapiTransactionCache<TransactionType>>* cache_list) {
+  size_t hash = std::hash<std::string>()(tx_hex);
+  for (auto ite = cache_list->begin(); ite != cache_list->end(); ++ite) {
+    if ((ite->hash == hash) && (ite->tx_hex == tx_hex)) {
+      std::rotate(cache_list->begin(), ite, ite + 1);
+      return cache_list->front().tx;
+    }
+  }
+  CfdCapiTransactionCache<TransactionType> cache;
+  cache.hash = hash;
+  cache.tx_hex = tx_hex;
+  cache.tx = std::make_shared<const TransactionType>(tx_hex);
+  if (cache_list->size() >= kTransactionCacheSize) cache_list->pop_back();
+  cache_list->insert(cache_list->begin(), cache);
+  return cache.tx;
+}
+
+std::shared_ptr<const TransactionContext> GetCachedTransaction(
+    const std::string& tx_hex) {
+  static thread_local std::vector<CfdCapiTransactionCache<TransactionContext>>
+      cache_list;
+  return GetCachedTransactionObject(tx_hex, &cache_list);
+}
+
+#ifndef CFD_DISABLE_ELEMENTS
+std::shared_ptr<const ConfidentialTransactionContext>
+GetCachedConfidentialTransaction(const std::string& tx_hex) {
+  static thread_local std::vector<
+      CfdCapiTransactionCache<ConfidentialTransactionContext>>
+      cache_list;
+  return GetCachedTransactionObject(tx_hex, &cache_list);
+}
+#endif  // CFD_DISABLE_ELEMENTS
+
+/**
+ * @brief txin data for the bulk getter.
+ */
+struct CfdCapiTxInListItem {
+  ByteData txid;                  //!< txid byte data
+  uint32_t vout;                  //!< vout
+  uint32_t sequence;              //!< sequence
+  ByteData script_sig;            //!< script signature
+  std::vector<ByteData> witness;  //!< witness stack
+};
+
+/**
+ * @brief Copy the data into the bulk getter buffer.
+ * @param[in] data          byte data
+ * @param[in,out] buffer    data buffer
+ * @param[in,out] offset    data offset
+ * @param[out] range        data range
+ */
+static void CopyToTxDataBuffer(
+    const ByteData& data, uint8_t* buffer, size_t* offset,
+    CfdTxDataRange* range) {
+  const std::vector<uint8_t> bytes = data.GetBytes();
+  range->offset = *offset;
+  range->size = bytes.size();
+  if (!bytes.empty()) memcpy(buffer + *offset, bytes.data(), bytes.size());
+  *offset += range->size;
+}
+
+/**
+ * @brief Copy the data into the fixed size field of the txout data.
+ * @details The field is zero filled if the data is empty or too large.
+ * @param[in] data          byte data
+ * @param[out] field        fixed size field
+ * @param[in] field_size    field size
+ */
+static void CopyTxOutFixedData(
+    const ByteData& data, uint8_t* field, size_t field_size) {
+  memset(field, 0, field_size);
+  const std::vector<uint8_t> bytes = data.GetBytes();
+  if ((!bytes.empty()) && (bytes.size() <= field_size)) {
+    memcpy(field, bytes.data(), bytes.size());
+  }
+}
+
+/**
+ * @brief Check the bulk getter output capacity.
+ * @param[in] name          parameter name
+ * @param[in] is_null       output is null
+ * @param[in] capacity      output capacity
+ * @param[in] required      required size
+ */
+static void CheckTxListCapacity(
+    const char* name, bool is_null, size_t capacity, size_t required) {
+  if ((required != 0) && (is_null || (capacity < required))) {
+    warn(CFD_LOG_SOURCE, "{} is too small.", name);
+    throw CfdException(
+        CfdError::kCfdOutOfRangeError,
+        std::string("Failed to parameter. ") + name + " is too small.");
+  }
+}
+
+/**
+ * @brief Create the transaction data handle.
+ * @param[in] net_type      network type.
+ * @param[out] buffer       transaction data handle.
+ * @param[in] tx_args       transaction hex, byte data, or version and locktime.
+ */
+template <typename... Args>
+static void CreateTxDataHandle(
+    int net_type, CfdCapiTransactionData** buffer, const Args&... tx_args) {
+  bool is_bitcoin = false;
+  ConvertNetType(net_type, &is_bitcoin);
+  if (!is_bitcoin) {
+#ifndef CFD_DISABLE_ELEMENTS
+    info(CFD_LOG_SOURCE, "net_type[{}]", net_type);
+#else
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
+#endif  // CFD_DISABLE_ELEMENTS
+  }
+
+  *buffer = static_cast<CfdCapiTransactionData*>(
+      AllocBuffer(kPrefixTransactionData, sizeof(CfdCapiTransactionData)));
+  (*buffer)->net_type = net_type;
+  if (is_bitcoin) {
+    (*buffer)->tx_obj = new TransactionContext(tx_args...);
+  } else {
+#ifndef CFD_DISABLE_ELEMENTS
+    (*buffer)->tx_obj = new ConfidentialTransactionContext(tx_args...);
+#endif  // CFD_DISABLE_ELEMENTS
+  }
+}
+
+/**
+ * @brief Copy the transaction into the byte buffer.
+ * @details If tx_buffer is null, only the data size is set.
+ * @param[in] tx_data_handle    transaction data handle.
+ * @param[out] tx_buffer        transaction byte buffer. (nullable)
+ * @param[in] buffer_size       transaction byte buffer size.
+ * @param[out] data_size        transaction byte data size.
+ */
+static void CopyTxDataHandleToBuffer(
+    void* tx_data_handle, uint8_t* tx_buffer, size_t buffer_size,
+    size_t* data_size) {
+  CheckBuffer(tx_data_handle, kPrefixTransactionData);
+  CfdCapiTransactionData* tx_data =
+      static_cast<CfdCapiTransactionData*>(tx_data_handle);
+  if (data_size == nullptr) {
+    warn(CFD_LOG_SOURCE, "data_size is null.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError,
+        "Failed to parameter. data_size is null.");
+  }
+
+  bool is_bitcoin = false;
+  ConvertNetType(tx_data->net_type, &is_bitcoin);
+  if (tx_data->tx_obj == nullptr) {
+    throw CfdException(
+        CfdError::kCfdIllegalStateError, "Invalid handle state. tx is null");
+  } else if (is_bitcoin) {
+    TransactionContext* tx = static_cast<TransactionContext*>(tx_data->tx_obj);
+    *data_size = tx->CopyData(tx_buffer, buffer_size);
+  } else {
+#ifndef CFD_DISABLE_ELEMENTS
+    ConfidentialTransactionContext* tx =
+        static_cast<ConfidentialTransactionContext*>(tx_data->tx_obj);
+    *data_size = tx->CopyData(tx_buffer, buffer_size);
+#else
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
+#endif  // CFD_DISABLE_ELEMENTS
+  }
+
+  if ((tx_buffer != nullptr) && (buffer_size < *data_size)) {
+    warn(CFD_LOG_SOURCE, "tx_buffer is too small.");
+    throw CfdException(
+        CfdError::kCfdOutOfRangeError,
+        "Failed to parameter. tx_buffer is too small.");
+  }
+}
+
+/**
+ * @brief Add the sign on the transaction input.
+ * @param[in] tx_data       transaction data handle.
+ * @param[in] sign_data     txin sign data.
+ * @param[in] has_grind_r   Grind-R flag on sign.
+ */
+static void AddTxInSign(
+    const CfdCapiTransactionData* tx_data, const CfdTxInSignData& sign_data,
+    bool has_grind_r) {
+  bool is_bitcoin = false;
+  ConvertNetType(tx_data->net_type, &is_bitcoin);
+  OutPoint outpoint(
+      Txid(ByteData256(std::vector<uint8_t>(
+          sign_data.txid, sign_data.txid + sizeof(sign_data.txid)))),
+      sign_data.vout);
+  SigHashType sighashtype = SigHashType::Create(
+      static_cast<uint8_t>(sign_data.sighash_type),
+      sign_data.sighash_anyone_can_pay);
+
+  if (!IsEmptyString(sign_data.privkey)) {
+    Privkey privkey;
+    std::string privkey_str(sign_data.privkey);
+    if (Privkey::HasWif(privkey_str)) {
+      privkey = Privkey::FromWif(privkey_str);
+    } else {
+      privkey = Privkey(privkey_str);
+    }
+
+    bool has_utxo = !IsEmptyString(sign_data.descriptor) ||
+                    !IsEmptyString(sign_data.locking_script);
+    UtxoData utxo;
+    utxo.address_type = AddressType::kP2shAddress;
+    utxo.block_height = 0;
+    utxo.binary_data = nullptr;
+    utxo.txid = outpoint.GetTxid();
+    utxo.vout = outpoint.GetVout();
+    utxo.amount = Amount(sign_data.amount);
+    if (!IsEmptyString(sign_data.descriptor)) {
+      utxo.descriptor = std::string(sign_data.descriptor);
+    } else if (!IsEmptyString(sign_data.locking_script)) {
+      utxo.locking_script = Script(sign_data.locking_script);
+    }
+
+    if (is_bitcoin) {
+      ByteData annex;
+      bool has_annex = !IsEmptyString(sign_data.annex);
+      if (has_annex) annex = ByteData(sign_data.annex);
+      ByteData256 aux_rand;
+      bool has_aux_rand = !IsEmptyString(sign_data.aux_rand);
+      if (has_aux_rand) aux_rand = ByteData256(sign_data.aux_rand);
+
+      TransactionContext* tx =
+          static_cast<TransactionContext*>(tx_data->tx_obj);
+      if (has_utxo) tx->CollectInputUtxo({utxo});
+      tx->SignWithKey(
+          outpoint, privkey.GetPubkey(), privkey, sighashtype, has_grind_r,
+          (has_aux_rand) ? &aux_rand : nullptr,
+          (has_annex) ? &annex : nullptr);
+    } else {
+#ifndef CFD_DISABLE_ELEMENTS
+      if (!IsEmptyString(sign_data.commitment)) {
+        utxo.value_commitment = ConfidentialValue(sign_data.commitment);
+      }
+      ConfidentialTransactionContext* tx =
+          static_cast<ConfidentialTransactionContext*>(tx_data->tx_obj);
+      if (has_utxo) tx->CollectInputUtxo({utxo});
+      tx->SignWithKey(
+          outpoint, privkey.GetPubkey(), privkey, sighashtype, has_grind_r);
+#endif  // CFD_DISABLE_ELEMENTS
+    }
+    return;
+  }
+
+  if (IsEmptyString(sign_data.pubkey) || IsEmptyString(sign_data.signature)) {
+    warn(CFD_LOG_SOURCE, "privkey or pubkey and signature is empty.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError,
+        "Failed to parameter. privkey or pubkey and signature is empty.");
+  }
+  AddressType addr_type = ConvertHashToAddressType(sign_data.hash_type);
+  SignParameter param;
+  if (sign_data.use_der_encode) {
+    param = SignParameter(
+        ByteData(std::string(sign_data.signature)), true, sighashtype);
+  } else {
+    param = SignParameter(std::string(sign_data.signature));
+  }
+  Pubkey pubkey(sign_data.pubkey);
+  if (is_bitcoin) {
+    TransactionContext* tx = static_cast<TransactionContext*>(tx_data->tx_obj);
+    tx->AddPubkeyHashSign(outpoint, param, pubkey, addr_type);
+  } else {
+#ifndef CFD_DISABLE_ELEMENTS
+    ConfidentialTransactionContext* tx =
+        static_cast<ConfidentialTransactionContext*>(tx_data->tx_obj);
+    tx->AddPubkeyHashSign(outpoint, param, pubkey, addr_type);
+#endif  // CFD_DISABLE_ELEMENTS
+  }
+}
+
 /**
  * @brief get transaction information.
+ * @param[in] handle            cfd handle.
  * @param[in] tx                transaction.
  * @param[out] txid             transaction id.
  *   If 'CfdFreeStringBuffer' is implemented,
@@ -178,13 +482,14 @@ struct CfdCapiSplitTxOutData {
  * @param[out] locktime         transaction locktime.
  */
 void GetTxInfo(
-    AbstractTransaction* tx, char** txid, char** wtxid, uint32_t* size,
-    uint32_t* vsize, uint32_t* weight, uint32_t* version, uint32_t* locktime) {
+    void* handle, const AbstractTransaction* tx, char** txid, char** wtxid,
+    uint32_t* size, uint32_t* vsize, uint32_t* weight, uint32_t* version,
+    uint32_t* locktime) {
   if (txid != nullptr) {
-    *txid = CreateString(tx->GetTxid().GetHex());
+    *txid = CreateString(handle, tx->GetTxid().GetHex());
   }
   if (wtxid != nullptr) {
-    *wtxid = CreateString(Txid(tx->GetWitnessHash()).GetHex());
+    *wtxid = CreateString(handle, Txid(tx->GetWitnessHash()).GetHex());
   }
   if (size != nullptr) {
     *size = tx->GetTotalSize();
@@ -209,19 +514,30 @@ void GetTxInfo(
 // =============================================================================
 // extern c-api
 // =============================================================================
+using cfd::capi::AddTxInSign;
 using cfd::capi::AllocBuffer;
 using cfd::capi::CfdCapiFundRawTxData;
 using cfd::capi::CfdCapiFundTargetAmount;
 using cfd::capi::CfdCapiMultisigSignData;
 using cfd::capi::CfdCapiSplitTxOutData;
 using cfd::capi::CfdCapiTransactionData;
+using cfd::capi::CfdCapiTxInListItem;
 using cfd::capi::CheckBuffer;
+using cfd::capi::CheckTxListCapacity;
 using cfd::capi::ConvertAddressType;
 using cfd::capi::ConvertHashToAddressType;
 using cfd::capi::ConvertNetType;
+using cfd::capi::CopyToTxDataBuffer;
+using cfd::capi::CopyTxDataHandleToBuffer;
 using cfd::capi::CreateString;
+using cfd::capi::CreateTxDataHandle;
+using cfd::capi::DeletePooledVector;
 using cfd::capi::FreeBuffer;
 using cfd::capi::FreeBufferOnError;
+using cfd::capi::GetCachedTransaction;
+#ifndef CFD_DISABLE_ELEMENTS
+using cfd::capi::GetCachedConfidentialTransaction;
+#endif  // CFD_DISABLE_ELEMENTS
 using cfd::capi::GetTxInfo;
 using cfd::capi::GetWitnessVersion;
 using cfd::capi::IsElementsNetType;
@@ -234,6 +550,7 @@ using cfd::capi::kPrefixSplitTxOut;
 using cfd::capi::kPrefixTransactionData;
 using cfd::capi::kPubkeyHexSize;
 using cfd::capi::kSignatureHexSize;
+using cfd::capi::NewPooledVector;
 using cfd::capi::SetLastError;
 using cfd::capi::SetLastFatalError;
 
@@ -291,6 +608,38 @@ int CfdInitializeTransaction(
   return result;
 }
 
+int CfdInitializeTransactionByBytes(
+    void* handle, int net_type, uint32_t version, uint32_t locktime,
+    const uint8_t* tx_bytes, size_t tx_size, void** create_handle) {
+  int result = CfdErrorCode::kCfdUnknownError;
+  CfdCapiTransactionData* buffer = nullptr;
+  try {
+    cfd::Initialize();
+    if (create_handle == nullptr) {
+      warn(CFD_LOG_SOURCE, "create handle is null.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError,
+          "Failed to parameter. create handle is null.");
+    }
+    if ((tx_bytes != nullptr) && (tx_size != 0)) {
+      return CfdInitializeTxDataHandleByBytes(
+          handle, net_type, tx_bytes, tx_size, create_handle);
+    }
+
+    CreateTxDataHandle(net_type, &buffer, version, locktime);
+    *create_handle = buffer;
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    result = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  CfdFreeTxDataHandle(handle, buffer);
+  return result;
+}
+
 int CfdAddTransactionInput(
     void* handle, void* create_handle, const char* txid, uint32_t vout,
     uint32_t sequence) {
@@ -436,9 +785,9 @@ int CfdCreateSplitTxOutHandle(
     buffer = static_cast<CfdCapiSplitTxOutData*>(
         AllocBuffer(kPrefixSplitTxOut, sizeof(CfdCapiSplitTxOutData)));
     buffer->net_type = network_type;
-    buffer->amount_list = new std::vector<Amount>();
-    buffer->locking_script_list = new std::vector<Script>();
-    buffer->nonce_list = new std::vector<std::string>();
+    buffer->amount_list = NewPooledVector<Amount>();
+    buffer->locking_script_list = NewPooledVector<Script>();
+    buffer->nonce_list = NewPooledVector<std::string>();
     *split_output_handle = buffer;
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -597,15 +946,15 @@ int CfdFreeSplitTxOutHandle(void* handle, void* split_output_handle) {
       CfdCapiSplitTxOutData* data =
           static_cast<CfdCapiSplitTxOutData*>(split_output_handle);
       if (data->amount_list != nullptr) {
-        delete data->amount_list;
+        DeletePooledVector(data->amount_list);
         data->amount_list = nullptr;
       }
       if (data->locking_script_list != nullptr) {
-        delete data->locking_script_list;
+        DeletePooledVector(data->locking_script_list);
         data->locking_script_list = nullptr;
       }
       if (data->nonce_list != nullptr) {
-        delete data->nonce_list;
+        DeletePooledVector(data->nonce_list);
         data->nonce_list = nullptr;
       }
     }
@@ -1053,7 +1402,7 @@ int CfdCreateSighashByHandle(
 #endif  // CFD_DISABLE_ELEMENTS
     }
 
-    *sighash = CreateString(sighash_bytes.GetHex());
+    *sighash = CreateString(handle, sighash_bytes.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     return SetLastError(handle, except);
@@ -1431,6 +1780,73 @@ int CfdAddPubkeyHashSignByHandle(
   }
 }
 
+int CfdAddSignListByHandle(
+    void* handle, void* create_handle, const CfdTxInSignData* sign_list,
+    uint32_t sign_list_size, bool has_grind_r, int* result_list) {
+  try {
+    cfd::Initialize();
+    CheckBuffer(create_handle, kPrefixTransactionData);
+    CfdCapiTransactionData* tx_data =
+        static_cast<CfdCapiTransactionData*>(create_handle);
+    if ((sign_list == nullptr) && (sign_list_size != 0)) {
+      warn(CFD_LOG_SOURCE, "sign_list is null.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError,
+          "Failed to parameter. sign_list is null.");
+    }
+    bool is_bitcoin = false;
+    ConvertNetType(tx_data->net_type, &is_bitcoin);
+    if (tx_data->tx_obj == nullptr) {
+      throw CfdException(
+          CfdError::kCfdIllegalStateError, "Invalid handle state. tx is null");
+    }
+#ifdef CFD_DISABLE_ELEMENTS
+    if (!is_bitcoin) {
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
+    }
+#endif  // CFD_DISABLE_ELEMENTS
+
+    // continue on error, and report the first error.
+    int first_result = CfdErrorCode::kCfdSuccess;
+    std::string first_message;
+    for (uint32_t index = 0; index < sign_list_size; ++index) {
+      int result = CfdErrorCode::kCfdSuccess;
+      std::string message;
+      try {
+        AddTxInSign(tx_data, sign_list[index], has_grind_r);
+      } catch (const CfdException& except) {
+        result = except.GetErrorCode();
+        message = except.what();
+      } catch (const std::exception& std_except) {
+        result = CfdErrorCode::kCfdUnknownError;
+        message = std_except.what();
+      } catch (...) {
+        result = CfdErrorCode::kCfdUnknownError;
+        message = "unknown error.";
+      }
+      if (result_list != nullptr) result_list[index] = result;
+      if ((result != CfdErrorCode::kCfdSuccess) &&
+          (first_result == CfdErrorCode::kCfdSuccess)) {
+        first_result = result;
+        first_message = "index[" + std::to_string(index) + "] " + message;
+      }
+    }
+    if (first_result != CfdErrorCode::kCfdSuccess) {
+      return SetLastError(handle, first_result, first_message.c_str());
+    }
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    return SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+    return CfdErrorCode::kCfdUnknownError;
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+    return CfdErrorCode::kCfdUnknownError;
+  }
+}
+
 int CfdAddScriptHashLastSignByHandle(
     void* handle, void* create_handle, const char* txid, uint32_t vout,
     int hash_type, const char* redeem_script) {
@@ -1494,6 +1910,13 @@ int CfdFinalizeTransaction(
   return CfdGetModifiedTxByHandle(handle, create_handle, tx_hex_string);
 }
 
+int CfdFinalizeTransactionBytes(
+    void* handle, void* create_handle, uint8_t* tx_buffer, size_t buffer_size,
+    size_t* data_size) {
+  return CfdGetModifiedTxBytesByHandle(
+      handle, create_handle, tx_buffer, buffer_size, data_size);
+}
+
 int CfdFreeTransactionHandle(void* handle, void* create_handle) {
   return CfdFreeTxDataHandle(handle, create_handle);
 }
@@ -1522,12 +1945,12 @@ int CfdUpdateTxOutAmount(
     if (is_bitcoin) {
       TransactionContext tx(tx_hex_string);
       tx.SetTxOutValue(index, Amount(amount));
-      *tx_string = CreateString(tx.GetHex());
+      *tx_string = CreateString(handle, tx.GetHex());
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
       ConfidentialTransactionContext tx(tx_hex_string);
       tx.SetTxOutValue(index, Amount(amount));
-      *tx_string = CreateString(tx.GetHex());
+      *tx_string = CreateString(handle, tx.GetHex());
 #else
       throw CfdException(
           CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
@@ -1605,12 +2028,12 @@ int CfdAddTxSign(
     if (is_bitcoin) {
       TransactionContext tx(tx_hex_string);
       tx.AddSign(outpoint, sign_list, is_witness, clear_stack);
-      *tx_string = CreateString(tx.GetHex());
+      *tx_string = CreateString(handle, tx.GetHex());
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
       ConfidentialTransactionContext tx(tx_hex_string);
       tx.AddSign(outpoint, sign_list, is_witness, clear_stack);
-      *tx_string = CreateString(tx.GetHex());
+      *tx_string = CreateString(handle, tx.GetHex());
 #else
       throw CfdException(
           CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
@@ -1685,12 +2108,12 @@ int CfdAddPubkeyHashSign(
     if (is_bitcoin) {
       TransactionContext tx(tx_hex_string);
       tx.AddPubkeyHashSign(outpoint, param, Pubkey(pubkey), addr_type);
-      *tx_string = CreateString(tx.GetHex());
+      *tx_string = CreateString(handle, tx.GetHex());
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
       ConfidentialTransactionContext tx(tx_hex_string);
       tx.AddPubkeyHashSign(outpoint, param, Pubkey(pubkey), addr_type);
-      *tx_string = CreateString(tx.GetHex());
+      *tx_string = CreateString(handle, tx.GetHex());
 #else
       throw CfdException(
           CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
@@ -1763,7 +2186,7 @@ int CfdAddScriptHashSign(
         }
       }
       tx.AddScriptHashSign(outpoint, list, script, addr_type);
-      *tx_string = CreateString(tx.GetHex());
+      *tx_string = CreateString(handle, tx.GetHex());
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
       ConfidentialTransactionContext tx(tx_hex_string);
@@ -1776,7 +2199,7 @@ int CfdAddScriptHashSign(
         }
       }
       tx.AddScriptHashSign(outpoint, list, script, addr_type);
-      *tx_string = CreateString(tx.GetHex());
+      *tx_string = CreateString(handle, tx.GetHex());
 #else
       throw CfdException(
           CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
@@ -1856,14 +2279,14 @@ int CfdAddSignWithPrivkeySimple(
       tx.SignWithPrivkeySimple(
           outpoint, Pubkey(pubkey), privkey_obj, sighashtype, value, addr_type,
           has_grind_r);
-      *tx_string = CreateString(tx.GetHex());
+      *tx_string = CreateString(handle, tx.GetHex());
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
       ConfidentialTransactionContext tx(tx_hex_string);
       tx.SignWithPrivkeySimple(
           outpoint, Pubkey(pubkey), privkey_obj, sighashtype, value, addr_type,
           has_grind_r);
-      *tx_string = CreateString(tx.GetHex());
+      *tx_string = CreateString(handle, tx.GetHex());
 #else
       throw CfdException(
           CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
@@ -2076,12 +2499,12 @@ int CfdFinalizeMultisigSign(
     if (is_bitcoin) {
       TransactionContext tx(tx_hex_string);
       tx.AddMultisigSign(outpoint, sign_list, script, addr_type);
-      *tx_string = CreateString(tx.GetHex());
+      *tx_string = CreateString(handle, tx.GetHex());
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
       ConfidentialTransactionContext tx(tx_hex_string);
       tx.AddMultisigSign(outpoint, sign_list, script, addr_type);
-      *tx_string = CreateString(tx.GetHex());
+      *tx_string = CreateString(handle, tx.GetHex());
 #else
       throw CfdException(
           CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
@@ -2413,7 +2836,7 @@ int CfdCreateSighash(
       }
     }
 
-    *sighash = CreateString(sighash_bytes.GetHex());
+    *sighash = CreateString(handle, sighash_bytes.GetHex());
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     return SetLastError(handle, except);
@@ -2445,15 +2868,17 @@ int CfdGetTxInfo(
     bool is_bitcoin = false;
     ConvertNetType(net_type, &is_bitcoin);
     if (is_bitcoin) {
-      TransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedTransaction(tx_hex_string);
+      const TransactionContext& tx = *cache_tx;
       GetTxInfo(
-          &tx, &work_txid, &work_wtxid, size, vsize, weight, version,
+          handle, &tx, &work_txid, &work_wtxid, size, vsize, weight, version,
           locktime);
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
-      ConfidentialTransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+      const ConfidentialTransactionContext& tx = *cache_tx;
       GetTxInfo(
-          &tx, &work_txid, &work_wtxid, size, vsize, weight, version,
+          handle, &tx, &work_txid, &work_wtxid, size, vsize, weight, version,
           locktime);
 #else
       throw CfdException(
@@ -2495,7 +2920,8 @@ int CfdGetTxIn(
     Txid temp_txid;
     Script temp_unlocking_script;
     if (is_bitcoin) {
-      TransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedTransaction(tx_hex_string);
+      const TransactionContext& tx = *cache_tx;
       const TxInReference ref = tx.GetTxIn(index);
       temp_txid = ref.GetTxid();
       temp_unlocking_script = ref.GetUnlockingScript();
@@ -2503,7 +2929,8 @@ int CfdGetTxIn(
       if (sequence != nullptr) *sequence = ref.GetSequence();
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
-      ConfidentialTransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+      const ConfidentialTransactionContext& tx = *cache_tx;
       const ConfidentialTxInReference ref = tx.GetTxIn(index);
       temp_txid = ref.GetTxid();
       temp_unlocking_script = ref.GetUnlockingScript();
@@ -2516,10 +2943,10 @@ int CfdGetTxIn(
     }
 
     if (txid != nullptr) {
-      work_txid = CreateString(temp_txid.GetHex());
+      work_txid = CreateString(handle, temp_txid.GetHex());
     }
     if (script_sig != nullptr) {
-      work_script_sig = CreateString(temp_unlocking_script.GetHex());
+      work_script_sig = CreateString(handle, temp_unlocking_script.GetHex());
     }
 
     if (work_txid != nullptr) *txid = work_txid;
@@ -2558,12 +2985,14 @@ int CfdGetTxInWitness(
     bool is_bitcoin = false;
     ConvertNetType(net_type, &is_bitcoin);
     if (is_bitcoin) {
-      TransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedTransaction(tx_hex_string);
+      const TransactionContext& tx = *cache_tx;
       const TxInReference ref = tx.GetTxIn(txin_index);
       witness_stack = ref.GetScriptWitness().GetWitness();
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
-      ConfidentialTransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+      const ConfidentialTransactionContext& tx = *cache_tx;
       const ConfidentialTxInReference ref = tx.GetTxIn(txin_index);
       witness_stack = ref.GetScriptWitness().GetWitness();
 #else
@@ -2578,7 +3007,7 @@ int CfdGetTxInWitness(
           CfdError::kCfdOutOfRangeError,
           "Failed to parameter. stackIndex out of witness stack.");
     }
-    *stack_data = CreateString(witness_stack[stack_index].GetHex());
+    *stack_data = CreateString(handle, witness_stack[stack_index].GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -2609,13 +3038,15 @@ int CfdGetTxOut(
     Amount temp_value;
     Script temp_locking_script;
     if (is_bitcoin) {
-      TransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedTransaction(tx_hex_string);
+      const TransactionContext& tx = *cache_tx;
       const TxOutReference ref = tx.GetTxOut(index);
       temp_value = ref.GetValue();
       temp_locking_script = ref.GetLockingScript();
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
-      ConfidentialTransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+      const ConfidentialTransactionContext& tx = *cache_tx;
       const ConfidentialTxOutReference ref = tx.GetTxOut(index);
       temp_value = ref.GetValue();
       temp_locking_script = ref.GetLockingScript();
@@ -2629,7 +3060,7 @@ int CfdGetTxOut(
       *value_satoshi = temp_value.GetSatoshiValue();
     }
     if (locking_script != nullptr) {
-      *locking_script = CreateString(temp_locking_script.GetHex());
+      *locking_script = CreateString(handle, temp_locking_script.GetHex());
     }
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -2657,11 +3088,13 @@ int CfdGetTxInCount(
     bool is_bitcoin = false;
     ConvertNetType(net_type, &is_bitcoin);
     if (is_bitcoin) {
-      TransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedTransaction(tx_hex_string);
+      const TransactionContext& tx = *cache_tx;
       if (count != nullptr) *count = tx.GetTxInCount();
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
-      ConfidentialTransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+      const ConfidentialTransactionContext& tx = *cache_tx;
       if (count != nullptr) *count = tx.GetTxInCount();
 #else
       throw CfdException(
@@ -2695,12 +3128,14 @@ int CfdGetTxInWitnessCount(
     bool is_bitcoin = false;
     ConvertNetType(net_type, &is_bitcoin);
     if (is_bitcoin) {
-      TransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedTransaction(tx_hex_string);
+      const TransactionContext& tx = *cache_tx;
       const TxInReference ref = tx.GetTxIn(txin_index);
       if (count != nullptr) *count = ref.GetScriptWitnessStackNum();
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
-      ConfidentialTransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+      const ConfidentialTransactionContext& tx = *cache_tx;
       const ConfidentialTxInReference ref = tx.GetTxIn(txin_index);
       if (count != nullptr) *count = ref.GetScriptWitnessStackNum();
 #else
@@ -2734,11 +3169,13 @@ int CfdGetTxOutCount(
     bool is_bitcoin = false;
     ConvertNetType(net_type, &is_bitcoin);
     if (is_bitcoin) {
-      TransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedTransaction(tx_hex_string);
+      const TransactionContext& tx = *cache_tx;
       if (count != nullptr) *count = tx.GetTxOutCount();
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
-      ConfidentialTransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+      const ConfidentialTransactionContext& tx = *cache_tx;
       if (count != nullptr) *count = tx.GetTxOutCount();
 #else
       throw CfdException(
@@ -2779,11 +3216,13 @@ int CfdGetTxInIndex(
     bool is_bitcoin = false;
     ConvertNetType(net_type, &is_bitcoin);
     if (is_bitcoin) {
-      TransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedTransaction(tx_hex_string);
+      const TransactionContext& tx = *cache_tx;
       if (index != nullptr) *index = tx.GetTxInIndex(outpoint);
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
-      ConfidentialTransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+      const ConfidentialTransactionContext& tx = *cache_tx;
       if (index != nullptr) *index = tx.GetTxInIndex(outpoint);
 #else
       throw CfdException(
@@ -2818,7 +3257,8 @@ int CfdGetTxOutIndex(
     bool is_bitcoin = false;
     ConvertNetType(net_type, &is_bitcoin);
     if (is_bitcoin) {
-      TransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedTransaction(tx_hex_string);
+      const TransactionContext& tx = *cache_tx;
       if (!IsEmptyString(direct_locking_script)) {
         is_find = tx.IsFindTxOut(Script(direct_locking_script), index);
       } else if (!IsEmptyString(address)) {
@@ -2829,7 +3269,8 @@ int CfdGetTxOutIndex(
       }
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
-      ConfidentialTransactionContext tx(tx_hex_string);
+      auto cache_tx = GetCachedConfidentialTransaction(tx_hex_string);
+      const ConfidentialTransactionContext& tx = *cache_tx;
       if (!IsEmptyString(direct_locking_script)) {
         is_find = tx.IsFindTxOut(Script(direct_locking_script), index);
       } else if (!IsEmptyString(address)) {
@@ -3288,7 +3729,7 @@ int CfdFinalizeFundRawTx(
           &option_params, buffer->append_txout_addresses, buffer->net_type,
           nullptr, &calc_fee);
       if (output_tx_hex != nullptr) {
-        *output_tx_hex = CreateString(ctxc.GetHex());
+        *output_tx_hex = CreateString(handle, ctxc.GetHex());
       }
 #endif  // CFD_DISABLE_ELEMENTS
     } else {
@@ -3304,7 +3745,7 @@ int CfdFinalizeFundRawTx(
           &option_params, buffer->append_txout_addresses, buffer->net_type,
           nullptr, &calc_fee);
       if (output_tx_hex != nullptr) {
-        *output_tx_hex = CreateString(txc.GetHex());
+        *output_tx_hex = CreateString(handle, txc.GetHex());
       }
     }
 
@@ -3352,7 +3793,8 @@ int CfdGetAppendTxOutFundRawTx(
           "Failed to parameter. target addresses is maximum over.");
     }
 
-    *append_address = CreateString(buffer->append_txout_addresses->at(index));
+    *append_address =
+        CreateString(handle, buffer->append_txout_addresses->at(index));
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
     result = SetLastError(handle, except);
@@ -3462,34 +3904,7 @@ int CfdInitializeTxDataHandle(
           "Failed to parameter. tx_hex is null or empty.");
     }
 
-    bool is_bitcoin = false;
-    ConvertNetType(net_type, &is_bitcoin);
-    if (!is_bitcoin) {
-#ifndef CFD_DISABLE_ELEMENTS
-      info(CFD_LOG_SOURCE, "net_type[{}]", net_type);
-#else
-      throw CfdException(
-          CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
-#endif  // CFD_DISABLE_ELEMENTS
-    }
-
-    buffer = static_cast<CfdCapiTransactionData*>(
-        AllocBuffer(kPrefixTransactionData, sizeof(CfdCapiTransactionData)));
-    buffer->net_type = net_type;
-    if (is_bitcoin) {
-      TransactionContext* tx =
-          new TransactionContext(std::string(tx_hex_string));
-      buffer->tx_obj = tx;
-    } else {
-#ifndef CFD_DISABLE_ELEMENTS
-      ConfidentialTransactionContext* tx =
-          new ConfidentialTransactionContext(std::string(tx_hex_string));
-      buffer->tx_obj = tx;
-#else
-      throw CfdException(
-          CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
-#endif  // CFD_DISABLE_ELEMENTS
-    }
+    CreateTxDataHandle(net_type, &buffer, std::string(tx_hex_string));
     *tx_data_handle = buffer;
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -3569,12 +3984,12 @@ int CfdGetModifiedTxByHandle(
     } else if (is_bitcoin) {
       TransactionContext* tx =
           static_cast<TransactionContext*>(tx_data->tx_obj);
-      *tx_hex_string = CreateString(tx->GetHex());
+      *tx_hex_string = CreateString(handle, tx->GetHex());
     } else {
 #ifndef CFD_DISABLE_ELEMENTS
       ConfidentialTransactionContext* tx =
           static_cast<ConfidentialTransactionContext*>(tx_data->tx_obj);
-      *tx_hex_string = CreateString(tx->GetHex());
+      *tx_hex_string = CreateString(handle, tx->GetHex());
 #else
       throw CfdException(
           CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
@@ -3592,6 +4007,67 @@ int CfdGetModifiedTxByHandle(
   return result;
 }
 
+int CfdInitializeTxDataHandleByBytes(
+    void* handle, int net_type, const uint8_t* tx_bytes, size_t tx_size,
+    void** tx_data_handle) {
+  int result = CfdErrorCode::kCfdUnknownError;
+  CfdCapiTransactionData* buffer = nullptr;
+  try {
+    cfd::Initialize();
+    if (tx_data_handle == nullptr) {
+      warn(CFD_LOG_SOURCE, "tx data handle is null.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError,
+          "Failed to parameter. tx data handle is null.");
+    }
+    if ((tx_bytes == nullptr) || (tx_size == 0)) {
+      warn(CFD_LOG_SOURCE, "tx_bytes is null or empty.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError,
+          "Failed to parameter. tx_bytes is null or empty.");
+    }
+
+    if (tx_size > std::numeric_limits<uint32_t>::max()) {
+      warn(CFD_LOG_SOURCE, "tx_size is too large.");
+      throw CfdException(
+          CfdError::kCfdOutOfRangeError,
+          "Failed to parameter. tx_size is too large.");
+    }
+
+    CreateTxDataHandle(
+        net_type, &buffer,
+        ByteData(tx_bytes, static_cast<uint32_t>(tx_size)));
+    *tx_data_handle = buffer;
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    result = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  CfdFreeTxDataHandle(handle, buffer);
+  return result;
+}
+
+int CfdGetModifiedTxBytesByHandle(
+    void* handle, void* tx_data_handle, uint8_t* tx_buffer, size_t buffer_size,
+    size_t* data_size) {
+  int result = CfdErrorCode::kCfdUnknownError;
+  try {
+    cfd::Initialize();
+    CopyTxDataHandleToBuffer(tx_data_handle, tx_buffer, buffer_size, data_size);
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    result = SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+  }
+  return result;
+}
+
 int CfdGetTxInfoByHandle(
     void* handle, void* tx_data_handle, char** txid, char** wtxid,
     uint32_t* size, uint32_t* vsize, uint32_t* weight, uint32_t* version,
@@ -3643,8 +4119,8 @@ int CfdGetTxInfoByHandle(
           CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
 #endif  // CFD_DISABLE_ELEMENTS
     }
-    if (txid != nullptr) work_txid = CreateString(temp_txid);
-    if (wtxid != nullptr) work_wtxid = CreateString(temp_wtxid);
+    if (txid != nullptr) work_txid = CreateString(handle, temp_txid);
+    if (wtxid != nullptr) work_wtxid = CreateString(handle, temp_wtxid);
     if (size != nullptr) *size = temp_size;
     if (vsize != nullptr) *vsize = temp_vsize;
     if (weight != nullptr) *weight = temp_weight;
@@ -3708,10 +4184,10 @@ int CfdGetTxInByHandle(
     }
 
     if (txid != nullptr) {
-      work_txid = CreateString(temp_txid.GetHex());
+      work_txid = CreateString(handle, temp_txid.GetHex());
     }
     if (script_sig != nullptr) {
-      work_script_sig = CreateString(temp_unlocking_script.GetHex());
+      work_script_sig = CreateString(handle, temp_unlocking_script.GetHex());
     }
 
     if (work_txid != nullptr) *txid = work_txid;
@@ -3785,7 +4261,7 @@ int CfdGetTxInWitnessByHandle(
           CfdError::kCfdOutOfRangeError,
           "Failed to parameter. stackIndex out of witness stack.");
     }
-    *stack_data = CreateString(witness_stack[stack_index].GetHex());
+    *stack_data = CreateString(handle, witness_stack[stack_index].GetHex());
 
     return CfdErrorCode::kCfdSuccess;
   } catch (const CfdException& except) {
@@ -3839,9 +4315,9 @@ int CfdGetTxOutByHandle(
     }
 
     if (locking_script != nullptr) {
-      work_script = CreateString(temp_locking_script.GetHex());
+      work_script = CreateString(handle, temp_locking_script.GetHex());
     }
-    if (asset != nullptr) work_asset = CreateString(temp_asset);
+    if (asset != nullptr) work_asset = CreateString(handle, temp_asset);
 
     if (value_satoshi != nullptr) {
       *value_satoshi = temp_value.GetSatoshiValue();
@@ -3860,6 +4336,211 @@ int CfdGetTxOutByHandle(
   return error_code;
 }
 
+int CfdGetTxInListByHandle(
+    void* handle, void* tx_data_handle, int stack_type,
+    CfdTxInData* txin_list, uint32_t txin_list_size,
+    CfdTxDataRange* witness_list, uint32_t witness_list_size, uint8_t* buffer,
+    size_t buffer_size, uint32_t* txin_count, uint32_t* witness_count,
+    size_t* data_size) {
+  try {
+    cfd::Initialize();
+    CheckBuffer(tx_data_handle, kPrefixTransactionData);
+    CfdCapiTransactionData* tx_data =
+        static_cast<CfdCapiTransactionData*>(tx_data_handle);
+    if ((stack_type != kCfdTxWitnessStackNormal) &&
+        (stack_type != kCfdTxWitnessStackPegin)) {
+      warn(CFD_LOG_SOURCE, "Invalid stack type[{}]", stack_type);
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "Invalid stack type.");
+    }
+
+    std::vector<CfdCapiTxInListItem> items;
+    bool is_bitcoin = false;
+    ConvertNetType(tx_data->net_type, &is_bitcoin);
+    if (tx_data->tx_obj == nullptr) {
+      throw CfdException(
+          CfdError::kCfdIllegalStateError, "Invalid handle state. tx is null");
+    } else if (is_bitcoin) {
+      if (stack_type != kCfdTxWitnessStackNormal) {
+        warn(CFD_LOG_SOURCE, "Invalid stack type[{}]", stack_type);
+        throw CfdException(
+            CfdError::kCfdIllegalArgumentError, "Invalid stack type.");
+      }
+      const TransactionContext* tx =
+          static_cast<TransactionContext*>(tx_data->tx_obj);
+      for (const auto& ref : tx->GetTxInList()) {
+        items.push_back(CfdCapiTxInListItem{
+            ref.GetTxid().GetData(), ref.GetVout(), ref.GetSequence(),
+            ref.GetUnlockingScript().GetData(),
+            ref.GetScriptWitness().GetWitness()});
+      }
+    } else {
+#ifndef CFD_DISABLE_ELEMENTS
+      const ConfidentialTransactionContext* tx =
+          static_cast<ConfidentialTransactionContext*>(tx_data->tx_obj);
+      for (const auto& ref : tx->GetTxInList()) {
+        items.push_back(CfdCapiTxInListItem{
+            ref.GetTxid().GetData(), ref.GetVout(), ref.GetSequence(),
+            ref.GetUnlockingScript().GetData(),
+            (stack_type == kCfdTxWitnessStackPegin)
+                ? ref.GetPeginWitness().GetWitness()
+                : ref.GetScriptWitness().GetWitness()});
+      }
+#else
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
+#endif  // CFD_DISABLE_ELEMENTS
+    }
+
+    uint32_t temp_witness_count = 0;
+    size_t temp_data_size = 0;
+    for (const auto& item : items) {
+      temp_witness_count += static_cast<uint32_t>(item.witness.size());
+      temp_data_size += item.script_sig.GetDataSize();
+      for (const auto& stack : item.witness) {
+        temp_data_size += stack.GetDataSize();
+      }
+    }
+    uint32_t temp_txin_count = static_cast<uint32_t>(items.size());
+    if (txin_count != nullptr) *txin_count = temp_txin_count;
+    if (witness_count != nullptr) *witness_count = temp_witness_count;
+    if (data_size != nullptr) *data_size = temp_data_size;
+    if ((txin_list == nullptr) && (witness_list == nullptr) &&
+        (buffer == nullptr)) {
+      return CfdErrorCode::kCfdSuccess;
+    }
+    CheckTxListCapacity(
+        "txin_list", txin_list == nullptr, txin_list_size, temp_txin_count);
+    CheckTxListCapacity(
+        "witness_list", witness_list == nullptr, witness_list_size,
+        temp_witness_count);
+    CheckTxListCapacity(
+        "buffer", buffer == nullptr, buffer_size, temp_data_size);
+
+    size_t offset = 0;
+    uint32_t witness_index = 0;
+    for (uint32_t index = 0; index < temp_txin_count; ++index) {
+      const auto& item = items[index];
+      CfdTxInData* txin = &txin_list[index];
+      const std::vector<uint8_t> txid_bytes = item.txid.GetBytes();
+      memcpy(txin->txid, txid_bytes.data(), sizeof(txin->txid));
+      txin->vout = item.vout;
+      txin->sequence = item.sequence;
+      CfdTxDataRange range;
+      CopyToTxDataBuffer(item.script_sig, buffer, &offset, &range);
+      txin->script_sig_offset = range.offset;
+      txin->script_sig_size = range.size;
+      txin->witness_index = witness_index;
+      txin->witness_count = static_cast<uint32_t>(item.witness.size());
+      for (const auto& stack : item.witness) {
+        CopyToTxDataBuffer(
+            stack, buffer, &offset, &witness_list[witness_index]);
+        ++witness_index;
+      }
+    }
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    return SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+    return CfdErrorCode::kCfdUnknownError;
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+    return CfdErrorCode::kCfdUnknownError;
+  }
+}
+
+int CfdGetTxOutListByHandle(
+    void* handle, void* tx_data_handle, CfdTxOutData* txout_list,
+    uint32_t txout_list_size, uint8_t* buffer, size_t buffer_size,
+    uint32_t* txout_count, size_t* data_size) {
+  try {
+    cfd::Initialize();
+    CheckBuffer(tx_data_handle, kPrefixTransactionData);
+    CfdCapiTransactionData* tx_data =
+        static_cast<CfdCapiTransactionData*>(tx_data_handle);
+
+    std::vector<Amount> values;
+    std::vector<ByteData> scripts;
+    std::vector<ByteData> assets;
+    std::vector<ByteData> commitments;
+    std::vector<ByteData> nonces;
+    bool is_bitcoin = false;
+    ConvertNetType(tx_data->net_type, &is_bitcoin);
+    if (tx_data->tx_obj == nullptr) {
+      throw CfdException(
+          CfdError::kCfdIllegalStateError, "Invalid handle state. tx is null");
+    } else if (is_bitcoin) {
+      const TransactionContext* tx =
+          static_cast<TransactionContext*>(tx_data->tx_obj);
+      for (const auto& ref : tx->GetTxOutList()) {
+        values.push_back(ref.GetValue());
+        scripts.push_back(ref.GetLockingScript().GetData());
+        assets.push_back(ByteData());
+        commitments.push_back(ByteData());
+        nonces.push_back(ByteData());
+      }
+    } else {
+#ifndef CFD_DISABLE_ELEMENTS
+      const ConfidentialTransactionContext* tx =
+          static_cast<ConfidentialTransactionContext*>(tx_data->tx_obj);
+      for (const auto& ref : tx->GetTxOutList()) {
+        const ConfidentialValue& value = ref.GetConfidentialValue();
+        values.push_back(ref.GetValue());
+        scripts.push_back(ref.GetLockingScript().GetData());
+        assets.push_back(ref.GetAsset().GetData());
+        commitments.push_back(
+            (value.HasBlinding()) ? value.GetData() : ByteData());
+        nonces.push_back(ref.GetNonce().GetData());
+      }
+#else
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "Elements is not supported.");
+#endif  // CFD_DISABLE_ELEMENTS
+    }
+
+    size_t temp_data_size = 0;
+    for (const auto& script : scripts) {
+      temp_data_size += script.GetDataSize();
+    }
+    uint32_t temp_txout_count = static_cast<uint32_t>(scripts.size());
+    if (txout_count != nullptr) *txout_count = temp_txout_count;
+    if (data_size != nullptr) *data_size = temp_data_size;
+    if ((txout_list == nullptr) && (buffer == nullptr)) {
+      return CfdErrorCode::kCfdSuccess;
+    }
+    CheckTxListCapacity(
+        "txout_list", txout_list == nullptr, txout_list_size,
+        temp_txout_count);
+    CheckTxListCapacity(
+        "buffer", buffer == nullptr, buffer_size, temp_data_size);
+
+    size_t offset = 0;
+    for (uint32_t index = 0; index < temp_txout_count; ++index) {
+      CfdTxOutData* txout = &txout_list[index];
+      txout->value_satoshi = values[index].GetSatoshiValue();
+      CopyTxOutFixedData(assets[index], txout->asset, sizeof(txout->asset));
+      CopyTxOutFixedData(
+          commitments[index], txout->value_commitment,
+          sizeof(txout->value_commitment));
+      CopyTxOutFixedData(nonces[index], txout->nonce, sizeof(txout->nonce));
+      CfdTxDataRange range;
+      CopyToTxDataBuffer(scripts[index], buffer, &offset, &range);
+      txout->locking_script_offset = range.offset;
+      txout->locking_script_size = range.size;
+    }
+    return CfdErrorCode::kCfdSuccess;
+  } catch (const CfdException& except) {
+    return SetLastError(handle, except);
+  } catch (const std::exception& std_except) {
+    SetLastFatalError(handle, std_except.what());
+    return CfdErrorCode::kCfdUnknownError;
+  } catch (...) {
+    SetLastFatalError(handle, "unknown error.");
+    return CfdErrorCode::kCfdUnknownError;
+  }
+}
+
 int CfdGetTxInCountByHandle(
     void* handle, void* tx_data_handle, uint32_t* count) {
   try {
@@ -10,12 +10,14 @@
 
 #include <algorithm>
 #include <map>
+#include <mutex>  // NOLINT
 #include <string>
 #include <vector>
 
 #include "cfd/cfd_address.h"
 #include "cfd/cfd_elements_address.h"
 #include "cfd/cfd_fee.h"
+#include "cfd/cfd_utxo.h"
 #include "cfd_transaction_internal.h"  // NOLINT
 #include "cfdcore/cfdcore_address.h"
 #include "cfdcore/cfdcore_amount.h"
@@ -28,9 +30,11 @@
 #include "cfdcore/cfdcore_transaction.h"
 #include "cfdcore/cfdcore_transaction_common.h"
 #include "cfdcore/cfdcore_util.h"
+#include "wally_transaction.h"  // NOLINT
 
 namespace cfd {
 using cfd::core::Address;
+using cfd::core::AddressFormatData;
 using cfd::core::AddressType;
 using cfd::core::Amount;
 using cfd::core::BlindData;
@@ -44,6 +48,7 @@ using cfd::core::CfdException;
 using cfd::core::ConfidentialAssetId;
 using cfd::core::ConfidentialNonce;
 using cfd::core::ConfidentialTransaction;
+using cfd::core::ConfidentialTxIn;
 using cfd::core::ConfidentialTxInReference;
 using cfd::core::ConfidentialTxOutReference;
 using cfd::core::ConfidentialValue;
@@ -66,6 +71,7 @@ using cfd::core::SigHashType;
 using cfd::core::SignatureUtil;
 using cfd::core::Txid;
 using cfd::core::UnblindParameter;
+using cfd::core::logger::info;
 using cfd::core::logger::warn;
 
 // -----------------------------------------------------------------------------
@@ -114,6 +120,618 @@ static ByteData256 CreateConfidentialTxSighash(
     const Script&, WitnessVersion)> create_sighash_func;
 */
 
+/**
+ * @brief estimate a fee amount from the transaction context.
+ * @details The fee txout is estimated as it is set on the transaction.
+ * @param[in] txc                   confidential transaction context
+ * @param[in] utxos                 using utxo data
+ * @param[in] fee_asset             fee asset
+ * @param[out] txout_fee            tx fee amount (ignore utxo)
+ * @param[out] utxo_fee             utxo fee amount
+ * @param[in] is_blind              blinding flag
+ * @param[in] effective_fee_rate    effective fee rate (minimum)
+ * @param[in] exponent              rangeproof exponent value.
+ * @param[in] minimum_bits          rangeproof blinding bits.
+ * @param[in] append_asset_count    append asset count
+ * @return tx fee (contains utxo)
+ */
+static Amount EstimateFeeByContext(
+    const ConfidentialTransactionContext& txc,
+    const std::vector<ElementsUtxoAndOption>& utxos,
+    const ConfidentialAssetId& fee_asset, Amount* txout_fee, Amount* utxo_fee,
+    bool is_blind, uint64_t effective_fee_rate, int exponent, int minimum_bits,
+    uint32_t* append_asset_count = nullptr) {
+  if (fee_asset.IsEmpty()) {
+    warn(CFD_LOG_SOURCE, "Failed to EstimateFee. Empty fee asset.");
+    throw CfdException(CfdError::kCfdIllegalArgumentError, "Empty fee asset.");
+  }
+
+  // check fee in txout
+  for (const auto& txout : txc.GetTxOutList()) {
+    if (txout.GetLockingScript().IsEmpty()) {
+      if (txout.GetAsset().GetHex() != fee_asset.GetHex()) {
+        warn(CFD_LOG_SOURCE, "Failed to EstimateFee. Unmatch fee asset.");
+        throw CfdException(
+            CfdError::kCfdIllegalArgumentError, "Unmatch fee asset.");
+      }
+      break;
+    }
+  }
+
+  uint32_t size = 0;
+  uint32_t witness_size = 0;
+  uint32_t wit_size = 0;
+  uint32_t txin_size = 0;
+  uint32_t rangeproof_size_cache = 0;
+  uint32_t asset_count = 0;
+  uint32_t not_witness_count = 0;
+  for (const auto& utxo : utxos) {
+    NetType net_type = NetType::kLiquidV1;
+    if (!utxo.utxo.address.GetAddress().empty()) {
+      net_type = utxo.utxo.address.GetNetType();
+    }
+    ElementsAddressFactory factory(net_type);
+
+    uint32_t pegin_btc_tx_size = 0;
+    uint32_t pegin_txoutproof_size = 0;
+    txin_size = 0;
+    wit_size = 0;
+    Script claim_script;
+    if (utxo.is_pegin) {
+      pegin_btc_tx_size = utxo.pegin_btc_tx_size;
+      pegin_txoutproof_size = utxo.pegin_txoutproof_size;
+      claim_script = utxo.claim_script;
+    }
+    // check descriptor
+    std::string descriptor = utxo.utxo.descriptor;
+    // set dummy NetType for getting AddressType.
+    auto data = factory.ParseOutputDescriptor(descriptor, "");
+
+    AddressType addr_type;
+    if (utxo.utxo.address.GetAddress().empty() ||
+        data.address_type == AddressType::kP2shP2wpkhAddress ||
+        data.address_type == AddressType::kP2shP2wshAddress) {
+      addr_type = data.address_type;
+    } else {
+      addr_type = utxo.utxo.address.GetAddressType();
+    }
+
+    Script redeem_script;
+    if (utxo.utxo.redeem_script.IsEmpty() && !data.redeem_script.IsEmpty()) {
+      redeem_script = data.redeem_script;
+    } else {
+      redeem_script = utxo.utxo.redeem_script;
+    }
+    const Script* scriptsig_template = nullptr;
+    if ((!redeem_script.IsEmpty()) &&
+        (!utxo.utxo.scriptsig_template.IsEmpty())) {
+      scriptsig_template = &utxo.utxo.scriptsig_template;
+    }
+    bool is_issuance = utxo.is_issuance;
+    bool is_reissuance = false;
+    bool is_blind_issuance = utxo.is_blind_issuance;
+    try {
+      auto ref = txc.GetTxIn(OutPoint(utxo.utxo.txid, utxo.utxo.vout));
+      if (utxo.is_issuance) {
+        if ((!ref.GetAssetEntropy().IsEmpty()) &&
+            (!ref.GetBlindingNonce().IsEmpty())) {
+          is_reissuance = true;
+        }
+      } else if ((!utxo.is_issuance) && (!utxo.is_blind_issuance)) {  // init
+        if (!ref.GetAssetEntropy().IsEmpty()) {
+          is_issuance = true;
+          is_blind_issuance = is_blind;
+          if (!ref.GetBlindingNonce().IsEmpty()) {
+            is_reissuance = true;
+            is_blind_issuance = true;
+          }
+        }
+      }
+      if (ref.GetPeginWitnessStackNum() >= 6) {
+        std::vector<ByteData> pegin_stack = ref.GetPeginWitness().GetWitness();
+        pegin_btc_tx_size =
+            static_cast<uint32_t>(pegin_stack[4].GetDataSize());
+        pegin_txoutproof_size =
+            static_cast<uint32_t>(pegin_stack[5].GetDataSize());
+        claim_script = Script(pegin_stack[3]);
+      }
+
+      if (utxo.is_issuance && ref.GetAssetEntropy().IsEmpty()) {
+        // unmatch pattern. (using input utxo data)
+      } else if (utxo.is_pegin && (ref.GetPeginWitnessStackNum() < 6)) {
+        // unmatch pattern. (using input utxo data)
+      } else {
+        ref.EstimateTxInSize(
+            addr_type, redeem_script, is_blind_issuance, exponent,
+            minimum_bits, claim_script, scriptsig_template, &wit_size,
+            &txin_size);
+      }
+    } catch (const CfdException& except) {
+      info(CFD_LOG_SOURCE, "Error:{}", std::string(except.what()));
+    }
+
+    if (is_reissuance)
+      ++asset_count;
+    else if (is_issuance)
+      asset_count += 2;
+
+    ++asset_count;
+    if (txin_size == 0) {
+      ConfidentialTxIn::EstimateTxInSize(
+          addr_type, redeem_script, pegin_btc_tx_size, claim_script,
+          is_issuance, is_blind_issuance, &wit_size, &txin_size, is_reissuance,
+          scriptsig_template, exponent, minimum_bits, &rangeproof_size_cache,
+          pegin_txoutproof_size);
+    }
+    size += txin_size;
+    witness_size += wit_size;
+    if (wit_size == 0) ++not_witness_count;
+  }
+  if ((witness_size != 0) && (not_witness_count != 0) &&
+      (not_witness_count < static_cast<uint32_t>(utxos.size()))) {
+    // append witness size for p2pkh or p2sh
+    witness_size += not_witness_count * 4;
+  }
+
+  uint32_t utxo_vsize =
+      AbstractTransaction::GetVsizeFromSize(size, witness_size);
+
+  uint32_t tx_witness_size = 0;
+  uint32_t tx_size = 0;
+  if (append_asset_count != nullptr) {
+    if ((asset_count + *append_asset_count) < 255) {
+      asset_count += *append_asset_count;
+    } else {
+      asset_count = 255;
+    }
+  }
+  txc.GetSizeIgnoreTxIn(
+      is_blind, &tx_witness_size, &tx_size, exponent, minimum_bits,
+      asset_count);
+  uint32_t tx_vsize =
+      AbstractTransaction::GetVsizeFromSize(tx_size, tx_witness_size);
+
+  FeeCalculator fee_calc(effective_fee_rate);
+  Amount tx_fee_amount = fee_calc.GetFee(tx_vsize);
+  Amount utxo_fee_amount = fee_calc.GetFee(utxo_vsize);
+  uint32_t total_vsize = AbstractTransaction::GetVsizeFromSize(
+      tx_size + size, tx_witness_size + witness_size);
+  Amount fee = fee_calc.GetFee(total_vsize);
+
+  if (txout_fee) *txout_fee = tx_fee_amount;
+  if (utxo_fee) *utxo_fee = utxo_fee_amount;
+
+  info(
+      CFD_LOG_SOURCE, "EstimateFee rate={} fee={} tx={} utxo={}",
+      effective_fee_rate, fee.GetSatoshiValue(),
+      tx_fee_amount.GetSatoshiValue(), utxo_fee_amount.GetSatoshiValue());
+  return fee;
+}
+
+/**
+ * @brief collect utxo data by fundrawtransaction.
+ * @param[in] ctx                  confidential transaction context
+ * @param[in] selected_txin_utxos  txin utxo list
+ * @param[out] txin_amount_map     txin amount map
+ * @param[out] tx_amount_map       tx amount map
+ * @param[out] asset_list          target asset list
+ * @param[out] fee_index           fee index
+ */
+static void CollectUtxoDataByFundRawTransaction(
+    const ConfidentialTransactionContext& ctx,
+    const std::vector<ElementsUtxoAndOption>& selected_txin_utxos,
+    std::map<std::string, int64_t>* txin_amount_map,
+    std::map<std::string, int64_t>* tx_amount_map,
+    std::vector<std::string>* asset_list, int32_t* fee_index) {
+  const auto txout_list = ctx.GetTxOutList();
+  for (size_t index = 0; index < txout_list.size(); ++index) {
+    auto& txout = txout_list[index];
+    if (txout.GetLockingScript().IsEmpty()) {
+      // Excludes fees from collection
+      *fee_index = static_cast<int32_t>(index);
+    } else {
+      std::string asset = txout.GetAsset().GetHex();
+      if (std::find(asset_list->begin(), asset_list->end(), asset) ==
+          asset_list->end()) {
+        asset_list->push_back(asset);
+      }
+
+      if (tx_amount_map->find(asset) == tx_amount_map->end()) {
+        int64_t amount = 0;
+        tx_amount_map->emplace(asset, amount);
+      }
+      (*tx_amount_map)[asset] +=
+          txout.GetConfidentialValue().GetAmount().GetSatoshiValue();
+    }
+  }
+  std::map<std::string, std::vector<OutPoint>> asset_utxo_map;
+  const auto txin_list = ctx.GetTxInList();  // txin_utxo_list
+  for (const auto& elements_utxo : selected_txin_utxos) {
+    OutPoint utxo_outpoint(elements_utxo.utxo.txid, elements_utxo.utxo.vout);
+    if (!ctx.IsFindTxIn(utxo_outpoint)) continue;
+    std::string asset = elements_utxo.utxo.asset.GetHex();
+    if (std::find(asset_list->begin(), asset_list->end(), asset) ==
+        asset_list->end()) {
+      asset_list->push_back(asset);
+    }
+    if (asset_utxo_map.find(asset) == asset_utxo_map.end()) {
+      std::vector<OutPoint> outpoint_list = {
+          OutPoint(elements_utxo.utxo.txid, elements_utxo.utxo.vout)};
+      asset_utxo_map[asset] = outpoint_list;
+    } else {
+      OutPoint outpoint(elements_utxo.utxo.txid, elements_utxo.utxo.vout);
+      asset_utxo_map[asset].push_back(outpoint);
+    }
+
+    if (txin_amount_map->find(asset) == txin_amount_map->end()) {
+      int64_t amount = 0;
+      txin_amount_map->emplace(asset, amount);
+    }
+    (*txin_amount_map)[asset] +=
+        elements_utxo.utxo.amount.GetSatoshiValue();
+  }
+
+  // append issuance txin data.
+  for (const auto& txin : txin_list) {
+    if (!txin.GetBlindingNonce().IsEmpty() ||
+        !txin.GetAssetEntropy().IsEmpty()) {
+      BlindFactor asset_entropy;
+      std::string token;
+      if (txin.GetBlindingNonce().IsEmpty()) {
+        asset_entropy = ConfidentialTransaction::CalculateAssetEntropy(
+            txin.GetTxid(), txin.GetVout(), txin.GetAssetEntropy());
+        ConfidentialAssetId token1 =
+            ConfidentialTransaction::CalculateReissuanceToken(
+                asset_entropy, true);
+        ConfidentialAssetId token2 =
+            ConfidentialTransaction::CalculateReissuanceToken(
+                asset_entropy, false);
+        std::string token_blind = token1.GetHex();
+        std::string token_unblind = token2.GetHex();
+        if (tx_amount_map->find(token_blind) != tx_amount_map->end()) {
+          token = token_blind;
+        } else if (
+            tx_amount_map->find(token_unblind) != tx_amount_map->end()) {
+          token = token_unblind;
+        }
+      } else {
+        asset_entropy = BlindFactor(txin.GetAssetEntropy());
+      }
+      ConfidentialAssetId asset_id =
+          ConfidentialTransaction::CalculateAsset(asset_entropy);
+      std::string asset = asset_id.GetHex();
+
+      if (txin.GetBlindingNonce().IsEmpty()) {
+        // At the time of issuance, add to map if it is not registered.
+        if (txin_amount_map->find(asset) == txin_amount_map->end()) {
+          txin_amount_map->emplace(
+              asset, txin.GetIssuanceAmount().GetAmount().GetSatoshiValue());
+        }
+        if ((!token.empty()) &&
+            (txin_amount_map->find(token) == txin_amount_map->end())) {
+          txin_amount_map->emplace(
+              token, txin.GetInflationKeys().GetAmount().GetSatoshiValue());
+        }
+      } else if (txin_amount_map->find(asset) == txin_amount_map->end()) {
+        // At the time of reissuance, add to map if it is not registered asset.
+        txin_amount_map->emplace(
+            asset, txin.GetIssuanceAmount().GetAmount().GetSatoshiValue());
+      } else {
+        // At the time of reissuance,
+        // add to map if it is not registered asset of utxo.
+        OutPoint outpoint(txin.GetTxid(), txin.GetVout());
+        std::vector<OutPoint>& outpoint_list = asset_utxo_map[asset];
+        if (std::find(outpoint_list.begin(), outpoint_list.end(), outpoint) ==
+            outpoint_list.end()) {
+          (*txin_amount_map)[asset] +=
+              txin.GetIssuanceAmount().GetAmount().GetSatoshiValue();
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief calculate fee and fund transaction.
+ * @param[in] addr_factory              address factory object
+ * @param[in] txin_amount_map           txin amount map
+ * @param[in] tx_amount_map             tx amount map
+ * @param[in] target_values             target amounts
+ * @param[in] input_max_map             input max amount map
+ * @param[in] selected_coins            select utxo list
+ * @param[in] utxodata_list             utxo list
+ * @param[in] fee_asset                 fee asset
+ * @param[in] selected_txin_utxos       txin utxo list
+ * @param[in] reserve_txout_address     reserved address with asset
+ * @param[in] net_type                  network type
+ * @param[in] is_blind_estimate_fee     blind estimete fee flag
+ * @param[in] utxo_filter               utxo filter
+ * @param[in] option                    coin selection option
+ * @param[in] utxo_list                 utxo list
+ * @param[in] utxo_fee_map              utxo fee map
+ * @param[in,out] ctxc                  confidential transaction context
+ * @param[out] append_txout_addresses   append txout address list
+ * @param[out] estimate_fee             estimate fee
+ * @param[out] calculate_fee            calculate fee
+ */
+static void CalculateFeeAndFundTransaction(
+    const ElementsAddressFactory& addr_factory,
+    const std::map<std::string, int64_t>& txin_amount_map,
+    const std::map<std::string, int64_t>& tx_amount_map,
+    const std::map<std::string, int64_t>& target_values,
+    const std::map<std::string, int64_t>& input_max_map,
+    const std::vector<Utxo>& selected_coins,
+    const std::vector<UtxoData>& utxodata_list,
+    const ConfidentialAssetId& fee_asset,
+    const std::vector<ElementsUtxoAndOption>& selected_txin_utxos,
+    const std::map<std::string, std::string>& reserve_txout_address,
+    NetType net_type, bool is_blind_estimate_fee,
+    const UtxoFilter& utxo_filter, const CoinSelectionOption& option,
+    const std::vector<Utxo>& utxo_list,
+    const std::map<std::string, int64_t>& utxo_fee_map,
+    ConfidentialTransactionContext* ctxc,
+    std::vector<std::string>* append_txout_addresses, Amount* estimate_fee,
+    Amount* calculate_fee) {
+  std::string fee_asset_str = fee_asset.GetHex();
+  uint8_t fee_asset_bytes[33];
+  memcpy(
+      fee_asset_bytes, fee_asset.GetData().GetBytes().data(),
+      sizeof(fee_asset_bytes));
+  int exponent = 0;
+  int minimum_bits = 0;
+  option.GetBlindInfo(&exponent, &minimum_bits);
+  std::vector<uint8_t> txid_bytes(cfd::core::kByteData256Length);
+  std::string address_str;
+  if (reserve_txout_address.find(fee_asset_str) !=
+      reserve_txout_address.end()) {
+    address_str = reserve_txout_address.at(fee_asset_str);
+  }
+  Address address;
+  if (address_str.empty()) {
+    warn(
+        CFD_LOG_SOURCE,
+        "Failed to FundRawTransaction. fee reserve address not set.");
+    // throw CfdException(
+    //     CfdError::kCfdIllegalArgumentError,
+    //     "Failed to FundRawTransaction. fee reserve address not set.");
+  } else {
+    if (ElementsConfidentialAddress::IsConfidentialAddress(address_str)) {
+      address = addr_factory.GetConfidentialAddress(address_str)
+                    .GetUnblindedAddress();
+    } else {
+      address = addr_factory.GetAddress(address_str);
+    }
+    if (!addr_factory.CheckAddressNetType(address, net_type)) {
+      warn(
+          CFD_LOG_SOURCE,
+          "Failed to FundRawTransaction. "
+          "Input address and network is unmatch."
+          ": address=[{}], input_net_type=[{}], parsed_net_type=[{}]",
+          address_str, net_type, address.GetNetType());
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError,
+          "Failed to FundRawTransaction. "
+          "Input address and network is unmatch.");
+    }
+  }
+
+  int64_t txin_amount = 0;
+  int64_t tx_amount = 0;
+  int64_t target_value = 0;
+  // int64_t utxo_value = 0;
+  int64_t max_utxo_value = 0;
+  if (txin_amount_map.find(fee_asset_str) != txin_amount_map.end())
+    txin_amount = txin_amount_map.at(fee_asset_str);
+  if (tx_amount_map.find(fee_asset_str) != tx_amount_map.end())
+    tx_amount = tx_amount_map.at(fee_asset_str);
+  if (target_values.find(fee_asset_str) != target_values.end())
+    target_value = target_values.at(fee_asset_str);
+  if (input_max_map.find(fee_asset_str) != input_max_map.end())
+    max_utxo_value = input_max_map.at(fee_asset_str);
+
+  int64_t min_fee;
+  uint32_t dummy_txout_index = 0;
+  std::vector<ElementsUtxoAndOption> new_selected_utxos;
+  std::vector<ElementsUtxoAndOption> new_selected_utxos_not_lbtc;
+  // Reset the selected UTXO information to the Utxo class for Elements to recalculate the fee. // NOLINT
+  new_selected_utxos = selected_txin_utxos;
+  new_selected_utxos_not_lbtc = selected_txin_utxos;
+  std::map<OutPoint, const UtxoData*> utxo_map;
+  for (const UtxoData& utxo : utxodata_list) {
+    utxo_map.emplace(OutPoint(utxo.txid, utxo.vout), &utxo);
+  }
+  for (const auto& coin : selected_coins) {
+    memcpy(txid_bytes.data(), coin.txid, txid_bytes.size());
+    auto ite =
+        utxo_map.find(OutPoint(Txid(ByteData256(txid_bytes)), coin.vout));
+    if (ite == utxo_map.end()) continue;
+    ElementsUtxoAndOption utxo_data = {};
+    utxo_data.utxo = *ite->second;
+    new_selected_utxos.push_back(utxo_data);
+    if (utxo_data.utxo.asset.GetHex() != fee_asset_str) {
+      new_selected_utxos_not_lbtc.push_back(utxo_data);
+    }
+  }
+
+  uint64_t utxo_total_amount = 0;
+  for (const UtxoData& utxo : utxodata_list) {
+    uint64_t temp_amount = utxo.amount.GetSatoshiValue();
+    if (utxo.asset.GetHex() == fee_asset_str) {
+      utxo_total_amount += temp_amount;
+    }
+  }
+
+  Amount min_fee_amount = EstimateFeeByContext(
+      *ctxc, new_selected_utxos, fee_asset, nullptr, nullptr,
+      is_blind_estimate_fee, option.GetEffectiveFeeBaserate(), exponent,
+      minimum_bits);
+  min_fee = min_fee_amount.GetSatoshiValue();
+  int64_t dummy_sat = (txin_amount < tx_amount) ? tx_amount - txin_amount : 0;
+  dummy_sat += target_value + (min_fee * 2);
+  dummy_sat = 2 * ((max_utxo_value > dummy_sat) ? max_utxo_value : dummy_sat);
+  if ((dummy_sat <= 0) || (dummy_sat > cfd::core::kMaxAmount))
+    dummy_sat = cfd::core::kMaxAmount;
+  warn(CFD_LOG_SOURCE, "Set dummy_amount={}", dummy_sat);
+
+  int64_t dust_amount = 0;
+  if (!address_str.empty()) {
+    dust_amount =
+        option.GetConfidentialDustFeeAmount(address).GetSatoshiValue();
+  }
+  Amount max_fee = min_fee_amount;
+  volatile int64_t fee_value = 0;
+  Amount fee;
+  bool append_dummy_txout = false;
+  uint64_t input_total = utxo_total_amount + txin_amount;
+  uint64_t output_total = tx_amount + target_value + dust_amount;
+  if (address_str.empty() || (input_total < output_total)) {
+    // do not add dummy amount
+    max_fee = min_fee_amount;
+    fee_value = min_fee;
+  } else {
+    // The dummy txout is removed after the fee calculation.
+    append_dummy_txout = true;
+    dummy_txout_index = ctxc->GetTxOutCount();
+    ctxc->AddTxOut(
+        address, Amount(dummy_sat), ConfidentialAssetId(fee_asset_str));
+    fee = EstimateFeeByContext(
+        *ctxc, new_selected_utxos, fee_asset, nullptr, nullptr,
+        is_blind_estimate_fee, option.GetEffectiveFeeBaserate(), exponent,
+        minimum_bits);
+    fee_value = fee.GetSatoshiValue();
+  }
+  uint32_t append_utxo_count = static_cast<uint32_t>(utxo_list.size());
+  if (new_selected_utxos.size() > selected_txin_utxos.size()) {
+    auto diff_val = new_selected_utxos.size() - selected_txin_utxos.size();
+    append_utxo_count -= static_cast<uint32_t>(diff_val);
+  }
+  max_fee = EstimateFeeByContext(
+      *ctxc, new_selected_utxos, fee_asset, nullptr, nullptr,
+      is_blind_estimate_fee, option.GetEffectiveFeeBaserate(), exponent,
+      minimum_bits, &append_utxo_count);
+
+  int64_t fee_asset_target_value = target_value + fee.GetSatoshiValue();
+  bool use_coinselect = false;
+  if (txin_amount > tx_amount) {
+    int64_t check_min_fee = dust_amount + min_fee;
+    int64_t diff_amount = txin_amount - tx_amount;
+    if ((target_value == 0) && (diff_amount > min_fee) &&
+        (diff_amount < check_min_fee)) {
+      // If the existing UTXO is filled, there is no need to select coin and add TxOut. // NOLINT
+      fee_asset_target_value = 0;
+      fee = Amount(min_fee);
+      fee_value = min_fee;
+      info(CFD_LOG_SOURCE, "use minimum fee[{}]", fee.GetSatoshiValue());
+    } else if (diff_amount >= fee_asset_target_value) {
+      fee_asset_target_value = 0;
+    } else {
+      // If the surplus of txin does not meet the target, coin select the shortfall. // NOLINT
+      fee_asset_target_value = target_value - diff_amount;
+      use_coinselect = true;
+    }
+  } else {
+    // Select coins according to the shortage of txout.
+    fee_asset_target_value = target_value + tx_amount - txin_amount;
+    use_coinselect = true;
+  }
+
+  std::vector<Utxo> fee_selected_coins;
+  // re-select coin (fee asset only). collect amount is using large-fee.
+  std::map<std::string, int64_t> new_amount_map;
+  int64_t fee_selected_value = 0;
+  int64_t append_fee_asset_txout_value;
+  if (use_coinselect) {
+    CoinSelection coin_select;
+    Amount calc_fee = max_fee;
+    fee_value = max_fee.GetSatoshiValue();
+    Amount utxo_fee;
+    std::map<std::string, int64_t> new_target_values;
+    new_target_values.emplace(fee_asset_str, fee_asset_target_value);
+    if (utxo_fee_map.find(fee_asset_str) != utxo_fee_map.end()) {
+      int64_t past_utxo_fee = utxo_fee_map.at(fee_asset_str);
+      fee_value -= past_utxo_fee;
+      calc_fee = Amount(fee_value);
+    }
+    fee_selected_coins = coin_select.SelectCoins(
+        new_target_values, utxo_list, utxo_filter, option, calc_fee,
+        &new_amount_map, &utxo_fee, nullptr);
+    // append txout for fee asset
+    for (auto itr = new_amount_map.begin(); itr != new_amount_map.end();
+         ++itr) {
+      if (itr->first == fee_asset_str) {
+        fee_selected_value = itr->second;
+        break;
+      }
+    }
+    // re-calculate utxo list
+    std::vector<ElementsUtxoAndOption> new_selected_utxos2;
+    new_selected_utxos2 = new_selected_utxos_not_lbtc;
+    for (const auto& coin : fee_selected_coins) {
+      memcpy(txid_bytes.data(), coin.txid, txid_bytes.size());
+      auto ite =
+          utxo_map.find(OutPoint(Txid(ByteData256(txid_bytes)), coin.vout));
+      if (ite == utxo_map.end()) continue;
+      ElementsUtxoAndOption utxo_data = {};
+      utxo_data.utxo = *ite->second;
+      new_selected_utxos2.push_back(utxo_data);
+    }
+    fee = calc_fee + utxo_fee;
+    fee_value += utxo_fee.GetSatoshiValue();
+
+    // estimate fee after coinselection (new fee < old fee)
+    if (append_dummy_txout) {
+      int64_t dummy_amount =
+          fee_selected_value + txin_amount - tx_amount - fee_value;
+      ctxc->SetTxOutValue(dummy_txout_index, Amount(dummy_amount));
+    }
+    Amount new_fee = EstimateFeeByContext(
+        *ctxc, new_selected_utxos2, fee_asset, nullptr, nullptr,
+        is_blind_estimate_fee, option.GetEffectiveFeeBaserate(), exponent,
+        minimum_bits);
+    int64_t new_fee_value = new_fee.GetSatoshiValue();
+    if (new_fee_value < fee_value) {
+      fee_value = new_fee_value;
+      fee = Amount(fee_value);
+    }
+  }
+  if (append_dummy_txout) ctxc->RemoveTxOut(dummy_txout_index);
+  if ((fee_selected_value + txin_amount) < (tx_amount + fee)) {
+    warn(CFD_LOG_SOURCE, "Failed to FundRawTransaction. low fee asset.");
+    throw CfdException(CfdError::kCfdIllegalArgumentError, "low fee asset.");
+  }
+  append_fee_asset_txout_value =
+      fee_selected_value + txin_amount - tx_amount - fee.GetSatoshiValue();
+
+  if (calculate_fee != nullptr) *calculate_fee = fee;
+  // If the output amount of the fee asset is less than the dust amount, set it to fee.  // NOLINT
+  if ((!append_dummy_txout) || (dust_amount > append_fee_asset_txout_value)) {
+    // Set all the remaining amount to Fee.
+    fee += append_fee_asset_txout_value;
+  } else if (append_fee_asset_txout_value > 0) {
+    if (ElementsConfidentialAddress::IsConfidentialAddress(address_str)) {
+      ctxc->AddTxOut(
+          addr_factory.GetConfidentialAddress(address_str),
+          Amount(append_fee_asset_txout_value),
+          ConfidentialAssetId(fee_asset_str));
+    } else {
+      ctxc->AddTxOut(
+          address, Amount(append_fee_asset_txout_value),
+          ConfidentialAssetId(fee_asset_str));
+    }
+    if (append_txout_addresses) append_txout_addresses->push_back(address_str);
+  }
+
+  ctxc->UpdateFeeAmount(fee, fee_asset);
+
+  for (auto& utxo : fee_selected_coins) {
+    if (memcmp(utxo.asset, fee_asset_bytes, sizeof(utxo.asset)) == 0) {
+      memcpy(txid_bytes.data(), utxo.txid, txid_bytes.size());
+      ctxc->AddTxIn(OutPoint(Txid(ByteData256(txid_bytes)), utxo.vout));
+    }
+  }
+  if (estimate_fee) *estimate_fee = fee;
+}
+
 // -----------------------------------------------------------------------------
 // ConfidentialTransactionContext
 // -----------------------------------------------------------------------------
@@ -129,7 +747,7 @@ ConfidentialTransactionContext::ConfidentialTransactionContext(
 
 ConfidentialTransactionContext::ConfidentialTransactionContext(
     const ByteData& byte_data)
-    : ConfidentialTransaction(byte_data.GetHex()) {}
+    : ConfidentialTransaction(byte_data) {}
 
 ConfidentialTransactionContext::ConfidentialTransactionContext(
     const ConfidentialTransactionContext& context)
@@ -148,6 +766,7 @@ ConfidentialTransactionContext& ConfidentialTransactionContext::operator=(
     const ConfidentialTransactionContext& context) & {
   if (this != &context) {
     SetFromHex(context.GetHex());
+    MarkTxInIndexDirty();
     utxo_map_ = context.utxo_map_;
     signed_map_ = context.signed_map_;
     verify_map_ = context.verify_map_;
@@ -156,8 +775,36 @@ ConfidentialTransactionContext& ConfidentialTransactionContext::operator=(
   return *this;
 }
 
+size_t ConfidentialTransactionContext::CopyData(
+    uint8_t* buffer, size_t buffer_size) const {
+  const struct wally_tx* tx_pointer =
+      static_cast<const struct wally_tx*>(wally_tx_pointer_);
+  // the witness flag is ignored when no witness exists.
+  uint32_t flag = WALLY_TX_FLAG_USE_ELEMENTS | WALLY_TX_FLAG_USE_WITNESS;
+  size_t size = 0;
+  int ret = wally_tx_get_length(tx_pointer, flag, &size);
+  if (ret != WALLY_OK) {
+    warn(CFD_LOG_SOURCE, "wally_tx_get_length NG[{}].", ret);
+    throw CfdException(
+        CfdError::kCfdIllegalStateError, "tx length calc error.");
+  }
+  if ((buffer == nullptr) || (buffer_size < size)) return size;
+
+  size_t written = 0;
+  ret = wally_tx_to_bytes(tx_pointer, flag, buffer, buffer_size, &written);
+  if ((ret != WALLY_OK) || (written != size)) {
+    warn(CFD_LOG_SOURCE, "wally_tx_to_bytes NG[{}].", ret);
+    throw CfdException(
+        CfdError::kCfdIllegalStateError, "tx serialize error.");
+  }
+  return size;
+}
+
 uint32_t ConfidentialTransactionContext::GetTxInIndex(
     const OutPoint& outpoint) const {
+  uint32_t index = 0;
+  if (FindTxInIndex(outpoint, &index)) return index;
+  // throw the not found error.
   return GetTxInIndex(outpoint.GetTxid(), outpoint.GetVout());
 }
 
@@ -169,24 +816,19 @@ uint32_t ConfidentialTransactionContext::AddTxIn(const OutPoint& outpoint) {
 
 uint32_t ConfidentialTransactionContext::GetTxOutIndex(
     const Address& address) const {
-  return GetTxOutIndex(address.GetLockingScript());
+  uint32_t index = 0;
+  const Script locking_script = address.GetLockingScript();
+  if (FindTxOutIndex(locking_script, &index)) return index;
+  // throw the not found error.
+  return GetTxOutIndex(locking_script);
 }
 
 bool ConfidentialTransactionContext::IsFindTxIn(
     const OutPoint& outpoint, uint32_t* index) const {
-  static constexpr const char* const kErrorMessage = "Txid is not found.";
-  try {
-    uint32_t temp_index = GetTxInIndex(outpoint);
-    if (index != nullptr) *index = temp_index;
-    return true;
-  } catch (const CfdException& except) {
-    std::string errmsg(except.what());
-    if (errmsg == kErrorMessage) {
-      return false;
-    } else {
-      throw except;
-    }
-  }
+  uint32_t temp_index = 0;
+  if (!FindTxInIndex(outpoint, &temp_index)) return false;
+  if (index != nullptr) *index = temp_index;
+  return true;
 }
 
 bool ConfidentialTransactionContext::IsFindTxOut(
@@ -201,36 +843,34 @@ bool ConfidentialTransactionContext::IsFindTxOut(
     if ((index != nullptr) && (!indexes->empty())) *index = (*indexes)[0];
     return !indexes->empty();
   }
-  try {
-    uint32_t temp_index = GetTxOutIndex(locking_script);
-    if (index != nullptr) *index = temp_index;
-    return true;
-  } catch (const CfdException& except) {
-    if (except.GetErrorCode() == CfdError::kCfdIllegalArgumentError) {
-      return false;
-    } else {
-      throw except;
-    }
-  }
+  uint32_t temp_index = 0;
+  if (!FindTxOutIndex(locking_script, &temp_index)) return false;
+  if (index != nullptr) *index = temp_index;
+  return true;
 }
 
 bool ConfidentialTransactionContext::IsFindTxOut(
     const Address& address, uint32_t* index,
     std::vector<uint32_t>* indexes) const {
-  if (indexes != nullptr) {
-    return IsFindTxOut(address.GetLockingScript(), index, indexes);
-  }
-  try {
-    uint32_t temp_index = GetTxOutIndex(address);
-    if (index != nullptr) *index = temp_index;
-    return true;
-  } catch (const CfdException& except) {
-    if (except.GetErrorCode() == CfdError::kCfdIllegalArgumentError) {
-      return false;
-    } else {
-      throw except;
+  return IsFindTxOut(address.GetLockingScript(), index, indexes);
+}
+
+bool ConfidentialTransactionContext::FindTxInIndex(
+    const OutPoint& outpoint, uint32_t* index) const {
+  std::lock_guard<std::mutex> lock(txin_index_mutex_);
+  return TransactionContextUtil::FindTxInIndex(
+      vin_, outpoint, &txin_index_map_, &is_txin_index_dirty_, index);
+}
+
+bool ConfidentialTransactionContext::FindTxOutIndex(
+    const Script& locking_script, uint32_t* index) const {
+  for (uint32_t idx = 0; idx < static_cast<uint32_t>(vout_.size()); ++idx) {
+    if (locking_script.Equals(vout_[idx].GetLockingScript())) {
+      *index = idx;
+      return true;
     }
   }
+  return false;
 }
 
 const ConfidentialTxInReference ConfidentialTransactionContext::GetTxIn(
@@ -369,6 +1009,335 @@ bool ConfidentialTransactionContext::IsFindFeeTxOut(uint32_t* index) const {
   return is_find;
 }
 
+std::vector<UtxoData> ConfidentialTransactionContext::Fund(
+    const std::vector<UtxoData>& utxos,
+    const std::map<std::string, Amount>& map_target_value,
+    const std::vector<UtxoData>& selected_txin_utxos,
+    const std::map<std::string, std::string>& reserve_txout_address,
+    const ConfidentialAssetId& fee_asset, bool is_blind_estimate_fee,
+    double effective_fee_rate, Amount* estimate_fee, const UtxoFilter* filter,
+    const CoinSelectionOption* option_params,
+    std::vector<std::string>* append_txout_addresses, NetType net_type,
+    const std::vector<AddressFormatData>* prefix_list, Amount* calculate_fee) {
+  std::vector<ElementsUtxoAndOption> txin_utxos;
+  txin_utxos.reserve(selected_txin_utxos.size());
+  for (const auto& utxo : selected_txin_utxos) {
+    ElementsUtxoAndOption utxo_data = {};
+    utxo_data.utxo = utxo;
+    txin_utxos.push_back(utxo_data);
+  }
+  return Fund(
+      utxos, map_target_value, txin_utxos, reserve_txout_address, fee_asset,
+      is_blind_estimate_fee, effective_fee_rate, estimate_fee, filter,
+      option_params, append_txout_addresses, net_type, prefix_list,
+      calculate_fee);
+}
+
+std::vector<UtxoData> ConfidentialTransactionContext::Fund(
+    const std::vector<UtxoData>& utxos,
+    const std::map<std::string, Amount>& map_target_value,
+    const std::vector<ElementsUtxoAndOption>& selected_txin_utxos,
+    const std::map<std::string, std::string>& reserve_txout_address,
+    const ConfidentialAssetId& fee_asset, bool is_blind_estimate_fee,
+    double effective_fee_rate, Amount* estimate_fee, const UtxoFilter* filter,
+    const CoinSelectionOption* option_params,
+    std::vector<std::string>* append_txout_addresses, NetType net_type,
+    const std::vector<AddressFormatData>* prefix_list, Amount* calculate_fee) {
+  const size_t txin_count = vin_.size();
+  // set option
+  CoinSelectionOption option;
+  UtxoFilter utxo_filter;
+  if (filter) utxo_filter = *filter;
+  if (option_params) {
+    option = *option_params;
+  } else {
+    option.InitializeConfidentialTxSizeInfo();
+    option.SetEffectiveFeeBaserate(effective_fee_rate);
+    option.SetLongTermFeeBaserate(effective_fee_rate);
+  }
+  option.SetFeeAsset(fee_asset);
+  int exponent = 0;
+  int minimum_bits = 0;
+  option.GetBlindInfo(&exponent, &minimum_bits);
+
+  ElementsAddressFactory addr_factory(net_type);
+  if (prefix_list)
+    addr_factory = ElementsAddressFactory(net_type, *prefix_list);
+
+  // Collect TxIn and TxOut amounts from Transaction.
+  // (If it exists in selected_txin_utxos and the txid matches,
+  //  it is treated as a existed UTXO.)
+  ConfidentialTransactionContext& ctxc = *this;
+  std::map<std::string, int64_t> txin_amount_map;
+  std::map<std::string, int64_t> tx_amount_map;
+  std::vector<std::string> asset_list;
+  int32_t fee_index = -1;
+
+  // collect utxo data
+  CollectUtxoDataByFundRawTransaction(
+      ctxc, selected_txin_utxos, &txin_amount_map, &tx_amount_map, &asset_list,
+      &fee_index);
+
+  std::map<std::string, int64_t> target_values;
+  for (const auto& target : map_target_value) {
+    std::string asset = target.first;
+    if (std::find(asset_list.begin(), asset_list.end(), asset) ==
+        asset_list.end()) {
+      asset_list.push_back(asset);
+    }
+    target_values.emplace(asset, target.second.GetSatoshiValue());  // copy
+  }
+  std::map<std::string, int64_t> input_amount_map;
+  std::map<std::string, int64_t> input_max_map;
+  std::vector<UtxoData> utxodata_list;
+  utxodata_list.reserve(utxos.size());
+  uint32_t utxo_fee_asset_count = 0;
+  for (const auto& utxo : utxos) {
+    if (!ctxc.IsFindTxIn(OutPoint(utxo.txid, utxo.vout))) {
+      utxodata_list.push_back(utxo);
+      if ((!fee_asset.IsEmpty()) &&
+          (fee_asset.GetHex() == utxo.asset.GetHex())) {
+        ++utxo_fee_asset_count;
+      }
+    }
+    std::string asset = utxo.asset.GetHex();
+    int64_t utxo_amount = utxo.amount.GetSatoshiValue();
+    if (input_amount_map.find(asset) == input_amount_map.end()) {
+      int64_t amount;
+      input_amount_map.emplace(asset, amount);
+      input_max_map.emplace(asset, amount);
+    }
+    input_amount_map[asset] += utxo_amount;
+    if (input_max_map[asset] < utxo_amount) input_max_map[asset] = utxo_amount;
+  }
+
+  // calculate initial fee.
+  Amount fee;
+  bool use_fee = false;
+  if (option.GetEffectiveFeeBaserate() > 0) {
+    if (fee_asset.IsEmpty()) {
+      warn(CFD_LOG_SOURCE, "Failed to FundRawTransaction. Empty fee asset.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "Empty fee asset.");
+    }
+    use_fee = true;
+    std::string asset = fee_asset.GetHex();
+    if (std::find(asset_list.begin(), asset_list.end(), asset) ==
+        asset_list.end()) {
+      asset_list.push_back(asset);  // insert fee asset
+    }
+    if (fee_index == -1) {
+      // If fee is not registered, add fee.
+      ctxc.AddTxOutFee(Amount::CreateBySatoshiAmount(0), fee_asset);
+    }
+    fee = EstimateFeeByContext(
+        ctxc, selected_txin_utxos, fee_asset, nullptr, nullptr,
+        is_blind_estimate_fee, option.GetEffectiveFeeBaserate(), exponent,
+        minimum_bits);
+    if (estimate_fee) *estimate_fee = fee;
+  }
+
+  // Set the coin selection amount for each asset.
+  // The fee will be calculated later.
+  std::map<std::string, int64_t> select_require_values;
+  for (auto& asset : asset_list) {
+    if (target_values.find(asset) == target_values.end()) {
+      continue;
+    }
+    bool is_fee_asset = (asset == fee_asset.GetHex());
+    if (use_fee && is_fee_asset) {
+      continue;
+    }
+    int64_t txin_amount = txin_amount_map[asset];
+    int64_t tx_amount = tx_amount_map[asset];
+    int64_t target_value = target_values[asset];
+    int64_t diff_amount = 0;
+    bool isForceCheck = false;
+
+    if (txin_amount > tx_amount) {
+      diff_amount = txin_amount - tx_amount;
+      if (diff_amount < target_value) {
+        // If the amount of txin is insufficient, perform Coin Selection.
+        target_value -= diff_amount;
+      } else {
+        target_value = 0;  // If the amount is sufficient, use only txin UTXO.
+        isForceCheck = true;
+        // CoinSelection needs to be done, so enable the force flag.
+      }
+    } else if (txin_amount < tx_amount) {
+      // Set the amount to be added to txout.
+      target_value += tx_amount - txin_amount;
+    }
+    if ((target_value != 0) || isForceCheck)
+      select_require_values[asset] = target_value;
+  }
+  // execute coinselection
+  CoinSelection coin_select;
+  std::vector<Utxo> utxo_list = UtxoUtil::ConvertToUtxo(utxodata_list);
+  std::map<std::string, int64_t> amount_map;
+  std::map<std::string, int64_t> utxo_fee_map;
+  std::vector<Utxo> selected_coins;
+  Amount utxo_fee;
+  auto otherCoinOpt = option;
+  if (use_fee && (utxo_fee_asset_count == 0)) {
+    otherCoinOpt.SetIgnoreFeeAsset(true);
+  }
+  selected_coins = coin_select.SelectCoins(
+      select_require_values, utxo_list, utxo_filter, otherCoinOpt, fee,
+      &amount_map, &utxo_fee, nullptr, &utxo_fee_map);
+
+  // defined fee_asset_bytes
+  std::string fee_asset_str;
+  uint8_t fee_asset_bytes[33];
+  if (use_fee) {
+    fee_asset_str = fee_asset.GetHex();
+    memcpy(
+        fee_asset_bytes, fee_asset.GetData().GetBytes().data(),
+        sizeof(fee_asset_bytes));
+  }
+
+  std::map<std::string, int64_t> append_txout_amount_map = amount_map;
+  {  // for warning
+    auto itr = amount_map.begin();
+    while (itr != amount_map.end()) {
+      std::string asset = itr->first;
+      int64_t txin_amount = txin_amount_map[asset];
+      int64_t txout_amount = tx_amount_map[asset];
+
+      if (use_fee && (itr->first == fee_asset_str)) {
+        // The fee asset will be calculated later, so it will be excluded from the txout addition target.  // NOLINT
+        append_txout_amount_map.erase(itr->first);
+      } else {
+        append_txout_amount_map[itr->first] =
+            itr->second + txin_amount - txout_amount;
+      }
+      ++itr;
+    }
+  }
+
+  for (auto itr = append_txout_amount_map.begin();
+       itr != append_txout_amount_map.end(); ++itr) {
+    if (itr->second > 0) {
+      std::string address_str;
+      if (reserve_txout_address.find(itr->first) !=
+          reserve_txout_address.end()) {
+        address_str = reserve_txout_address.at(itr->first);
+      }
+
+      if (address_str.empty()) {
+        warn(
+            CFD_LOG_SOURCE,
+            "Failed to FundRawTransaction. Append asset address not set.");
+        throw CfdException(
+            CfdError::kCfdIllegalArgumentError,
+            "Failed to FundRawTransaction. Append asset address not set.");
+      }
+
+      // address check
+      if (ElementsConfidentialAddress::IsConfidentialAddress(address_str)) {
+        ElementsConfidentialAddress ct_addr =
+            addr_factory.GetConfidentialAddress(address_str);
+        if (!addr_factory.CheckConfidentialAddressNetType(ct_addr, net_type)) {
+          warn(
+              CFD_LOG_SOURCE,
+              "Failed to FundRawTransaction. "
+              "Input address and network is unmatch."
+              ": address=[{}], input_net_type=[{}], parsed_net_type=[{}]",
+              address_str, net_type, ct_addr.GetNetType());
+          throw CfdException(
+              CfdError::kCfdIllegalArgumentError,
+              "Failed to FundRawTransaction. "
+              "Input address and network is unmatch.");
+        }
+
+        Amount dust_amount =
+            option.GetConfidentialDustFeeAmount(ct_addr.GetUnblindedAddress());
+        if ((use_fee) || (itr->second > dust_amount.GetSatoshiValue())) {
+          ctxc.AddTxOut(
+              ct_addr, Amount(itr->second), ConfidentialAssetId(itr->first));
+        } else {
+          warn(
+              CFD_LOG_SOURCE,
+              "Failed to FundRawTransaction. amount less than dust amount.");
+          throw CfdException(
+              CfdError::kCfdIllegalArgumentError,
+              "amount less than dust amount.");
+        }
+      } else {
+        Address address = addr_factory.GetAddress(address_str);
+        if (!addr_factory.CheckAddressNetType(address, net_type)) {
+          warn(
+              CFD_LOG_SOURCE,
+              "Failed to FundRawTransaction. "
+              "Input address and network is unmatch."
+              ": address=[{}], input_net_type=[{}], parsed_net_type=[{}]",
+              address_str, net_type, address.GetNetType());
+          throw CfdException(
+              CfdError::kCfdIllegalArgumentError,
+              "Failed to FundRawTransaction. "
+              "Input address and network is unmatch.");
+        }
+        Amount dust_amount = option.GetConfidentialDustFeeAmount(address);
+        if ((use_fee) || (itr->second > dust_amount.GetSatoshiValue())) {
+          ctxc.AddTxOut(
+              address, Amount(itr->second), ConfidentialAssetId(itr->first));
+        } else {
+          warn(
+              CFD_LOG_SOURCE,
+              "Failed to FundRawTransaction. amount less than dust amount.");
+          throw CfdException(
+              CfdError::kCfdIllegalArgumentError,
+              "amount less than dust amount.");
+        }
+      }
+      if (append_txout_addresses)
+        append_txout_addresses->push_back(address_str);
+    }
+  }
+
+  // calculate fee asset
+  std::vector<uint8_t> txid_bytes(cfd::core::kByteData256Length);
+  if (use_fee) {
+    CalculateFeeAndFundTransaction(
+        addr_factory, txin_amount_map, tx_amount_map, target_values,
+        input_max_map, selected_coins, utxodata_list, fee_asset,
+        selected_txin_utxos, reserve_txout_address, net_type,
+        is_blind_estimate_fee, utxo_filter, option, utxo_list, utxo_fee_map,
+        &ctxc, append_txout_addresses, estimate_fee, calculate_fee);
+  }
+
+  for (auto& utxo : selected_coins) {
+    if ((!use_fee) ||
+        (memcmp(utxo.asset, fee_asset_bytes, sizeof(utxo.asset)) != 0)) {
+      memcpy(txid_bytes.data(), utxo.txid, txid_bytes.size());
+      ctxc.AddTxIn(OutPoint(Txid(ByteData256(txid_bytes)), utxo.vout));
+    }
+  }
+
+  // collect the utxo data of the appended txin.
+  std::map<OutPoint, const UtxoData*> utxo_map;
+  for (const auto& utxo : utxos) {
+    utxo_map.emplace(OutPoint(utxo.txid, utxo.vout), &utxo);
+  }
+  std::vector<UtxoData> append_utxos;
+  append_utxos.reserve(vin_.size() - txin_count);
+  for (size_t index = txin_count; index < vin_.size(); ++index) {
+    auto ite = utxo_map.find(vin_[index].GetOutPoint());
+    if (ite != utxo_map.end()) append_utxos.push_back(*ite->second);
+  }
+  return append_utxos;
+}
+
+Amount ConfidentialTransactionContext::EstimateFee(
+    const std::vector<ElementsUtxoAndOption>& utxos,
+    const ConfidentialAssetId& fee_asset, Amount* txout_fee, Amount* utxo_fee,
+    bool is_blind, uint64_t effective_fee_rate, int exponent, int minimum_bits,
+    uint32_t* append_asset_count) const {
+  return EstimateFeeByContext(
+      *this, utxos, fee_asset, txout_fee, utxo_fee, is_blind,
+      effective_fee_rate, exponent, minimum_bits, append_asset_count);
+}
+
 Amount ConfidentialTransactionContext::GetFeeAmount(
     ConfidentialAssetId* asset) const {
   Amount result;
@@ -1057,9 +2026,15 @@ uint32_t ConfidentialTransactionContext::GetLockTimeDisabledSequence() {
 void ConfidentialTransactionContext::CallbackStateChange(uint32_t type) {
   cfd::core::logger::trace(
       CFD_LOG_SOURCE, "CallbackStateChange type::{}", type);
+  MarkTxInIndexDirty();
   verify_map_.clear();
 }
 
+void ConfidentialTransactionContext::MarkTxInIndexDirty() {
+  std::lock_guard<std::mutex> lock(txin_index_mutex_);
+  is_txin_index_dirty_ = true;
+}
+
 bool ConfidentialTransactionContext::IsFindUtxoMap(
     const OutPoint& outpoint, UtxoData* utxo) const {
   for (const auto& utxo_data : utxo_map_) {
@@ -36,26 +36,32 @@ uint64_t GetSupportedFunction() { return cfd_instance.GetSupportedFunction(); }
 // Management
 // -----------------------------------------------------------------------------
 void CfdManager::Initialize() {
-  if (finalized_) {
+  // 初期化済みであれば、acquireのloadのみで終了する。
+  if (state_.load(std::memory_order_acquire) == kStateInitialized) return;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  int state = state_.load(std::memory_order_relaxed);
+  if (state == kStateFinalized) {
     throw CfdException(
         CfdError::kCfdIllegalStateError, "Initialize already finalized.");
   }
 
-  if (!initialized_) {
+  if (state == kStateUninitialized) {
     // 初期化処理実施
     cfd::core::Initialize(&handle_);
-    initialized_ = true;
+    state_.store(kStateInitialized, std::memory_order_release);
     info(CFD_LOG_SOURCE, "cfd initialize.");
   }
 }
 
 void CfdManager::Finalize(bool is_finish_process) {
-  if (initialized_ && (!finalized_)) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (state_.load(std::memory_order_relaxed) == kStateInitialized) {
     if (!is_finish_process) {
       info(CFD_LOG_SOURCE, "cfd finalize.");
     }
     cfd::core::Finalize(handle_, is_finish_process);
-    finalized_ = true;
+    state_.store(kStateFinalized, std::memory_order_release);
     handle_ = nullptr;
   }
 }
@@ -80,13 +86,12 @@ uint64_t CfdManager::GetSupportedFunction() {
   return support_function;
 }
 
-CfdManager::CfdManager()
-    : handle_(nullptr), initialized_(false), finalized_(false) {
+CfdManager::CfdManager() : handle_(nullptr), state_(kStateUninitialized) {
   // do nothing
 }
 
 CfdManager::~CfdManager() {
-  if (initialized_ && (!finalized_)) {
+  if (state_.load(std::memory_order_acquire) == kStateInitialized) {
     cfd::core::Finalize(handle_, true);
   }
 }
@@ -9,7 +9,9 @@
 #ifndef CFD_SRC_CFD_MANAGER_H_
 #define CFD_SRC_CFD_MANAGER_H_
 
+#include <atomic>
 #include <memory>
+#include <mutex>  // NOLINT
 
 #include "cfd/cfd_common.h"
 #include "cfdcore/cfdcore_common.h"
@@ -49,9 +51,18 @@ class CfdManager {
   uint64_t GetSupportedFunction();
 
  private:
+  /**
+   * @brief 初期化状態
+   */
+  enum ManagerState {
+    kStateUninitialized = 0,  //!< 未初期化
+    kStateInitialized = 1,    //!< 初期化済み
+    kStateFinalized = 2,      //!< 終了済み
+  };
+
   cfd::core::CfdCoreHandle handle_;  ///< ハンドル
-  bool initialized_;                 ///< 初期化済みフラグ
-  bool finalized_;                   ///< 終了済みフラグ
+  std::atomic<int> state_;           ///< 初期化状態 (ManagerState)
+  std::mutex mutex_;                 ///< 初期化・終了処理の排他
 };
 
 }  // namespace cfd
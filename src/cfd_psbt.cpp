@@ -8,19 +8,25 @@
 #include "cfd/cfd_psbt.h"
 
 #include <algorithm>
+#include <cstring>
+#include <exception>
+#include <mutex>  // NOLINT
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "cfd/cfd_address.h"
 #include "cfd/cfd_transaction.h"
 #include "cfd/cfdapi_address.h"
-#include "cfd/cfdapi_transaction.h"
 #include "cfd_transaction_internal.h"  // NOLINT
 #include "cfdcore/cfdcore_amount.h"
+#include "cfdcore/cfdcore_key.h"
 #include "cfdcore/cfdcore_psbt.h"
 #include "cfdcore/cfdcore_script.h"
 #include "cfdcore/cfdcore_taproot.h"
 #include "cfdcore/cfdcore_transaction.h"
 #include "cfdcore/cfdcore_transaction_common.h"
+#include "cfdcore/cfdcore_util.h"
 #include "wally_psbt.h"  // NOLINT
 
 namespace cfd {
@@ -29,8 +35,10 @@ using cfd::core::AbstractTransaction;
 using cfd::core::Amount;
 using cfd::core::CfdError;
 using cfd::core::CfdException;
+using cfd::core::CryptoUtil;
 using cfd::core::Script;
 using cfd::core::ScriptUtil;
+using cfd::core::SignatureUtil;
 using cfd::core::TaprootScriptTree;
 using cfd::core::TxIn;
 using cfd::core::logger::warn;
@@ -39,32 +47,350 @@ using cfd::core::logger::warn;
 // File internal function
 // -----------------------------------------------------------------------------
 /**
- * @brief Collect sighash by transaction.
+ * @brief Clone the psbt structure.
+ * @param[in] wally_psbt_pointer    source psbt pointer
+ * @return cloned psbt pointer
+ */
+static struct wally_psbt* ClonePsbtStruct(const void* wally_psbt_pointer) {
+  struct wally_psbt* psbt_pointer = nullptr;
+  const struct wally_psbt* psbt_src_pointer =
+      static_cast<const struct wally_psbt*>(wally_psbt_pointer);
+  int ret = wally_psbt_clone_alloc(psbt_src_pointer, 0, &psbt_pointer);
+  if (ret != WALLY_OK) {
+    warn(CFD_LOG_SOURCE, "wally_psbt_clone_alloc NG[{}]", ret);
+    throw CfdException(CfdError::kCfdInternalError, "psbt clone error.");
+  }
+  return psbt_pointer;
+}
+
+/**
+ * @brief Add the txin and txout of the psbt base tx to the context.
+ * @details build from the psbt structure without serialize and parse.
+ * @param[in] base_tx       psbt base tx
+ * @param[out] transaction  transaction context
+ */
+static void AddPsbtBaseTxToContext(
+    const struct wally_tx* base_tx, TransactionContext* transaction) {
+  for (size_t index = 0; index < base_tx->num_inputs; ++index) {
+    const struct wally_tx_input& input = base_tx->inputs[index];
+    transaction->AddTxIn(
+        Txid(ByteData256(ByteData(input.txhash, sizeof(input.txhash)))),
+        input.index, input.sequence, Script::Empty);
+  }
+  for (size_t index = 0; index < base_tx->num_outputs; ++index) {
+    const struct wally_tx_output& output = base_tx->outputs[index];
+    transaction->AddTxOut(
+        Amount(static_cast<int64_t>(output.satoshi)),
+        Script(ByteData(
+            output.script, static_cast<uint32_t>(output.script_len))));
+  }
+}
+
+/**
+ * @brief Check the outpoint of the psbt base tx txin.
+ * @param[in] input       psbt base tx txin
+ * @param[in] outpoint    outpoint
+ * @retval true   match
+ * @retval false  unmatch
+ */
+static bool IsMatchPsbtTxIn(
+    const struct wally_tx_input& input, const OutPoint& outpoint) {
+  if (input.index != outpoint.GetVout()) return false;
+  const std::vector<uint8_t> txid = outpoint.GetTxid().GetData().GetBytes();
+  return (txid.size() == sizeof(input.txhash)) &&
+         std::equal(txid.begin(), txid.end(), input.txhash);
+}
+
+/**
+ * @brief Verify psbt txin on the known txin index.
+ * @details The txin index is fixed, so the txin is not searched by outpoint.
  * @param[in] transaction       transaction
+ * @param[in] index             txin index
  * @param[in] outpoint          outpoint
  * @param[in] utxo              utxo
- * @param[in] sighash_type      sighash_type
- * @param[in] pubkey            pubkey
- * @param[in] redeem_script     redeem_script
- * @param[in] witness_version   witness_version
- * @return sighash
+ * @param[in] txin              txin with final script
  */
-static ByteData256 CollectSighashByTx(
-    const Transaction* transaction, const OutPoint& outpoint,
-    const UtxoData& utxo, const SigHashType& sighash_type,
-    const Pubkey& pubkey, const Script& redeem_script,
-    WitnessVersion witness_version, const ByteData*,
-    const TaprootScriptTree*) {
-  uint32_t index =
-      transaction->GetTxInIndex(outpoint.GetTxid(), outpoint.GetVout());
-  Script script_data = redeem_script;
-  if (script_data.IsEmpty()) {
-    script_data = ScriptUtil::CreateP2pkhLockingScript(pubkey);
+static void VerifyPsbtTxIn(
+    const Transaction& transaction, uint32_t index, const OutPoint& outpoint,
+    const UtxoData& utxo, const TxIn& txin) {
+  auto create_sighash_func =
+      [index](
+          const Transaction* tx, const OutPoint&, const UtxoData& utxo_data,
+          const SigHashType& sighash_type, const Pubkey& pubkey,
+          const Script& redeem_script, WitnessVersion witness_version,
+          const ByteData*, const TaprootScriptTree*) -> ByteData256 {
+    Script script_data = redeem_script;
+    if (script_data.IsEmpty()) {
+      script_data = ScriptUtil::CreateP2pkhLockingScript(pubkey);
+    }
+    return tx->GetSignatureHash(
+        index, script_data.GetData(), sighash_type, utxo_data.amount,
+        witness_version);
+  };
+  TransactionContextUtil::Verify<Transaction>(
+      &transaction, outpoint, utxo, &txin, create_sighash_func);
+}
+
+/**
+ * @brief Get the ecdsa sign script code of psbt txin.
+ * @param[in] utxo              utxo
+ * @param[in] redeem_script     redeem script
+ * @param[in] witness_script    witness script
+ * @param[in] pubkey            sign target pubkey
+ * @param[out] script_code      script code
+ * @param[out] version          witness version
+ * @retval true   standard ecdsa sign target.
+ * @retval false  unsupported sign target.
+ */
+static bool GetPsbtSignScriptCode(
+    const TxOut& utxo, const Script& redeem_script,
+    const Script& witness_script, const Pubkey& pubkey, Script* script_code,
+    WitnessVersion* version) {
+  const Script& locking_script = utxo.GetLockingScript();
+  if (locking_script.IsEmpty() || locking_script.IsTaprootScript()) {
+    return false;
+  }
+  Script target = locking_script;
+  if (locking_script.IsP2shScript()) {
+    if (redeem_script.IsEmpty()) return false;
+    target = redeem_script;
+  }
+  if (target.IsP2wpkhScript()) {
+    *script_code = ScriptUtil::CreateP2pkhLockingScript(pubkey);
+    *version = WitnessVersion::kVersion0;
+  } else if (target.IsP2wshScript()) {
+    if (witness_script.IsEmpty()) return false;
+    *script_code = witness_script;
+    *version = WitnessVersion::kVersion0;
+  } else if (target.IsWitnessProgram()) {
+    return false;
+  } else {
+    *script_code = target;
+    *version = WitnessVersion::kVersionNone;
+  }
+  return true;
+}
+
+/**
+ * @brief Throw the psbt combine error.
+ * @param[in] name    wally function name
+ * @param[in] ret     wally result code
+ */
+static void ThrowPsbtCombineError(const char* name, int ret) {
+  warn(CFD_LOG_SOURCE, "{} NG[{}]", name, ret);
+  throw CfdException(CfdError::kCfdInternalError, "psbt combine error.");
+}
+
+/**
+ * @brief Get the psbt shell that has only one input.
+ * @details The shell refers the input of the original psbt, so the input \
+ *    is combined in place by wally_psbt_combine. The global maps and \
+ *    the outputs are not set on the shell.
+ * @param[in] psbt      psbt
+ * @param[in] tx        base transaction (same txid as the psbt)
+ * @param[in] index     input index
+ * @return psbt shell
+ */
+static struct wally_psbt GetPsbtInputShell(
+    const struct wally_psbt* psbt, struct wally_tx* tx, size_t index) {
+  struct wally_psbt shell;
+  memset(&shell, 0, sizeof(shell));
+  memcpy(shell.magic, psbt->magic, sizeof(shell.magic));
+  shell.version = psbt->version;
+  shell.tx = tx;
+  shell.inputs = &psbt->inputs[index];
+  shell.num_inputs = 1;
+  shell.inputs_allocation_len = 1;
+  return shell;
+}
+
+/**
+ * @brief Get the psbt shell that has no input.
+ * @details The shell copies the psbt except for the inputs, so the outputs \
+ *    and the globals are combined by wally_psbt_combine.
+ * @param[in] psbt      psbt
+ * @return psbt shell
+ */
+static struct wally_psbt GetPsbtGlobalShell(const struct wally_psbt* psbt) {
+  struct wally_psbt shell = *psbt;
+  shell.inputs = nullptr;
+  shell.num_inputs = 0;
+  shell.inputs_allocation_len = 0;
+  return shell;
+}
+
+//! psbt stream read chunk size
+static constexpr uint64_t kPsbtStreamChunkSize = 65536;
+
+/**
+ * @brief Throw the psbt stream decode error.
+ * @param[in] message   error message
+ */
+static void ThrowPsbtStreamError(const std::string& message) {
+  warn(CFD_LOG_SOURCE, "psbt stream decode error. {}", message);
+  throw CfdException(
+      CfdError::kCfdIllegalArgumentError,
+      "psbt stream decode error. " + message);
+}
+
+/**
+ * @brief Read the bytes from the psbt stream.
+ * @details The buffer is extended on each chunk, so the broken size \
+ *    does not allocate the large buffer in advance.
+ * @param[in,out] stream    psbt stream
+ * @param[in] size          read size
+ * @return read bytes
+ */
+static std::vector<uint8_t> ReadPsbtStreamBytes(
+    std::istream* stream, uint64_t size) {
+  std::vector<uint8_t> buffer;
+  uint64_t offset = 0;
+  while (offset < size) {
+    uint64_t read_size = std::min(size - offset, kPsbtStreamChunkSize);
+    buffer.resize(static_cast<size_t>(offset + read_size));
+    stream->read(
+        reinterpret_cast<char*>(buffer.data() + offset),
+        static_cast<std::streamsize>(read_size));
+    if (static_cast<uint64_t>(stream->gcount()) != read_size) {
+      ThrowPsbtStreamError("unexpected end of stream.");
+    }
+    offset += read_size;
+  }
+  return buffer;
+}
+
+/**
+ * @brief Skip the bytes on the psbt stream.
+ * @param[in,out] stream    psbt stream
+ * @param[in] size          skip size
+ */
+static void SkipPsbtStreamBytes(std::istream* stream, uint64_t size) {
+  uint64_t offset = 0;
+  while (offset < size) {
+    uint64_t skip_size = std::min(size - offset, kPsbtStreamChunkSize);
+    stream->ignore(static_cast<std::streamsize>(skip_size));
+    if (static_cast<uint64_t>(stream->gcount()) != skip_size) {
+      ThrowPsbtStreamError("unexpected end of stream.");
+    }
+    offset += skip_size;
+  }
+}
+
+/**
+ * @brief Read the compact size from the buffer.
+ * @param[in] buffer        buffer
+ * @param[in,out] offset    read offset
+ * @return compact size value
+ */
+static uint64_t ReadPsbtCompactSize(
+    const std::vector<uint8_t>& buffer, size_t* offset) {
+  if (buffer.size() <= *offset) ThrowPsbtStreamError("invalid compact size.");
+  uint8_t head = buffer[*offset];
+  size_t length = 0;
+  if (head == 0xfd) {
+    length = 2;
+  } else if (head == 0xfe) {
+    length = 4;
+  } else if (head == 0xff) {
+    length = 8;
+  }
+  ++(*offset);
+  if (length == 0) return head;
+  if (buffer.size() < *offset + length) {
+    ThrowPsbtStreamError("invalid compact size.");
+  }
+  uint64_t value = 0;
+  for (size_t index = 0; index < length; ++index) {
+    value |= static_cast<uint64_t>(buffer[*offset + index]) << (index * 8);
+  }
+  *offset += length;
+  return value;
+}
+
+/**
+ * @brief Read the compact size from the psbt stream.
+ * @param[in,out] stream    psbt stream
+ * @return compact size value
+ */
+static uint64_t ReadPsbtStreamCompactSize(std::istream* stream) {
+  std::vector<uint8_t> buffer = ReadPsbtStreamBytes(stream, 1);
+  if (buffer[0] == 0xfd) {
+    auto data = ReadPsbtStreamBytes(stream, 2);
+    buffer.insert(buffer.end(), data.begin(), data.end());
+  } else if (buffer[0] == 0xfe) {
+    auto data = ReadPsbtStreamBytes(stream, 4);
+    buffer.insert(buffer.end(), data.begin(), data.end());
+  } else if (buffer[0] == 0xff) {
+    auto data = ReadPsbtStreamBytes(stream, 8);
+    buffer.insert(buffer.end(), data.begin(), data.end());
+  }
+  size_t offset = 0;
+  return ReadPsbtCompactSize(buffer, &offset);
+}
+
+/**
+ * @brief Read the record key from the psbt stream.
+ * @param[in,out] stream    psbt stream
+ * @param[out] key          record key
+ * @retval true   read the record key.
+ * @retval false  map separator.
+ */
+static bool ReadPsbtStreamKey(
+    std::istream* stream, std::vector<uint8_t>* key) {
+  uint64_t key_size = ReadPsbtStreamCompactSize(stream);
+  if (key_size == 0) return false;
+  *key = ReadPsbtStreamBytes(stream, key_size);
+  return true;
+}
+
+/**
+ * @brief Extract the spent output from the non witness utxo record.
+ * @details The previous transaction is released after this function.
+ * @param[in] value       non witness utxo record value
+ * @param[in] outpoint    spent outpoint
+ * @param[out] utxo       utxo data
+ */
+static void ExtractPsbtStreamNonWitnessUtxo(
+    const std::vector<uint8_t>& value, const OutPoint& outpoint,
+    UtxoData* utxo) {
+  Transaction tx(ByteData(value));
+  if (!tx.GetTxid().Equals(outpoint.GetTxid())) {
+    warn(CFD_LOG_SOURCE, "psbt invalid state. unmatch utxo txid.");
+    throw CfdException(
+        CfdError::kCfdIllegalStateError,
+        "psbt invalid state. unmatch utxo txid.");
+  }
+  if (tx.GetTxOutCount() <= outpoint.GetVout()) {
+    warn(CFD_LOG_SOURCE, "psbt invalid state. utxo vout out of range.");
+    throw CfdException(
+        CfdError::kCfdIllegalStateError,
+        "psbt invalid state. utxo vout out of range.");
   }
-  auto sighash = transaction->GetSignatureHash(
-      index, script_data.GetData(), sighash_type, utxo.amount,
-      witness_version);
-  return sighash;
+  auto txout = tx.GetTxOut(outpoint.GetVout());
+  utxo->amount = txout.GetValue();
+  utxo->locking_script = txout.GetLockingScript();
+}
+
+/**
+ * @brief Extract the output from the witness utxo record.
+ * @param[in] value       witness utxo record value
+ * @param[out] utxo       utxo data
+ */
+static void ExtractPsbtStreamWitnessUtxo(
+    const std::vector<uint8_t>& value, UtxoData* utxo) {
+  if (value.size() < 9) ThrowPsbtStreamError("invalid witness utxo.");
+  uint64_t amount = 0;
+  for (size_t index = 0; index < 8; ++index) {
+    amount |= static_cast<uint64_t>(value[index]) << (index * 8);
+  }
+  size_t offset = 8;
+  uint64_t script_size = ReadPsbtCompactSize(value, &offset);
+  if (value.size() != offset + script_size) {
+    ThrowPsbtStreamError("invalid witness utxo.");
+  }
+  utxo->amount = Amount(static_cast<int64_t>(amount));
+  utxo->locking_script = Script(ByteData(std::vector<uint8_t>(
+      value.begin() + offset, value.end())));
 }
 
 /**
@@ -202,36 +528,134 @@ Psbt::Psbt(uint32_t psbt_version, const TransactionContext& context)
   CollectInputUtxo(utxo_list);
 }
 
-Psbt::Psbt(const Psbt& psbt) : cfd::core::Psbt(psbt.GetData()) {
+Psbt::Psbt(const Psbt& psbt) : cfd::core::Psbt() {
+  // clone the structure directly. (without serialize and parse)
+  struct wally_psbt* psbt_pointer = ClonePsbtStruct(psbt.wally_psbt_pointer_);
+  cfd::core::Psbt::FreeWallyPsbtAddress(wally_psbt_pointer_);  // free
+  wally_psbt_pointer_ = psbt_pointer;
+  base_tx_ = cfd::core::Psbt::RebuildTransaction(wally_psbt_pointer_);
   verify_ignore_map_ = psbt.verify_ignore_map_;
 }
 
 Psbt& Psbt::operator=(const Psbt& psbt) & {
   if (this != &psbt) {
-    struct wally_psbt* psbt_pointer = nullptr;
-    struct wally_psbt* psbt_src_pointer = nullptr;
-    psbt_src_pointer =
-        static_cast<struct wally_psbt*>(psbt.wally_psbt_pointer_);
-    int ret = wally_psbt_clone_alloc(psbt_src_pointer, 0, &psbt_pointer);
-    if (ret != WALLY_OK) {
-      warn(CFD_LOG_SOURCE, "wally_psbt_clone_alloc NG[{}]", ret);
-      throw CfdException(CfdError::kCfdInternalError, "psbt clone error.");
-    }
+    struct wally_psbt* psbt_pointer =
+        ClonePsbtStruct(psbt.wally_psbt_pointer_);
     cfd::core::Psbt::FreeWallyPsbtAddress(wally_psbt_pointer_);  // free
     wally_psbt_pointer_ = psbt_pointer;
     base_tx_ = cfd::core::Psbt::RebuildTransaction(wally_psbt_pointer_);
     verify_ignore_map_ = psbt.verify_ignore_map_;
+    MarkTxInIndexDirty();
   }
   return *this;
 }
 
+void Psbt::Combine(
+    const std::vector<Psbt>& psbt_list, uint32_t thread_count) {
+  if (psbt_list.empty()) return;
+
+  struct wally_psbt* psbt_pointer =
+      static_cast<struct wally_psbt*>(wally_psbt_pointer_);
+  if ((psbt_pointer == nullptr) || (psbt_pointer->tx == nullptr)) {
+    warn(CFD_LOG_SOURCE, "psbt base tx is null");
+    throw CfdException(
+        CfdError::kCfdIllegalStateError, "psbt base tx is null.");
+  }
+  // The sources are read directly. (without clone)
+  std::vector<const struct wally_psbt*> src_list;
+  src_list.reserve(psbt_list.size());
+  Txid txid = base_tx_.GetTxid();
+  for (const auto& psbt : psbt_list) {
+    const struct wally_psbt* src_pointer =
+        static_cast<const struct wally_psbt*>(psbt.wally_psbt_pointer_);
+    if ((src_pointer == nullptr) || (src_pointer->tx == nullptr) ||
+        (src_pointer->num_inputs != psbt_pointer->num_inputs) ||
+        (src_pointer->num_outputs != psbt_pointer->num_outputs) ||
+        (src_pointer->version != psbt_pointer->version) ||
+        (!psbt.base_tx_.GetTxid().Equals(txid))) {
+      warn(CFD_LOG_SOURCE, "psbt combine error. unmatch base tx.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError,
+          "psbt combine error. unmatch base tx.");
+    }
+    if (src_pointer != psbt_pointer) src_list.push_back(src_pointer);
+  }
+  if (src_list.empty()) return;
+
+  // Each input index is combined with all sources on one pass.
+  // The input shells share the base tx, because the txids are checked.
+  auto errors = TransactionContextUtil::ParallelFor(
+      psbt_pointer->num_inputs, thread_count, 1,
+      [psbt_pointer, &src_list](size_t index) {
+        struct wally_psbt dest =
+            GetPsbtInputShell(psbt_pointer, psbt_pointer->tx, index);
+        for (const auto src_pointer : src_list) {
+          struct wally_psbt src =
+              GetPsbtInputShell(src_pointer, psbt_pointer->tx, index);
+          int ret = wally_psbt_combine(&dest, &src);
+          if (ret != WALLY_OK) ThrowPsbtCombineError("wally_psbt_combine", ret);
+        }
+      });
+  TransactionContextUtil::RethrowFirstError(errors);
+
+  // outputs and globals are small, so they are combined on this thread.
+  struct wally_psbt dest = GetPsbtGlobalShell(psbt_pointer);
+  int ret = WALLY_OK;
+  for (const auto src_pointer : src_list) {
+    struct wally_psbt src = GetPsbtGlobalShell(src_pointer);
+    ret = wally_psbt_combine(&dest, &src);
+    if (ret != WALLY_OK) break;
+  }
+  // write back the combined globals. (the inputs are not changed)
+  dest.inputs = psbt_pointer->inputs;
+  dest.num_inputs = psbt_pointer->num_inputs;
+  dest.inputs_allocation_len = psbt_pointer->inputs_allocation_len;
+  *psbt_pointer = dest;
+  if (ret != WALLY_OK) ThrowPsbtCombineError("wally_psbt_combine", ret);
+}
+
 TransactionContext Psbt::GetTransactionContext() const {
-  TransactionContext tx(GetTransaction().GetHex());
+  struct wally_psbt* psbt_pointer;
+  psbt_pointer = static_cast<struct wally_psbt*>(wally_psbt_pointer_);
+  if ((psbt_pointer == nullptr) || (psbt_pointer->tx == nullptr)) {
+    warn(CFD_LOG_SOURCE, "psbt base tx is null");
+    throw CfdException(
+        CfdError::kCfdIllegalStateError, "psbt base tx is null.");
+  }
+
+  const struct wally_tx* base_tx = psbt_pointer->tx;
+  TransactionContext tx(base_tx->version, base_tx->locktime);
+  AddPsbtBaseTxToContext(base_tx, &tx);
+
+  // utxo list is the txin order, so it is collected on one pass.
   std::vector<UtxoData> utxo_list = GetUtxoDataAll();
   tx.CollectInputUtxo(utxo_list);
   return tx;
 }
 
+void Psbt::SetTxInFinalScriptByContext(const TransactionContext& context) {
+  uint32_t max = context.GetTxInCount();
+  for (uint32_t txin_index = 0; txin_index < max; ++txin_index) {
+    auto txin = context.GetTxIn(txin_index);
+    uint32_t index = 0;
+    if (!IsFindTxIn(txin.GetOutPoint(), &index)) continue;
+
+    bool is_witness = false;
+    cfd::core::Psbt::GetTxInUtxo(index, true, &is_witness);
+    if (is_witness) {
+      std::vector<ByteData> witness_stack =
+          txin.GetScriptWitness().GetWitness();
+      if (!witness_stack.empty()) {
+        cfd::core::Psbt::SetTxInFinalScript(index, witness_stack);
+      }
+    } else if (!txin.GetUnlockingScript().IsEmpty()) {
+      std::vector<ByteData> script_stack;
+      script_stack.emplace_back(txin.GetUnlockingScript().GetData());
+      cfd::core::Psbt::SetTxInFinalScript(index, script_stack);
+    }
+  }
+}
+
 bool Psbt::HasAllUtxos() const {
   struct wally_psbt* psbt_pointer;
   psbt_pointer = static_cast<struct wally_psbt*>(wally_psbt_pointer_);
@@ -320,32 +744,67 @@ uint32_t Psbt::AddTxInData(const UtxoData& utxo, uint32_t sequence) {
     psbt_pointer = static_cast<struct wally_psbt*>(wally_psbt_pointer_);
     wally_psbt_remove_input(psbt_pointer, index);
     base_tx_ = cfd::core::Psbt::RebuildTransaction(wally_psbt_pointer_);
+    MarkTxInIndexDirty();
     throw except;
   }
   return index;
 }
 
 bool Psbt::IsFindTxIn(const OutPoint& outpoint, uint32_t* index) const {
-  static constexpr const char* const kErrorMessage = "Txid is not found.";
-  try {
-    uint32_t temp_index =
-        base_tx_.GetTxInIndex(outpoint.GetTxid(), outpoint.GetVout());
-    if (index != nullptr) *index = temp_index;
-    return true;
-  } catch (const CfdException& except) {
-    std::string errmsg(except.what());
-    if (errmsg == kErrorMessage) {
-      return false;
-    } else {
-      throw except;
-    }
-  }
+  uint32_t temp_index = 0;
+  if (!FindTxInIndex(outpoint, &temp_index)) return false;
+  if (index != nullptr) *index = temp_index;
+  return true;
 }
 
 uint32_t Psbt::GetTxInIndex(const OutPoint& outpoint) const {
+  uint32_t index = 0;
+  if (FindTxInIndex(outpoint, &index)) return index;
+  // throw the not found error.
   return base_tx_.GetTxInIndex(outpoint.GetTxid(), outpoint.GetVout());
 }
 
+bool Psbt::FindTxInIndex(const OutPoint& outpoint, uint32_t* index) const {
+  std::lock_guard<std::mutex> lock(txin_index_mutex_);
+  const struct wally_psbt* psbt_pointer =
+      static_cast<const struct wally_psbt*>(wally_psbt_pointer_);
+  if ((psbt_pointer == nullptr) || (psbt_pointer->tx == nullptr)) {
+    return false;
+  }
+  const struct wally_tx* base_tx = psbt_pointer->tx;
+  uint32_t txin_count = static_cast<uint32_t>(base_tx->num_inputs);
+  auto ite = txin_index_map_.find(outpoint);
+  if ((ite != txin_index_map_.end()) && (ite->second < txin_count) &&
+      IsMatchPsbtTxIn(base_tx->inputs[ite->second], outpoint)) {
+    *index = ite->second;
+    return true;
+  }
+  // The miss is trusted until the txin is changed.
+  // (cfd::core::Psbt::AddTxIn changes the txin count.)
+  if ((!is_txin_index_dirty_) && (txin_index_map_.size() == txin_count)) {
+    return false;
+  }
+  txin_index_map_.clear();
+  for (uint32_t txin_index = 0; txin_index < txin_count; ++txin_index) {
+    const struct wally_tx_input& input = base_tx->inputs[txin_index];
+    txin_index_map_.emplace(
+        OutPoint(
+            Txid(ByteData256(ByteData(input.txhash, sizeof(input.txhash)))),
+            input.index),
+        txin_index);
+  }
+  is_txin_index_dirty_ = false;
+  ite = txin_index_map_.find(outpoint);
+  if (ite == txin_index_map_.end()) return false;
+  *index = ite->second;
+  return true;
+}
+
+void Psbt::MarkTxInIndexDirty() {
+  std::lock_guard<std::mutex> lock(txin_index_mutex_);
+  is_txin_index_dirty_ = true;
+}
+
 void Psbt::SetTxInUtxo(
     const OutPoint& outpoint, const Transaction& tx, const KeyData& key) {
   cfd::core::Psbt::SetTxInUtxo(GetTxInIndex(outpoint), tx, key);
@@ -566,47 +1025,202 @@ void Psbt::IgnoreVerify(const OutPoint& outpoint) {
   verify_ignore_map_.emplace(outpoint);
 }
 
-void Psbt::Verify() const {
+void Psbt::Verify() const { Verify(uint32_t{1}); }
+
+void Psbt::Verify(uint32_t thread_count) const {
   if (!HasAllUtxos()) {
     warn(CFD_LOG_SOURCE, "psbt utxo not set.");
     throw CfdException(CfdError::kCfdIllegalStateError, "psbt utxo not set.");
   }
 
-  struct wally_psbt* psbt_pointer;
-  psbt_pointer = static_cast<struct wally_psbt*>(wally_psbt_pointer_);
-  uint32_t max = static_cast<uint32_t>(psbt_pointer->tx->num_inputs);
+  // The unsigned transaction and the utxos are materialized only once.
+  // The error of a target is kept at its txin index, so that the error of
+  // the first failing txin is thrown as same as the serial verify.
+  Transaction tx = GetTransaction();
+  struct VerifyTarget {
+    uint32_t index;
+    OutPoint outpoint;
+    UtxoData utxo;
+    TxIn txin;
+  };
+  uint32_t max = tx.GetTxInCount();
+  std::vector<VerifyTarget> targets;
+  std::vector<std::exception_ptr> errors(max);
+  targets.reserve(max);
   for (uint32_t index = 0; index < max; ++index) {
-    OutPoint outpoint(
-        Txid(ByteData256(ByteData(
-            psbt_pointer->tx->inputs[index].txhash,
-            sizeof(psbt_pointer->tx->inputs[index].txhash)))),
-        psbt_pointer->tx->inputs[index].index);
-    Verify(outpoint);
+    OutPoint outpoint = tx.GetTxIn(index).GetOutPoint();
+    if (verify_ignore_map_.find(outpoint) != verify_ignore_map_.end()) {
+      continue;
+    }
+    try {
+      UtxoData utxo;
+      TxIn txin = GetVerifyTxIn(tx, index, &utxo);
+      targets.push_back(VerifyTarget{index, outpoint, utxo, txin});
+    } catch (...) {
+      errors[index] = std::current_exception();
+    }
+  }
+
+  auto verify_errors = TransactionContextUtil::ParallelFor(
+      targets.size(), thread_count, 1, [&tx, &targets](size_t index) {
+        const auto& target = targets[index];
+        VerifyPsbtTxIn(
+            tx, target.index, target.outpoint, target.utxo, target.txin);
+      });
+  for (size_t index = 0; index < targets.size(); ++index) {
+    if (verify_errors[index]) {
+      errors[targets[index].index] = verify_errors[index];
+    }
+  }
+  TransactionContextUtil::RethrowFirstError(errors);
+}
+
+void Psbt::Sign(
+    const std::vector<Privkey>& privkey_list, bool has_grind_r,
+    uint32_t thread_count) {
+  struct SignTarget {
+    uint32_t index;
+    KeyData key;
+    Privkey privkey;
+    Script script_code;
+    Amount amount;
+    WitnessVersion version;
+    SigHashType sighash_type;
+    ByteData signature;
+  };
+  std::vector<Pubkey> pubkey_list;
+  pubkey_list.reserve(privkey_list.size());
+  for (const auto& privkey : privkey_list) {
+    pubkey_list.push_back(privkey.GeneratePubkey());
+  }
+
+  // The sign targets are collected once on the caller thread.
+  Transaction tx = GetTransaction();
+  std::vector<SignTarget> targets;
+  // unsupported inputs (taproot, etc) of each privkey.
+  std::vector<std::vector<std::pair<uint32_t, KeyData>>> fallback_list(
+      privkey_list.size());
+  uint32_t max = tx.GetTxInCount();
+  for (uint32_t index = 0; index < max; ++index) {
+    if (cfd::core::Psbt::IsFinalizedInput(index)) continue;
+    auto key_list = cfd::core::Psbt::GetTxInKeyDataList(index);
+    if (key_list.empty()) continue;
+
+    TxOut utxo = cfd::core::Psbt::GetTxInUtxo(index, true);
+    Script redeem_script =
+        cfd::core::Psbt::GetTxInRedeemScriptDirect(index, true, false);
+    Script witness_script =
+        cfd::core::Psbt::GetTxInRedeemScriptDirect(index, true, true);
+    SigHashType sighash_type;
+    if (cfd::core::Psbt::IsFindTxInSighashType(index)) {
+      sighash_type = cfd::core::Psbt::GetTxInSighashType(index);
+    }
+    for (const auto& key : key_list) {
+      for (size_t key_index = 0; key_index < pubkey_list.size(); ++key_index) {
+        if (!pubkey_list[key_index].Equals(key.GetPubkey())) continue;
+        SignTarget target;
+        target.index = index;
+        target.key = key;
+        target.privkey = privkey_list[key_index];
+        target.amount = utxo.GetValue();
+        target.sighash_type = sighash_type;
+        if (GetPsbtSignScriptCode(
+                utxo, redeem_script, witness_script, key.GetPubkey(),
+                &target.script_code, &target.version)) {
+          targets.push_back(target);
+        } else {
+          fallback_list[key_index].emplace_back(index, key);
+        }
+        break;
+      }
+    }
+  }
+
+  // Each thread signs its own range. The error of the lowest target index
+  // is thrown so that the result does not depend on the thread timing.
+  auto errors = TransactionContextUtil::ParallelFor(
+      targets.size(), thread_count, 1,
+      [&tx, &targets, has_grind_r](size_t index) {
+        auto& target = targets[index];
+        auto sighash = tx.GetSignatureHash(
+            target.index, target.script_code.GetData(), target.sighash_type,
+            target.amount, target.version);
+        ByteData signature = SignatureUtil::CalculateEcSignature(
+            sighash, target.privkey, has_grind_r);
+        target.signature =
+            CryptoUtil::ConvertSignatureToDer(signature, target.sighash_type);
+      });
+  TransactionContextUtil::RethrowFirstError(errors);
+
+  // The psbt is updated on the caller thread in the txin order.
+  for (const auto& target : targets) {
+    cfd::core::Psbt::SetTxInSignature(
+        target.index, target.key, target.signature);
+  }
+
+  // cfd::core::Psbt signs all inputs of the privkey, so it signs a clone
+  // that has the key paths on the unsupported inputs only.
+  for (size_t key_index = 0; key_index < privkey_list.size(); ++key_index) {
+    const auto& fallback = fallback_list[key_index];
+    if (fallback.empty()) continue;
+    Psbt sign_psbt(*this);
+    struct wally_psbt* sign_pointer =
+        static_cast<struct wally_psbt*>(sign_psbt.wally_psbt_pointer_);
+    struct wally_map empty_map;
+    memset(&empty_map, 0, sizeof(empty_map));
+    for (size_t index = 0; index < sign_pointer->num_inputs; ++index) {
+      auto ite = std::find_if(
+          fallback.begin(), fallback.end(),
+          [index](const std::pair<uint32_t, KeyData>& item) {
+            return item.first == index;
+          });
+      if (ite != fallback.end()) continue;
+      int ret = wally_psbt_input_set_keypaths(
+          &sign_pointer->inputs[index], &empty_map);
+      if (ret != WALLY_OK) {
+        warn(CFD_LOG_SOURCE, "wally_psbt_input_set_keypaths NG[{}]", ret);
+        throw CfdException(CfdError::kCfdInternalError, "psbt sign error.");
+      }
+    }
+    sign_psbt.cfd::core::Psbt::Sign(privkey_list[key_index], has_grind_r);
+    for (const auto& item : fallback) {
+      const Pubkey& pubkey = item.second.GetPubkey();
+      if (sign_psbt.cfd::core::Psbt::IsFindTxInSignature(item.first, pubkey)) {
+        cfd::core::Psbt::SetTxInSignature(
+            item.first, item.second,
+            sign_psbt.cfd::core::Psbt::GetTxInSignature(item.first, pubkey));
+      }
+    }
   }
 }
 
 void Psbt::Verify(const OutPoint& outpoint) const {
   if (verify_ignore_map_.find(outpoint) == verify_ignore_map_.end()) {
     auto tx = GetTransaction();
-    uint32_t index = GetTxInIndex(outpoint);
-    if (!IsFinalizedInput(index)) {
-      warn(CFD_LOG_SOURCE, "psbt txin not finalized yet.");
-      throw CfdException(
-          CfdError::kCfdIllegalStateError, "psbt txin not finalized yet.");
-    }
+    uint32_t index = tx.GetTxInIndex(outpoint.GetTxid(), outpoint.GetVout());
+    UtxoData utxo;
+    TxIn txin = GetVerifyTxIn(tx, index, &utxo);
+    VerifyPsbtTxIn(tx, index, outpoint, utxo, txin);
+  }
+}
 
-    UtxoData utxo = GetUtxoData(index);
-    TxIn txin(utxo.txid, utxo.vout, tx.GetTxIn(index).GetSequence());
-    ByteData scriptsig = cfd::core::Psbt::GetTxInFinalScript(index, false)[0];
-    if (!scriptsig.IsEmpty()) txin.SetUnlockingScript(Script(scriptsig));
-    auto witness_stack = cfd::core::Psbt::GetTxInFinalScript(index, true);
-    for (const auto& stack : witness_stack) {
-      txin.AddScriptWitnessStack(stack);
-    }
+TxIn Psbt::GetVerifyTxIn(
+    const Transaction& tx, uint32_t index, UtxoData* utxo) const {
+  if (!IsFinalizedInput(index)) {
+    warn(CFD_LOG_SOURCE, "psbt txin not finalized yet.");
+    throw CfdException(
+        CfdError::kCfdIllegalStateError, "psbt txin not finalized yet.");
+  }
 
-    TransactionContextUtil::Verify<Transaction>(
-        &tx, outpoint, utxo, &txin, CollectSighashByTx);
+  *utxo = GetUtxoData(index);
+  TxIn txin(utxo->txid, utxo->vout, tx.GetTxIn(index).GetSequence());
+  ByteData scriptsig = cfd::core::Psbt::GetTxInFinalScript(index, false)[0];
+  if (!scriptsig.IsEmpty()) txin.SetUnlockingScript(Script(scriptsig));
+  auto witness_stack = cfd::core::Psbt::GetTxInFinalScript(index, true);
+  for (const auto& stack : witness_stack) {
+    txin.AddScriptWitnessStack(stack);
   }
+  return txin;
 }
 
 std::vector<UtxoData> Psbt::FundTransaction(
@@ -648,51 +1262,29 @@ std::vector<UtxoData> Psbt::FundTransaction(
     }
     reserve_txout_address = ref.GenerateAddress(net_type).GetAddress();
   }
-  cfd::api::TransactionApi api;
-  std::vector<std::string> append_txout_addresses;
-  // TODO(k-matsuzawa) move to TransactionContext
-  auto fund_tx = api.FundRawTransaction(
-      base_tx_.GetHex(), witness_utxos, Amount(), input_utxos,
-      reserve_txout_address, effective_fee_rate, estimate_fee, filter,
-      option_params, &append_txout_addresses, net_type);
-  auto fund_basetx = fund_tx.GetTransaction();
-
-  std::vector<UtxoData> append_utxos;
-  if (base_tx_.GetTxInCount() < fund_basetx.GetTxInCount()) {
-    auto txin_list = fund_basetx.GetTxInList();
-    for (const auto& txin : txin_list) {
-      if (!IsFindTxIn(txin.GetOutPoint())) {
-        auto outpoint = txin.GetOutPoint();
-        for (const auto& utxo : witness_utxos) {
-          if ((utxo.vout == outpoint.GetVout()) &&
-              (utxo.txid.Equals(outpoint.GetTxid()))) {
-            append_utxos.push_back(utxo);
-            break;
-          }
-        }
-      }
-    }
-  }
-  if (base_tx_.GetTxOutCount() < fund_basetx.GetTxOutCount()) {
-    if ((fund_basetx.GetTxOutCount() - base_tx_.GetTxOutCount()) > 1) {
+  Address reserve_address =
+      cfd::AddressFactory(net_type).GetAddress(reserve_txout_address);
+  struct wally_psbt* psbt_pointer;
+  psbt_pointer = static_cast<struct wally_psbt*>(wally_psbt_pointer_);
+  TransactionContext fund_tx(base_tx_.GetVersion(), base_tx_.GetLockTime());
+  AddPsbtBaseTxToContext(psbt_pointer->tx, &fund_tx);
+  auto append_utxos = fund_tx.Fund(
+      witness_utxos, Amount(), input_utxos, reserve_address,
+      effective_fee_rate, estimate_fee, filter, option_params);
+
+  if (base_tx_.GetTxOutCount() < fund_tx.GetTxOutCount()) {
+    if ((fund_tx.GetTxOutCount() - base_tx_.GetTxOutCount()) > 1) {
       warn(
           CFD_LOG_SOURCE, "psbt txout count invalid. [{},{}]",
-          fund_basetx.GetTxOutCount(), base_tx_.GetTxOutCount());
+          fund_tx.GetTxOutCount(), base_tx_.GetTxOutCount());
       throw CfdException(
           CfdError::kCfdInternalError, "psbt txout count invalid.");
     }
-    if (append_txout_addresses.size() != 1) {
-      warn(
-          CFD_LOG_SOURCE, "psbt txout append address invalid. [{}]",
-          append_txout_addresses.size());
-      throw CfdException(
-          CfdError::kCfdInternalError, "psbt txout append address invalid.");
-    }
     if (change_address != nullptr) {
       std::vector<KeyData> key_list;
       cfd::DescriptorScriptData script_data =
           ParseDescriptor(change_address->ToString(), &key_list, &net_type);
-      auto txout = fund_basetx.GetTxOut(base_tx_.GetTxOutCount());
+      auto txout = fund_tx.GetTxOut(base_tx_.GetTxOutCount());
       if (!script_data.locking_script.Equals(txout.GetLockingScript())) {
         warn(
             CFD_LOG_SOURCE, "psbt txout append locking script invalid. [{}]",
@@ -930,4 +1522,124 @@ std::vector<UtxoData> Psbt::GetUtxoDataAll(NetType net_type) const {
   return list;
 }
 
+std::vector<UtxoData> Psbt::DecodeUtxoDataByStream(
+    std::istream* stream, NetType net_type) {
+  static constexpr uint8_t kPsbtMagic[] = {0x70, 0x73, 0x62, 0x74, 0xff};
+  static constexpr uint8_t kPsbtGlobalUnsignedTx = 0x00;
+  static constexpr uint8_t kPsbtGlobalInputCount = 0x04;
+  static constexpr uint8_t kPsbtInNonWitnessUtxo = 0x00;
+  static constexpr uint8_t kPsbtInWitnessUtxo = 0x01;
+  static constexpr uint8_t kPsbtInPreviousTxid = 0x0e;
+  static constexpr uint8_t kPsbtInOutputIndex = 0x0f;
+  if (stream == nullptr) {
+    warn(CFD_LOG_SOURCE, "stream is null.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError,
+        "Failed to parameter. stream is null.");
+  }
+
+  auto magic = ReadPsbtStreamBytes(stream, sizeof(kPsbtMagic));
+  if (!std::equal(magic.begin(), magic.end(), kPsbtMagic)) {
+    ThrowPsbtStreamError("invalid magic.");
+  }
+
+  // global map (only the outpoints are kept from the unsigned tx)
+  std::vector<OutPoint> outpoints;
+  bool has_unsigned_tx = false;
+  bool has_input_count = false;
+  uint64_t input_count = 0;
+  std::vector<uint8_t> key;
+  while (ReadPsbtStreamKey(stream, &key)) {
+    uint64_t value_size = ReadPsbtStreamCompactSize(stream);
+    if ((key.size() == 1) && (key[0] == kPsbtGlobalUnsignedTx)) {
+      Transaction tx(ByteData(ReadPsbtStreamBytes(stream, value_size)));
+      for (const auto& txin : tx.GetTxInList()) {
+        outpoints.emplace_back(txin.GetOutPoint());
+      }
+      has_unsigned_tx = true;
+    } else if ((key.size() == 1) && (key[0] == kPsbtGlobalInputCount)) {
+      size_t offset = 0;
+      input_count = ReadPsbtCompactSize(
+          ReadPsbtStreamBytes(stream, value_size), &offset);
+      has_input_count = true;
+    } else {
+      SkipPsbtStreamBytes(stream, value_size);
+    }
+  }
+  if (has_unsigned_tx) {
+    input_count = outpoints.size();
+  } else if (!has_input_count) {
+    ThrowPsbtStreamError("input count not found.");
+  }
+
+  // input map
+  std::vector<UtxoData> list;
+  for (uint64_t index = 0; index < input_count; ++index) {
+    UtxoData utxo;
+    utxo.block_height = 0;
+    utxo.address_type = AddressType::kP2shAddress;
+    bool has_outpoint = has_unsigned_tx;
+    bool has_txid = has_unsigned_tx;
+    Txid txid;
+    uint32_t vout = 0;
+    if (has_outpoint) {
+      txid = outpoints[static_cast<size_t>(index)].GetTxid();
+      vout = outpoints[static_cast<size_t>(index)].GetVout();
+    }
+    // psbtv2 outpoint record is after the non witness utxo record.
+    std::vector<uint8_t> pending_utxo;
+    while (ReadPsbtStreamKey(stream, &key)) {
+      uint64_t value_size = ReadPsbtStreamCompactSize(stream);
+      if ((key.size() == 1) && (key[0] == kPsbtInNonWitnessUtxo)) {
+        auto value = ReadPsbtStreamBytes(stream, value_size);
+        if (has_outpoint) {
+          ExtractPsbtStreamNonWitnessUtxo(value, OutPoint(txid, vout), &utxo);
+        } else {
+          pending_utxo.swap(value);
+        }
+      } else if ((key.size() == 1) && (key[0] == kPsbtInWitnessUtxo)) {
+        ExtractPsbtStreamWitnessUtxo(
+            ReadPsbtStreamBytes(stream, value_size), &utxo);
+      } else if (
+          (key.size() == 1) && (key[0] == kPsbtInPreviousTxid) &&
+          (!has_unsigned_tx)) {
+        if (value_size != 32) ThrowPsbtStreamError("invalid previous txid.");
+        txid = Txid(ByteData256(ReadPsbtStreamBytes(stream, value_size)));
+        has_txid = true;
+      } else if (
+          (key.size() == 1) && (key[0] == kPsbtInOutputIndex) &&
+          (!has_unsigned_tx)) {
+        if (value_size != 4) ThrowPsbtStreamError("invalid output index.");
+        auto value = ReadPsbtStreamBytes(stream, value_size);
+        vout = static_cast<uint32_t>(value[0]) |
+               (static_cast<uint32_t>(value[1]) << 8) |
+               (static_cast<uint32_t>(value[2]) << 16) |
+               (static_cast<uint32_t>(value[3]) << 24);
+        has_outpoint = true;
+      } else {
+        SkipPsbtStreamBytes(stream, value_size);
+      }
+    }
+    if (!has_txid) ThrowPsbtStreamError("previous txid not found.");
+    if (!has_outpoint) ThrowPsbtStreamError("outpoint not found.");
+    if (!pending_utxo.empty()) {
+      ExtractPsbtStreamNonWitnessUtxo(
+          pending_utxo, OutPoint(txid, vout), &utxo);
+    }
+    utxo.txid = txid;
+    utxo.vout = vout;
+
+    const Script& locking_script = utxo.locking_script;
+    if (locking_script.IsP2pkhScript() || locking_script.IsP2shScript() ||
+        locking_script.IsP2wpkhScript() || locking_script.IsP2wshScript() ||
+        locking_script.IsTaprootScript()) {
+      AddressFactory address_factory(net_type);
+      utxo.address = address_factory.GetAddressByLockingScript(locking_script);
+      utxo.address_type = utxo.address.GetAddressType();
+    }
+    list.push_back(utxo);
+  }
+  return list;
+}
+
 }  // namespace cfd
@@ -7,11 +7,17 @@
 #include "cfd/cfd_transaction.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <map>
+#include <mutex>  // NOLINT
+#include <set>
 #include <string>
 #include <vector>
 
 #include "cfd/cfd_address.h"
+#include "cfd/cfd_fee.h"
+#include "cfd/cfd_utxo.h"
 #include "cfd_transaction_internal.h"  // NOLINT
 #include "cfdcore/cfdcore_address.h"
 #include "cfdcore/cfdcore_amount.h"
@@ -24,6 +30,7 @@
 #include "cfdcore/cfdcore_script.h"
 #include "cfdcore/cfdcore_taproot.h"
 #include "cfdcore/cfdcore_transaction.h"
+#include "wally_transaction.h"  // NOLINT
 
 namespace cfd {
 
@@ -56,6 +63,7 @@ using cfd::core::TxIn;
 using cfd::core::TxInReference;
 using cfd::core::TxOut;
 using cfd::core::TxOutReference;
+using cfd::core::logger::info;
 using cfd::core::logger::warn;
 
 using cfd::TransactionController;
@@ -119,6 +127,175 @@ static Script GetLockingScriptFromUtxoData(const UtxoData& utxo) {
   return locking_script;
 }
 
+/**
+ * @brief Estimated txin size of utxo.
+ */
+struct TxInSizeData {
+  uint32_t size;          //!< txin size (excluding witness)
+  uint32_t witness_size;  //!< witness size
+  bool is_estimated;      //!< estimated flag
+};
+
+/**
+ * @brief Estimate txin size from utxo.
+ * @param[in] utxo    utxo data.
+ * @return txin size
+ */
+static TxInSizeData EstimateTxInSizeByUtxo(const UtxoData& utxo) {
+  NetType net_type = NetType::kMainnet;
+  if (!utxo.address.GetAddress().empty()) {
+    net_type = utxo.address.GetNetType();
+  }
+  AddressFactory address_factory(net_type);
+  // check descriptor
+  std::string descriptor = utxo.descriptor;
+  // set dummy NetType for getting AddressType.
+  auto data = address_factory.ParseOutputDescriptor(descriptor);
+
+  AddressType addr_type;
+  if (utxo.address.GetAddress().empty() ||
+      data.address_type == AddressType::kP2shP2wpkhAddress ||
+      data.address_type == AddressType::kP2shP2wshAddress) {
+    addr_type = data.address_type;
+  } else {
+    addr_type = utxo.address.GetAddressType();
+  }
+
+  Script redeem_script;
+  if (utxo.redeem_script.IsEmpty() && !data.redeem_script.IsEmpty()) {
+    redeem_script = data.redeem_script;
+  } else {
+    redeem_script = utxo.redeem_script;
+  }
+  const Script* scriptsig_template = nullptr;
+  if (((!redeem_script.IsEmpty()) ||
+       (addr_type == AddressType::kTaprootAddress)) &&
+      (!utxo.scriptsig_template.IsEmpty())) {
+    scriptsig_template = &utxo.scriptsig_template;
+  }
+
+  TxInSizeData result = {0, 0, true};
+  TxIn::EstimateTxInSize(
+      addr_type, redeem_script, &result.witness_size, &result.size,
+      scriptsig_template);
+  return result;
+}
+
+/**
+ * @brief Estimate fee from the transaction and txin size list.
+ * @param[in] txc                 transaction context.
+ * @param[in] txin_sizes          txin size list.
+ * @param[out] txout_fee          tx fee amount (ignore utxo)
+ * @param[out] utxo_fee           utxo fee amount
+ * @param[in] effective_fee_rate  effective fee rate (minimum)
+ * @return tx fee (contains utxo)
+ */
+static Amount EstimateFeeByTxInSize(
+    const TransactionContext& txc, const std::vector<TxInSizeData>& txin_sizes,
+    Amount* txout_fee, Amount* utxo_fee, double effective_fee_rate) {
+  uint32_t size = 0;
+  uint32_t witness_size = 0;
+  uint32_t not_witness_count = 0;
+  for (const auto& txin_size : txin_sizes) {
+    size += txin_size.size;
+    witness_size += txin_size.witness_size;
+    if (txin_size.witness_size == 0) ++not_witness_count;
+  }
+
+  uint32_t tx_size = txc.GetSizeIgnoreTxIn((witness_size != 0));
+  uint32_t tx_vsize = AbstractTransaction::GetVsizeFromSize(tx_size, 0);
+
+  if ((witness_size != 0) && (not_witness_count != 0) &&
+      (not_witness_count < static_cast<uint32_t>(txin_sizes.size()))) {
+    // append witness size for p2pkh or p2sh
+    witness_size += not_witness_count;
+  }
+
+  uint32_t utxo_vsize =
+      AbstractTransaction::GetVsizeFromSize(size, witness_size);
+
+  uint64_t fee_rate = static_cast<uint64_t>(floor(effective_fee_rate * 1000));
+  FeeCalculator fee_calc(fee_rate);
+  Amount tx_fee_amount = fee_calc.GetFee(tx_vsize);
+  Amount utxo_fee_amount = fee_calc.GetFee(utxo_vsize);
+  uint32_t total_size = tx_size + size;
+  uint32_t total_vsize =
+      AbstractTransaction::GetVsizeFromSize(total_size, witness_size);
+  Amount fee = fee_calc.GetFee(total_vsize);
+
+  if (txout_fee) *txout_fee = tx_fee_amount;
+  if (utxo_fee) *utxo_fee = utxo_fee_amount;
+
+  info(
+      CFD_LOG_SOURCE, "EstimateFee rate={} fee={} tx={} utxo={}",
+      effective_fee_rate, fee.GetSatoshiValue(),
+      tx_fee_amount.GetSatoshiValue(), utxo_fee_amount.GetSatoshiValue());
+  return fee;
+}
+
+/**
+ * @brief Estimate the signed weight from the transaction and txin size list.
+ * @param[in] txc                 transaction context.
+ * @param[in] txin_sizes          txin size list.
+ * @return weight
+ */
+static uint32_t EstimateWeightByTxInSize(
+    const TransactionContext& txc,
+    const std::vector<TxInSizeData>& txin_sizes) {
+  uint32_t size = 0;
+  uint32_t witness_size = 0;
+  uint32_t not_witness_count = 0;
+  for (const auto& txin_size : txin_sizes) {
+    size += txin_size.size;
+    witness_size += txin_size.witness_size;
+    if (txin_size.witness_size == 0) ++not_witness_count;
+  }
+  uint32_t tx_size = txc.GetSizeIgnoreTxIn(false);
+  if (witness_size != 0) {
+    // marker, flag, and the empty witness of p2pkh or p2sh.
+    witness_size += 2 + not_witness_count;
+  }
+  return ((tx_size + size) * 4) + witness_size;
+}
+
+/**
+ * @brief copy the txin and txout of the transaction.
+ * @details copy the structure directly. (without serialize and parse)
+ * @param[in] source        source transaction
+ * @param[out] destination  destination transaction (empty txin and txout)
+ */
+static void CopyTxInOut(
+    const Transaction& source, TransactionContext* destination) {
+  uint32_t txin_count = source.GetTxInCount();
+  for (uint32_t index = 0; index < txin_count; ++index) {
+    const TxInReference txin = source.GetTxIn(index);
+    destination->AddTxIn(
+        txin.GetTxid(), txin.GetVout(), txin.GetSequence(),
+        txin.GetUnlockingScript());
+    for (const auto& stack : txin.GetScriptWitness().GetWitness()) {
+      destination->AddScriptWitnessStack(index, stack);
+    }
+  }
+  uint32_t txout_count = source.GetTxOutCount();
+  for (uint32_t index = 0; index < txout_count; ++index) {
+    const TxOutReference txout = source.GetTxOut(index);
+    destination->AddTxOut(txout.GetValue(), txout.GetLockingScript());
+  }
+}
+
+/**
+ * @brief utxo pool data for funding.
+ */
+struct TransactionContext::FundingPool {
+  std::vector<UtxoData> txin_utxos;           //!< utxo list matched to txin
+  std::vector<TxInSizeData> txin_sizes;       //!< txin size list of txin_utxos
+  Amount txin_amount;                         //!< total amount of txin_utxos
+  std::vector<UtxoData> utxos;                //!< candidate utxo list
+  std::vector<TxInSizeData> utxo_sizes;       //!< txin size cache of utxos
+  std::vector<Utxo> coins;                    //!< candidate coin list
+  std::map<OutPoint, size_t> utxo_index_map;  //!< outpoint to utxos index
+};
+
 // -----------------------------------------------------------------------------
 // TransactionController
 // -----------------------------------------------------------------------------
@@ -146,7 +323,7 @@ TransactionContext::TransactionContext(const std::string& tx_hex)
 }
 
 TransactionContext::TransactionContext(const ByteData& byte_data)
-    : Transaction(byte_data.GetHex()) {
+    : Transaction(byte_data) {
   utxo_map_.clear();
   signed_map_.clear();
   verify_map_.clear();
@@ -154,7 +331,8 @@ TransactionContext::TransactionContext(const ByteData& byte_data)
 }
 
 TransactionContext::TransactionContext(const TransactionContext& context)
-    : Transaction(context.GetHex()) {
+    : Transaction(context.GetVersion(), context.GetLockTime()) {
+  CopyTxInOut(context, this);
   utxo_map_ = context.utxo_map_;
   signed_map_ = context.signed_map_;
   verify_map_ = context.verify_map_;
@@ -162,12 +340,18 @@ TransactionContext::TransactionContext(const TransactionContext& context)
 }
 
 TransactionContext::TransactionContext(const Transaction& transaction)
-    : Transaction(transaction.GetHex()) {}
+    : Transaction(transaction.GetVersion(), transaction.GetLockTime()) {
+  CopyTxInOut(transaction, this);
+}
 
 TransactionContext& TransactionContext::operator=(
     const TransactionContext& context) & {
   if (this != &context) {
-    SetFromHex(context.GetHex());
+    // reset to the empty transaction, and copy the structure directly.
+    SetFromHex(
+        Transaction(context.GetVersion(), context.GetLockTime()).GetHex());
+    CopyTxInOut(context, this);
+    MarkTxInIndexDirty();
     utxo_map_ = context.utxo_map_;
     signed_map_ = context.signed_map_;
     verify_map_ = context.verify_map_;
@@ -176,7 +360,34 @@ TransactionContext& TransactionContext::operator=(
   return *this;
 }
 
+size_t TransactionContext::CopyData(uint8_t* buffer, size_t buffer_size) const {
+  const struct wally_tx* tx_pointer =
+      static_cast<const struct wally_tx*>(wally_tx_pointer_);
+  // the witness flag is ignored when no witness exists.
+  uint32_t flag = WALLY_TX_FLAG_USE_WITNESS;
+  size_t size = 0;
+  int ret = wally_tx_get_length(tx_pointer, flag, &size);
+  if (ret != WALLY_OK) {
+    warn(CFD_LOG_SOURCE, "wally_tx_get_length NG[{}].", ret);
+    throw CfdException(
+        CfdError::kCfdIllegalStateError, "tx length calc error.");
+  }
+  if ((buffer == nullptr) || (buffer_size < size)) return size;
+
+  size_t written = 0;
+  ret = wally_tx_to_bytes(tx_pointer, flag, buffer, buffer_size, &written);
+  if ((ret != WALLY_OK) || (written != size)) {
+    warn(CFD_LOG_SOURCE, "wally_tx_to_bytes NG[{}].", ret);
+    throw CfdException(
+        CfdError::kCfdIllegalStateError, "tx serialize error.");
+  }
+  return size;
+}
+
 uint32_t TransactionContext::GetTxInIndex(const OutPoint& outpoint) const {
+  uint32_t index = 0;
+  if (FindTxInIndex(outpoint, &index)) return index;
+  // throw the not found error.
   return GetTxInIndex(outpoint.GetTxid(), outpoint.GetVout());
 }
 
@@ -187,24 +398,19 @@ uint32_t TransactionContext::AddTxIn(const OutPoint& outpoint) {
 }
 
 uint32_t TransactionContext::GetTxOutIndex(const Address& address) const {
-  return GetTxOutIndex(address.GetLockingScript());
+  uint32_t index = 0;
+  const Script locking_script = address.GetLockingScript();
+  if (FindTxOutIndex(locking_script, &index)) return index;
+  // throw the not found error.
+  return GetTxOutIndex(locking_script);
 }
 
 bool TransactionContext::IsFindTxIn(
     const OutPoint& outpoint, uint32_t* index) const {
-  static constexpr const char* const kErrorMessage = "Txid is not found.";
-  try {
-    uint32_t temp_index = GetTxInIndex(outpoint);
-    if (index != nullptr) *index = temp_index;
-    return true;
-  } catch (const CfdException& except) {
-    std::string errmsg(except.what());
-    if (errmsg == kErrorMessage) {
-      return false;
-    } else {
-      throw except;
-    }
-  }
+  uint32_t temp_index = 0;
+  if (!FindTxInIndex(outpoint, &temp_index)) return false;
+  if (index != nullptr) *index = temp_index;
+  return true;
 }
 
 bool TransactionContext::IsFindTxOut(
@@ -219,36 +425,34 @@ bool TransactionContext::IsFindTxOut(
     if ((index != nullptr) && (!indexes->empty())) *index = (*indexes)[0];
     return !indexes->empty();
   }
-  try {
-    uint32_t temp_index = GetTxOutIndex(locking_script);
-    if (index != nullptr) *index = temp_index;
-    return true;
-  } catch (const CfdException& except) {
-    if (except.GetErrorCode() == CfdError::kCfdIllegalArgumentError) {
-      return false;
-    } else {
-      throw except;
-    }
-  }
+  uint32_t temp_index = 0;
+  if (!FindTxOutIndex(locking_script, &temp_index)) return false;
+  if (index != nullptr) *index = temp_index;
+  return true;
 }
 
 bool TransactionContext::IsFindTxOut(
     const Address& address, uint32_t* index,
     std::vector<uint32_t>* indexes) const {
-  if (indexes != nullptr) {
-    return IsFindTxOut(address.GetLockingScript(), index, indexes);
-  }
-  try {
-    uint32_t temp_index = GetTxOutIndex(address);
-    if (index != nullptr) *index = temp_index;
-    return true;
-  } catch (const CfdException& except) {
-    if (except.GetErrorCode() == CfdError::kCfdIllegalArgumentError) {
-      return false;
-    } else {
-      throw except;
+  return IsFindTxOut(address.GetLockingScript(), index, indexes);
+}
+
+bool TransactionContext::FindTxInIndex(
+    const OutPoint& outpoint, uint32_t* index) const {
+  std::lock_guard<std::mutex> lock(txin_index_mutex_);
+  return TransactionContextUtil::FindTxInIndex(
+      vin_, outpoint, &txin_index_map_, &is_txin_index_dirty_, index);
+}
+
+bool TransactionContext::FindTxOutIndex(
+    const Script& locking_script, uint32_t* index) const {
+  for (uint32_t idx = 0; idx < static_cast<uint32_t>(vout_.size()); ++idx) {
+    if (locking_script.Equals(vout_[idx].GetLockingScript())) {
+      *index = idx;
+      return true;
     }
   }
+  return false;
 }
 
 const TxInReference TransactionContext::GetTxIn(
@@ -289,6 +493,244 @@ uint32_t TransactionContext::GetVsizeIgnoreTxIn(bool use_witness) const {
       GetSizeIgnoreTxIn(use_witness), 0);
 }
 
+Amount TransactionContext::EstimateFee(
+    const std::vector<UtxoData>& utxos, Amount* txout_fee, Amount* utxo_fee,
+    double effective_fee_rate) const {
+  std::vector<TxInSizeData> txin_sizes;
+  txin_sizes.reserve(utxos.size());
+  for (const auto& utxo : utxos) {
+    txin_sizes.push_back(EstimateTxInSizeByUtxo(utxo));
+  }
+  return EstimateFeeByTxInSize(
+      *this, txin_sizes, txout_fee, utxo_fee, effective_fee_rate);
+}
+
+std::vector<UtxoData> TransactionContext::Fund(
+    const std::vector<UtxoData>& utxos, const Amount& target_value,
+    const std::vector<UtxoData>& selected_txin_utxos,
+    const Address& reserve_address, double effective_fee_rate,
+    Amount* estimate_fee, const UtxoFilter* filter,
+    const CoinSelectionOption* option_params, Amount* calculate_fee) {
+  // set option
+  CoinSelectionOption option;
+  UtxoFilter utxo_filter;
+  if (filter) utxo_filter = *filter;
+  if (option_params) {
+    option = *option_params;
+  } else {
+    option.InitializeTxSizeInfo();
+    option.SetEffectiveFeeBaserate(effective_fee_rate);
+    option.SetLongTermFeeBaserate(effective_fee_rate);
+  }
+
+  FundingPool pool;
+  CollectFundingPool(utxos, selected_txin_utxos, &pool);
+  return FundByPool(
+      &pool, target_value, reserve_address, effective_fee_rate, utxo_filter,
+      option, estimate_fee, calculate_fee);
+}
+
+std::vector<TransactionContext> TransactionContext::FundByFeeRates(
+    const std::vector<UtxoData>& utxos, const Amount& target_value,
+    const std::vector<UtxoData>& selected_txin_utxos,
+    const Address& reserve_address, const std::vector<double>& fee_rates,
+    std::vector<Amount>* estimate_fees, const UtxoFilter* filter,
+    const CoinSelectionOption* option_params) const {
+  CoinSelectionOption base_option;
+  UtxoFilter utxo_filter;
+  if (filter) utxo_filter = *filter;
+  if (option_params) {
+    base_option = *option_params;
+  } else {
+    base_option.InitializeTxSizeInfo();
+  }
+
+  // The utxo pool and the txin size cache are shared by all fee rates.
+  FundingPool pool;
+  CollectFundingPool(utxos, selected_txin_utxos, &pool);
+
+  std::vector<TransactionContext> result;
+  result.reserve(fee_rates.size());
+  if (estimate_fees != nullptr) {
+    estimate_fees->clear();
+    estimate_fees->reserve(fee_rates.size());
+  }
+  for (const double fee_rate : fee_rates) {
+    CoinSelectionOption option = base_option;
+    option.SetEffectiveFeeBaserate(fee_rate);
+    if (option_params == nullptr) option.SetLongTermFeeBaserate(fee_rate);
+
+    result.emplace_back(*this);
+    Amount fee;
+    result.back().FundByPool(
+        &pool, target_value, reserve_address, fee_rate, utxo_filter, option,
+        &fee, nullptr);
+    if (estimate_fees != nullptr) estimate_fees->push_back(fee);
+  }
+  return result;
+}
+
+void TransactionContext::CollectFundingPool(
+    const std::vector<UtxoData>& utxos,
+    const std::vector<UtxoData>& selected_txin_utxos,
+    FundingPool* pool) const {
+  // collect the amount of the registered TxIn.
+  // (selected_txin_utxos is treated as registered utxo if the txid matches)
+  uint32_t txin_index = 0;
+  pool->txin_utxos.reserve(selected_txin_utxos.size());
+  for (const auto& utxo : selected_txin_utxos) {
+    if (FindTxInIndex(OutPoint(utxo.txid, utxo.vout), &txin_index)) {
+      pool->txin_amount += utxo.amount;
+      pool->txin_utxos.push_back(utxo);
+      pool->txin_sizes.push_back(EstimateTxInSizeByUtxo(utxo));
+    }
+  }
+
+  pool->utxos.reserve(utxos.size());
+  for (const auto& utxo : utxos) {
+    OutPoint outpoint(utxo.txid, utxo.vout);
+    if (!FindTxInIndex(outpoint, &txin_index)) {
+      pool->utxo_index_map.emplace(outpoint, pool->utxos.size());
+      pool->utxos.push_back(utxo);
+    }
+  }
+  // converted on the calling thread. (the caller may be a worker thread)
+  pool->coins = UtxoUtil::ConvertToUtxo(pool->utxos);
+  // The txin size of the candidate is estimated when it is selected.
+  TxInSizeData empty_size = {0, 0, false};
+  pool->utxo_sizes.assign(pool->utxos.size(), empty_size);
+}
+
+std::vector<UtxoData> TransactionContext::FundByPool(
+    FundingPool* pool, const Amount& target_value,
+    const Address& reserve_address, double effective_fee_rate,
+    const UtxoFilter& utxo_filter, const CoinSelectionOption& option,
+    Amount* estimate_fee, Amount* calculate_fee) {
+  const Amount& txin_amount = pool->txin_amount;
+  Amount txout_amount;
+  for (const auto& txout : vout_) {
+    txout_amount += txout.GetValue();
+  }
+
+  Amount fee;
+  if (option.GetEffectiveFeeBaserate() != 0) {
+    fee = EstimateFeeByTxInSize(
+        *this, pool->txin_sizes, nullptr, nullptr, effective_fee_rate);
+    info(
+        CFD_LOG_SOURCE, "Fund: pre estimation fee=[{}]",
+        fee.GetSatoshiValue());
+  }
+
+  Amount diff_amount = Amount();        // difference between input and output
+  Amount target_amount = target_value;  // selection require amount
+  if (txin_amount > txout_amount) {
+    // surplus of txin
+    diff_amount = txin_amount - txout_amount;
+    if (diff_amount < target_amount) {
+      // coin select the shortfall that the surplus of txin does not meet.
+      target_amount -= diff_amount;
+    }
+  } else if (txin_amount < txout_amount) {
+    // shortage of txout
+    diff_amount = txout_amount - txin_amount;
+    target_amount += diff_amount;
+  }
+
+  // execute coinselection
+  Amount txin_total_amount = txin_amount;
+  std::vector<Utxo> selected_coins;
+  if (target_amount > 0 || fee > 0) {
+    info(
+        CFD_LOG_SOURCE, "Fund:CoinSelection: target_amount=[{}]",
+        target_amount.GetSatoshiValue());
+    CoinSelection coin_select;
+    selected_coins = coin_select.SelectCoins(
+        target_amount, pool->coins, utxo_filter, option, fee,
+        &txin_total_amount, nullptr, nullptr);
+    txin_total_amount += txin_amount;
+    info(
+        CFD_LOG_SOURCE, "Fund: txin_total_amount=[{}]",
+        txin_total_amount.GetSatoshiValue());
+    if (txin_total_amount < target_amount) {
+      warn(CFD_LOG_SOURCE, "Failed to FundRawTransaction. low BTC.");
+      throw CfdException(CfdError::kCfdIllegalArgumentError, "low BTC.");
+    }
+  }
+
+  // collect the utxo data of the selected coins.
+  std::vector<uint8_t> txid_bytes(cfd::core::kByteData256Length);
+  std::vector<UtxoData> append_utxos;
+  std::vector<TxInSizeData> new_selected_sizes = pool->txin_sizes;
+  append_utxos.reserve(selected_coins.size());
+  for (const Utxo& coin : selected_coins) {
+    memcpy(txid_bytes.data(), coin.txid, txid_bytes.size());
+    auto ite = pool->utxo_index_map.find(
+        OutPoint(Txid(ByteData256(txid_bytes)), coin.vout));
+    if (ite == pool->utxo_index_map.end()) continue;
+    const UtxoData& utxo = pool->utxos[ite->second];
+    TxInSizeData& txin_size = pool->utxo_sizes[ite->second];
+    if (!txin_size.is_estimated) {
+      txin_size = EstimateTxInSizeByUtxo(utxo);
+    }
+    new_selected_sizes.push_back(txin_size);
+    append_utxos.push_back(utxo);
+  }
+
+  Amount dust_amount = option.GetDustFeeAmount(reserve_address);
+  info(
+      CFD_LOG_SOURCE, "Fund: dust_amount=[{}]", dust_amount.GetSatoshiValue());
+
+  // selected + txin - txout = new txout amount
+  Amount new_txout_amount = txin_total_amount - txout_amount;
+  int64_t new_txout_satoshi = new_txout_amount.GetSatoshiValue();
+  // When the total of txin exceeds txout, the change txout is added.
+  // Therefore, re-calculate the fee.
+  if (option.GetEffectiveFeeBaserate() > 0) {
+    Amount need_amount = txout_amount + fee;
+    Amount check_amount = txin_total_amount - dust_amount;
+    if (check_amount > need_amount) {
+      // estimate with the change txout temporarily. (amount is dummy)
+      uint32_t dummy_index = AddTxOut(reserve_address, fee);
+      fee = EstimateFeeByTxInSize(
+          *this, new_selected_sizes, nullptr, nullptr, effective_fee_rate);
+      RemoveTxOut(dummy_index);
+      info(CFD_LOG_SOURCE, "Fund: new_fee={}", fee.GetSatoshiValue());
+    }
+
+    new_txout_amount -= fee;  // exclude fee from new txout amount
+    new_txout_satoshi = new_txout_amount.GetSatoshiValue();
+
+    if (txin_total_amount < new_txout_amount) {
+      warn(CFD_LOG_SOURCE, "Failed to FundRawTransaction. low fee.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError,
+          "Failed to FundRawTransaction. low fee.");
+    }
+
+    if (calculate_fee != nullptr) *calculate_fee = fee;
+    if (dust_amount > new_txout_amount) {
+      // set all the remaining amount to fee.
+      new_txout_satoshi = 0;
+      fee = txin_total_amount - new_txout_amount;
+    }
+    info(CFD_LOG_SOURCE, "Fund: new_txout_amount={}", new_txout_satoshi);
+  }
+
+  // dust amount is not added to txout.
+  if ((new_txout_satoshi != 0) && (dust_amount < new_txout_amount)) {
+    AddTxOut(reserve_address, new_txout_amount);
+    info(
+        CFD_LOG_SOURCE, "Fund:AddTxOut: value=[{}]",
+        new_txout_amount.GetSatoshiValue());
+  }
+  if (estimate_fee) *estimate_fee = fee;
+
+  for (const auto& utxo : append_utxos) {
+    AddTxIn(OutPoint(utxo.txid, utxo.vout));
+  }
+  return append_utxos;
+}
+
 void TransactionContext::AddInput(const UtxoData& utxo) {
   AddInput(utxo, GetDefaultSequence());
 }
@@ -317,23 +759,30 @@ void TransactionContext::AddInputs(const std::vector<UtxoData>& utxos) {
 
 void TransactionContext::CollectInputUtxo(const std::vector<UtxoData>& utxos) {
   if ((!utxos.empty()) && (utxo_map_.size() != GetTxInCount())) {
+    std::set<OutPoint> collected_outpoints;
+    for (const auto& utxo_data : utxo_map_) {
+      collected_outpoints.emplace(utxo_data.txid, utxo_data.vout);
+    }
+    // first utxo is used on the same outpoint.
+    std::map<OutPoint, const UtxoData*> utxo_index_map;
+    for (const auto& utxo : utxos) {
+      utxo_index_map.emplace(OutPoint(utxo.txid, utxo.vout), &utxo);
+    }
+
     for (const auto& txin_ref : vin_) {
-      const Txid& txid = txin_ref.GetTxid();
-      uint32_t vout = txin_ref.GetVout();
-
-      OutPoint outpoint(txid, vout);
-      if (!IsFindUtxoMap(outpoint)) {
-        for (const auto& utxo : utxos) {
-          if ((utxo.vout == vout) && utxo.txid.Equals(txid)) {
-            UtxoData dest;
-            Utxo temp;
-            memset(&temp, 0, sizeof(temp));
-            UtxoUtil::ConvertToUtxo(utxo, &temp, &dest);
-            utxo_map_.emplace_back(dest);
-            break;
-          }
-        }
+      OutPoint outpoint(txin_ref.GetTxid(), txin_ref.GetVout());
+      if (collected_outpoints.find(outpoint) != collected_outpoints.end()) {
+        continue;
       }
+      auto ite = utxo_index_map.find(outpoint);
+      if (ite == utxo_index_map.end()) continue;
+
+      UtxoData dest;
+      Utxo temp;
+      memset(&temp, 0, sizeof(temp));
+      UtxoUtil::ConvertToUtxo(*ite->second, &temp, &dest);
+      utxo_map_.emplace_back(dest);
+      collected_outpoints.insert(outpoint);
     }
   }
 }
@@ -722,6 +1171,12 @@ uint32_t TransactionContext::GetLockTimeDisabledSequence() {
 void TransactionContext::CallbackStateChange(uint32_t type) {
   cfd::core::logger::trace(
       CFD_LOG_SOURCE, "CallbackStateChange type::{}", type);
+  MarkTxInIndexDirty();
+}
+
+void TransactionContext::MarkTxInIndexDirty() {
+  std::lock_guard<std::mutex> lock(txin_index_mutex_);
+  is_txin_index_dirty_ = true;
 }
 
 std::vector<SignParameter> TransactionContext::CheckMultisig(
@@ -798,6 +1253,165 @@ bool TransactionContext::IsFindOutPoint(
   return false;
 }
 
+// -----------------------------------------------------------------------------
+// PayoutBatcher
+// -----------------------------------------------------------------------------
+PayoutBatcher::PayoutBatcher(
+    uint32_t max_weight, uint32_t max_txout_count, uint32_t version,
+    uint32_t locktime)
+    : max_weight_(max_weight),
+      max_txout_count_(max_txout_count),
+      version_(version),
+      locktime_(locktime) {
+  // do nothing
+}
+
+std::vector<PayoutBatchData> PayoutBatcher::CreateBatches(
+    const std::vector<PayoutRequest>& requests,
+    const std::vector<UtxoData>& utxos, const Address& reserve_address,
+    double effective_fee_rate, const UtxoFilter* filter,
+    const CoinSelectionOption* option_params) const {
+  static constexpr uint32_t kWitnessScaleFactor = 4;
+  const uint32_t max_weight =
+      (max_weight_ == 0) ? std::numeric_limits<uint32_t>::max() : max_weight_;
+  const uint32_t max_count = (max_txout_count_ == 0)
+                                 ? std::numeric_limits<uint32_t>::max()
+                                 : max_txout_count_;
+
+  // set option
+  CoinSelectionOption option;
+  UtxoFilter utxo_filter;
+  if (filter) utxo_filter = *filter;
+  if (option_params) {
+    option = *option_params;
+  } else {
+    option.InitializeTxSizeInfo();
+    option.SetEffectiveFeeBaserate(effective_fee_rate);
+    option.SetLongTermFeeBaserate(effective_fee_rate);
+  }
+
+  // weight of the transaction skeleton and the change txout.
+  TransactionContext empty_tx(version_, locktime_);
+  TxOut change_txout(Amount(), reserve_address.GetLockingScript());
+  const uint32_t base_weight =
+      empty_tx.GetWeight() +
+      (change_txout.GetSerializeSize() * kWitnessScaleFactor);
+
+  // txout weight of each request. (used for incremental size accounting)
+  std::vector<uint32_t> txout_weights;
+  txout_weights.reserve(requests.size());
+  for (const auto& request : requests) {
+    TxOut txout(request.amount, request.address.GetLockingScript());
+    txout_weights.push_back(txout.GetSerializeSize() * kWitnessScaleFactor);
+  }
+
+  // The utxos are converted once, and the pool shrinks as they are spent.
+  TransactionContext::FundingPool pool;
+  empty_tx.CollectFundingPool(utxos, std::vector<UtxoData>(), &pool);
+
+  // A batch has one request at least. Reserve the maximum batch count, so
+  // the growth of the result does not copy the preceding transactions.
+  std::vector<PayoutBatchData> result;
+  result.reserve(requests.size());
+  size_t offset = 0;
+  while (offset < requests.size()) {
+    // pack the requests while the txout weight fits.
+    size_t end = offset;
+    uint32_t weight = base_weight;
+    while ((end < requests.size()) && ((end - offset) < max_count)) {
+      if ((end != offset) && (weight + txout_weights[end] > max_weight)) {
+        break;
+      }
+      weight += txout_weights[end];
+      ++end;
+    }
+
+    // build the transaction on the reserved result.
+    result.emplace_back(version_, locktime_);
+    PayoutBatchData& data = result.back();
+    TransactionContext& tx = data.transaction;
+    for (size_t index = offset; index < end; ++index) {
+      tx.AddTxOut(requests[index].address, requests[index].amount);
+    }
+    while (true) {
+      data.utxos = tx.FundByPool(
+          &pool, Amount(), reserve_address, effective_fee_rate, utxo_filter,
+          option, &data.fee, nullptr);
+
+      // check the weight after signing. (estimated by the utxo)
+      std::vector<TxInSizeData> txin_sizes;
+      txin_sizes.reserve(data.utxos.size());
+      for (const auto& utxo : data.utxos) {
+        auto ite = pool.utxo_index_map.find(OutPoint(utxo.txid, utxo.vout));
+        txin_sizes.push_back(pool.utxo_sizes[ite->second]);
+      }
+      uint32_t tx_weight = EstimateWeightByTxInSize(tx, txin_sizes);
+      if (tx_weight <= max_weight) break;
+
+      if ((end - offset) <= 1) {
+        warn(
+            CFD_LOG_SOURCE, "Failed to CreateBatches. weight={}, max={}",
+            tx_weight, max_weight);
+        throw CfdException(
+            CfdError::kCfdIllegalArgumentError,
+            "Failed to CreateBatches. The transaction exceeds max weight.");
+      }
+      // The txin was larger than expected. Drop the trailing requests that
+      // cover the excess weight, and fund again.
+      uint32_t excess = tx_weight - max_weight;
+      uint32_t removed = 0;
+      while (((end - offset) > 1) && (removed < excess)) {
+        --end;
+        removed += txout_weights[end];
+      }
+      // roll back the funded txin, the change and the dropped requests.
+      for (uint32_t index = tx.GetTxInCount(); index > 0; --index) {
+        tx.RemoveTxIn(index - 1);
+      }
+      const uint32_t txout_count = static_cast<uint32_t>(end - offset);
+      for (uint32_t index = tx.GetTxOutCount(); index > txout_count; --index) {
+        tx.RemoveTxOut(index - 1);
+      }
+    }
+    tx.CollectInputUtxo(data.utxos);
+
+    data.request_indexes.reserve(end - offset);
+    for (size_t index = offset; index < end; ++index) {
+      data.request_indexes.push_back(static_cast<uint32_t>(index));
+    }
+    offset = end;
+
+    // remove the spent utxos from the pool.
+    if (!data.utxos.empty()) {
+      std::set<OutPoint> used_outpoints;
+      for (const auto& utxo : data.utxos) {
+        used_outpoints.emplace(utxo.txid, utxo.vout);
+      }
+      size_t count = 0;
+      pool.utxo_index_map.clear();
+      for (size_t index = 0; index < pool.utxos.size(); ++index) {
+        OutPoint outpoint(pool.utxos[index].txid, pool.utxos[index].vout);
+        if (used_outpoints.count(outpoint) != 0) continue;
+        if (count != index) {
+          pool.utxos[count] = pool.utxos[index];
+          pool.utxo_sizes[count] = pool.utxo_sizes[index];
+          pool.coins[count] = pool.coins[index];
+        }
+        pool.utxo_index_map.emplace(outpoint, count);
+        ++count;
+      }
+      pool.utxos.resize(count);
+      pool.utxo_sizes.resize(count);
+      pool.coins.resize(count);
+    }
+    info(
+        CFD_LOG_SOURCE, "CreateBatches: txout={}, txin={}, fee={}",
+        data.request_indexes.size(), data.utxos.size(),
+        data.fee.GetSatoshiValue());
+  }
+  return result;
+}
+
 // -----------------------------------------------------------------------------
 // TransactionController
 // -----------------------------------------------------------------------------
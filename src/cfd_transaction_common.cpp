@@ -8,11 +8,13 @@
 #include "cfd/cfd_transaction_common.h"
 
 #include <algorithm>
+#include <exception>
 #include <string>
 #include <vector>
 
 #include "cfd/cfd_common.h"
 #include "cfd/cfd_utxo.h"
+#include "cfd_transaction_internal.h"  // NOLINT
 #include "cfdcore/cfdcore_address.h"
 #include "cfdcore/cfdcore_amount.h"
 #include "cfdcore/cfdcore_coin.h"
@@ -185,6 +187,46 @@ std::vector<Utxo> UtxoUtil::ConvertToUtxo(const std::vector<UtxoData>& utxos) {
   return result;
 }
 
+std::vector<Utxo> UtxoUtil::ConvertToUtxoParallel(
+    const std::vector<UtxoData>& utxos, std::vector<std::string>* errors,
+    uint32_t thread_count) {
+  // Small lists are converted on the calling thread.
+  static constexpr size_t kMinimumUtxoCountPerThread = 256;
+  std::vector<Utxo> result(utxos.size());
+  std::vector<std::string> error_list(utxos.size());
+  auto exception_list = TransactionContextUtil::ParallelFor(
+      utxos.size(), thread_count, kMinimumUtxoCountPerThread,
+      [&utxos, &result](size_t index) {
+        ConvertToUtxo(utxos[index], &result[index]);
+      });
+  for (size_t index = 0; index < exception_list.size(); ++index) {
+    if (!exception_list[index]) continue;
+    memset(&result[index], 0, sizeof(Utxo));
+    try {
+      std::rethrow_exception(exception_list[index]);
+    } catch (const std::exception& except) {
+      error_list[index] = except.what();
+    } catch (...) {
+      error_list[index] = "unknown error.";
+    }
+  }
+
+  if (errors != nullptr) {
+    *errors = error_list;
+  } else {
+    // rethrow the original exception of the lowest index. (keep the code)
+    for (size_t index = 0; index < exception_list.size(); ++index) {
+      if (exception_list[index]) {
+        warn(
+            CFD_LOG_SOURCE, "Failed to ConvertToUtxo. index={}, error={}",
+            index, error_list[index]);
+        std::rethrow_exception(exception_list[index]);
+      }
+    }
+  }
+  return result;
+}
+
 void UtxoUtil::ConvertToUtxo(
     const UtxoData& utxo_data, Utxo* utxo, UtxoData* dest) {
   if (utxo != nullptr) {
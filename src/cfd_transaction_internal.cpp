@@ -8,7 +8,10 @@
 #include "cfd_transaction_internal.h"  // NOLINT
 
 #include <algorithm>
+#include <exception>
+#include <map>
 #include <string>
+#include <thread>  // NOLINT
 #include <vector>
 
 #include "cfd/cfd_address.h"
@@ -645,6 +648,82 @@ std::vector<ByteData> TransactionContextUtil::GetVerifySignatureStack(
   return signature_stack;
 }
 
+template <class TxInType>
+bool TransactionContextUtil::FindTxInIndex(
+    const std::vector<TxInType>& txin_list, const OutPoint& outpoint,
+    std::map<OutPoint, uint32_t>* index_map, bool* is_dirty,
+    uint32_t* index) {
+  uint32_t txin_count = static_cast<uint32_t>(txin_list.size());
+  auto ite = index_map->find(outpoint);
+  if ((ite != index_map->end()) && (ite->second < txin_count) &&
+      (txin_list[ite->second].GetOutPoint() == outpoint)) {
+    *index = ite->second;
+    return true;
+  }
+  // The miss is trusted until the txin is changed.
+  if ((!*is_dirty) && (index_map->size() == txin_count)) return false;
+  index_map->clear();
+  for (uint32_t txin_index = 0; txin_index < txin_count; ++txin_index) {
+    index_map->emplace(txin_list[txin_index].GetOutPoint(), txin_index);
+  }
+  *is_dirty = false;
+  ite = index_map->find(outpoint);
+  if (ite == index_map->end()) return false;
+  *index = ite->second;
+  return true;
+}
+
+std::vector<std::exception_ptr> TransactionContextUtil::ParallelFor(
+    size_t count, uint32_t thread_count, size_t min_count_per_thread,
+    const std::function<void(size_t)>& function) {
+  std::vector<std::exception_ptr> errors(count);
+  auto run_range = [&function, &errors](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; ++index) {
+      try {
+        function(index);
+      } catch (...) {
+        errors[index] = std::current_exception();
+      }
+    }
+  };
+
+  size_t max_thread = thread_count;
+  if (max_thread == 0) {
+    max_thread = std::thread::hardware_concurrency();
+    if (max_thread == 0) max_thread = 1;
+  }
+  if (min_count_per_thread == 0) min_count_per_thread = 1;
+  size_t worker_count = std::min(max_thread, count / min_count_per_thread);
+  if (worker_count <= 1) {
+    run_range(0, count);
+    return errors;
+  }
+
+  // Each thread writes only its own range, so the order is kept.
+  size_t chunk = (count + worker_count - 1) / worker_count;
+  std::vector<std::thread> workers;
+  workers.reserve(worker_count - 1);
+  try {
+    for (size_t begin = chunk; begin < count; begin += chunk) {
+      workers.emplace_back(run_range, begin, std::min(begin + chunk, count));
+    }
+    run_range(0, std::min(chunk, count));
+  } catch (...) {
+    // join the started workers before leaving the scope.
+    for (auto& worker : workers) worker.join();
+    throw;
+  }
+  for (auto& worker : workers) worker.join();
+  return errors;
+}
+
+void TransactionContextUtil::RethrowFirstError(
+    const std::vector<std::exception_ptr>& errors) {
+  for (const auto& error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
 // -----------------------------------------------------------------------------
 // TransactionContextUtil implements TransactionContext
 // -----------------------------------------------------------------------------
@@ -672,6 +751,11 @@ template void TransactionContextUtil::Verify<TransactionContext>(
         const ByteData*, const TaprootScriptTree*)>
         create_sighash_func);
 
+template bool TransactionContextUtil::FindTxInIndex<cfd::core::TxIn>(
+    const std::vector<cfd::core::TxIn>& txin_list, const OutPoint& outpoint,
+    std::map<OutPoint, uint32_t>* index_map, bool* is_dirty,
+    uint32_t* index);
+
 template void TransactionContextUtil::Verify<Transaction>(
     const Transaction* transaction, const OutPoint& outpoint,
     const UtxoData& utxo, const AbstractTxIn* txin,
@@ -710,6 +794,12 @@ template void TransactionContextUtil::Verify<ConfidentialTransactionContext>(
         const UtxoData&, const SigHashType&, const Pubkey&, const Script&,
         WitnessVersion, const ByteData*, const TaprootScriptTree*)>
         create_sighash_func);
+
+template bool
+TransactionContextUtil::FindTxInIndex<cfd::core::ConfidentialTxIn>(
+    const std::vector<cfd::core::ConfidentialTxIn>& txin_list,
+    const OutPoint& outpoint, std::map<OutPoint, uint32_t>* index_map,
+    bool* is_dirty, uint32_t* index);
 #endif  // CFD_DISABLE_ELEMENTS
 
 }  // namespace cfd
@@ -9,6 +9,9 @@
 #define CFD_SRC_CFD_TRANSACTION_INTERNAL_H_
 
 #include <algorithm>
+#include <exception>
+#include <functional>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -147,6 +150,45 @@ class TransactionContextUtil {
       const UtxoData& utxo, const AbstractTxIn* txin,
       WitnessVersion* witness_version, bool* is_pubkey_stack);
 
+  /**
+   * @brief Find the txin index from the outpoint index map.
+   * @details The miss is trusted until the txin is changed. \
+   *    The caller holds the lock of the index map.
+   * @param[in] txin_list         txin list
+   * @param[in] outpoint          outpoint
+   * @param[in,out] index_map     outpoint index map
+   * @param[in,out] is_dirty      index map dirty flag
+   * @param[out] index            txin index
+   * @retval true   exist txin
+   * @retval false  txin not found
+   */
+  template <class TxInType>
+  static bool FindTxInIndex(
+      const std::vector<TxInType>& txin_list, const OutPoint& outpoint,
+      std::map<OutPoint, uint32_t>* index_map, bool* is_dirty,
+      uint32_t* index);
+
+  /**
+   * @brief Call the function for each index on multiple threads.
+   * @details The index range is split into the continuous chunks, \
+   *    and the calling thread also handles the first chunk. \
+   *    The exception of each index is collected to the result.
+   * @param[in] count                 index count
+   * @param[in] thread_count          max thread count (0: hardware concurrency)
+   * @param[in] min_count_per_thread  minimum index count per thread
+   * @param[in] function              function of one index
+   * @return exception list. (same size as count)
+   */
+  static std::vector<std::exception_ptr> ParallelFor(
+      size_t count, uint32_t thread_count, size_t min_count_per_thread,
+      const std::function<void(size_t)>& function);
+
+  /**
+   * @brief Rethrow the exception of the lowest index.
+   * @param[in] errors    exception list
+   */
+  static void RethrowFirstError(const std::vector<std::exception_ptr>& errors);
+
  private:
   /**
    * @brief constructor.
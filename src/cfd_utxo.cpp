@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>  // NOLINT
 #include <cmath>
 #include <cstring>
 #include <map>
@@ -94,6 +95,10 @@ CoinSelectionOption::CoinSelectionOption()
 
 bool CoinSelectionOption::IsUseBnB() const { return use_bnb_; }
 
+bool CoinSelectionOption::IsCollectStatistics() const {
+  return is_collect_statistics_;
+}
+
 uint32_t CoinSelectionOption::GetChangeOutputSize() const {
   return change_output_size_;
 }
@@ -139,6 +144,10 @@ bool CoinSelectionOption::HasIgnoreFeeAsset() const {
 
 void CoinSelectionOption::SetUseBnB(bool use_bnb) { use_bnb_ = use_bnb; }
 
+void CoinSelectionOption::SetCollectStatistics(bool is_collect) {
+  is_collect_statistics_ = is_collect;
+}
+
 void CoinSelectionOption::SetChangeOutputSize(size_t size) {
   change_output_size_ = static_cast<uint32_t>(size);
 }
@@ -237,6 +246,18 @@ void CoinSelectionOption::InitializeConfidentialTxSizeInfo() {
 }
 #endif  // CFD_DISABLE_ELEMENTS
 
+/**
+ * @brief Get the elapsed time from the start time.
+ * @param[in] start_time  start time
+ * @return elapsed time (usec)
+ */
+static uint64_t GetElapsedUsec(
+    const std::chrono::steady_clock::time_point& start_time) {
+  auto elapsed = std::chrono::steady_clock::now() - start_time;
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
 // -----------------------------------------------------------------------------
 // CoinSelection
 // -----------------------------------------------------------------------------
@@ -253,6 +274,10 @@ std::vector<Utxo> CoinSelection::SelectCoins(
     const UtxoFilter& filter, const CoinSelectionOption& option_params,
     const Amount& tx_fee_value, Amount* select_value, Amount* utxo_fee_value,
     bool* searched_bnb) {
+  statistics_ = CoinSelectionStatistics();
+  is_collect_statistics_ = option_params.IsCollectStatistics();
+  std::chrono::steady_clock::time_point start_time;
+  if (is_collect_statistics_) start_time = std::chrono::steady_clock::now();
 #ifndef CFD_DISABLE_ELEMENTS
   bool first = true;
   uint8_t src[33];
@@ -301,6 +326,10 @@ std::vector<Utxo> CoinSelection::SelectCoins(
     *searched_bnb = use_bnb_out;
   }
   *select_value = Amount(select_satoshi);
+  if (is_collect_statistics_) {
+    statistics_.searched_bnb = use_bnb_out;
+    statistics_.total_elapsed_usec = GetElapsedUsec(start_time);
+  }
 
   return result;
 }
@@ -312,6 +341,10 @@ std::vector<Utxo> CoinSelection::SelectCoins(
     const Amount& tx_fee_value, AmountMap* map_select_value,
     Amount* utxo_fee_value, std::map<std::string, bool>* map_searched_bnb,
     AmountMap* map_utxo_fee_value) {
+  statistics_ = CoinSelectionStatistics();
+  is_collect_statistics_ = option_params.IsCollectStatistics();
+  std::chrono::steady_clock::time_point start_time;
+  if (is_collect_statistics_) start_time = std::chrono::steady_clock::now();
   bool calculate_fee = (option_params.GetEffectiveFeeBaserate() != 0);
   if (calculate_fee && option_params.GetFeeAsset().IsEmpty()) {
     warn(
@@ -407,6 +440,9 @@ std::vector<Utxo> CoinSelection::SelectCoins(
     work_utxo_fee += utxo_fee_out;
     work_selected_values.emplace(asset_id, select_value_out);
     work_searched_bnb.emplace(asset_id, use_bnb_out);
+    if (is_collect_statistics_ && use_bnb_out) {
+      statistics_.searched_bnb = true;
+    }
     work_map_utxo_fee_value.emplace(asset_id, utxo_fee_out.GetSatoshiValue());
   };
 
@@ -444,6 +480,9 @@ std::vector<Utxo> CoinSelection::SelectCoins(
   if (map_utxo_fee_value != nullptr) {
     *map_utxo_fee_value = work_map_utxo_fee_value;
   }
+  if (is_collect_statistics_) {
+    statistics_.total_elapsed_usec = GetElapsedUsec(start_time);
+  }
   return result;
 }
 #endif  // CFD_DISABLE_ELEMENTS
@@ -521,11 +560,21 @@ std::vector<Utxo> CoinSelection::SelectCoinsMinConf(
       }
     }
     // Calculate the fees for things that aren't inputs
+    std::chrono::steady_clock::time_point bnb_start_time;
+    if (is_collect_statistics_) {
+      bnb_start_time = std::chrono::steady_clock::now();
+    }
     std::vector<Utxo> result = SelectCoinsBnB(
         target_value, utxo_pool, cost_of_change.GetSatoshiValue(),
         tx_fee_value, ignore_error, select_value, utxo_fee_value);
+    if (is_collect_statistics_) {
+      statistics_.bnb_elapsed_usec += GetElapsedUsec(bnb_start_time);
+    }
     if (!result.empty()) {
       if (searched_bnb) *searched_bnb = true;
+      if (is_collect_statistics_) {
+        statistics_.utxo_count += static_cast<uint32_t>(utxo_pool.size());
+      }
       return result;
     }
     // SelectCoinsBnB fail, go to KnapsackSolver.
@@ -566,8 +615,24 @@ std::vector<Utxo> CoinSelection::SelectCoinsMinConf(
       min_change = static_cast<uint64_t>(cost_of_change.GetSatoshiValue());
     }
   }
+  std::chrono::steady_clock::time_point knapsack_start_time;
+  if (is_collect_statistics_) {
+    knapsack_start_time = std::chrono::steady_clock::now();
+  }
   std::vector<Utxo> result = KnapsackSolver(
       search_value, utxo_pool, min_change, select_value, &utxo_fee);
+  if (is_collect_statistics_) {
+    statistics_.knapsack_elapsed_usec += GetElapsedUsec(knapsack_start_time);
+    statistics_.utxo_count += static_cast<uint32_t>(utxo_pool.size());
+  }
+  if (is_collect_statistics_ && !result.empty()) {
+    int64_t select_effective_value = 0;
+    for (const auto& utxo : result) {
+      select_effective_value += static_cast<int64_t>(utxo.amount);
+    }
+    if (consider_fee) select_effective_value -= utxo_fee.GetSatoshiValue();
+    statistics_.knapsack_excess += select_effective_value - search_value;
+  }
   if (use_fee) {
     // Check if the required amount was detected
     // (May be a non-passing route)
@@ -655,6 +720,7 @@ std::vector<Utxo> CoinSelection::SelectCoinsBnB(
 
   // Depth First search loop for choosing the UTXOs
   for (size_t i = 0; i < kBnBMaxTotalTries; ++i) {
+    if (is_collect_statistics_) ++statistics_.bnb_tries;
     // Conditions for starting a backtrack
     bool backtrack = false;
     if (curr_value + curr_available_value <
@@ -690,6 +756,7 @@ std::vector<Utxo> CoinSelection::SelectCoinsBnB(
 
     // Backtracking, moving backwards
     if (backtrack) {
+      if (is_collect_statistics_) ++statistics_.bnb_backtracks;
       //NOLINT Walk backwards to find the last included UTXO that still needs to have its omission branch traversed.
       while (!curr_selection.empty() && !curr_selection.back()) {
         curr_selection.pop_back();
@@ -732,6 +799,7 @@ std::vector<Utxo> CoinSelection::SelectCoinsBnB(
   // Check for solution
   Amount fee_value = Amount::CreateBySatoshiAmount(0);
   if (!best_selection.empty()) {
+    if (is_collect_statistics_) statistics_.waste += best_waste;
     // Set output set
     *select_value = 0;
     for (size_t i = 0; i < best_selection.size(); ++i) {
@@ -895,6 +963,7 @@ void CoinSelection::ApproximateBestSubset(
 
   for (int n_rep = 0; n_rep < iterations && *n_best != n_target_value;
        n_rep++) {
+    if (is_collect_statistics_) ++statistics_.knapsack_iterations;
     vf_includes.assign(utxos.size(), false);
     int64_t n_total = 0;
     bool is_reached_target = false;
@@ -930,6 +999,10 @@ void CoinSelection::ApproximateBestSubset(
   }
 }
 
+const CoinSelectionStatistics& CoinSelection::GetStatistics() const {
+  return statistics_;
+}
+
 void CoinSelection::ConvertToUtxo(
     const Txid& txid, uint32_t vout, const std::string& output_descriptor,
     const Amount& amount, const std::string& asset, const void* binary_data,
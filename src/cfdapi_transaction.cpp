@@ -9,12 +9,10 @@
 
 #include <algorithm>
 #include <cctype>
-#include <cmath>
 #include <string>
 #include <vector>
 
 #include "cfd/cfd_address.h"
-#include "cfd/cfd_fee.h"
 #include "cfd/cfd_transaction.h"
 #include "cfd/cfdapi_address.h"
 #include "cfd/cfdapi_coin.h"
@@ -34,15 +32,11 @@
 namespace cfd {
 namespace api {
 
-using cfd::FeeCalculator;
 using cfd::TransactionController;
 using cfd::api::TransactionApiBase;
-using cfd::core::AbstractTransaction;
-using cfd::core::ByteData256;
 using cfd::core::CfdError;
 using cfd::core::CfdException;
 using cfd::core::Txid;
-using cfd::core::logger::info;
 using cfd::core::logger::warn;
 
 // -----------------------------------------------------------------------------
@@ -215,81 +209,7 @@ Amount TransactionApi::EstimateFee(
     const std::string& tx_hex, const std::vector<UtxoData>& utxos,
     Amount* txout_fee, Amount* utxo_fee, double effective_fee_rate) const {
   TransactionContext txc(tx_hex);
-
-  uint32_t size = 0;
-  uint32_t witness_size = 0;
-  uint32_t wit_size = 0;
-  uint32_t nowit_size = 0;
-  uint32_t not_witness_count = 0;
-  for (const auto& utxo : utxos) {
-    NetType net_type = NetType::kMainnet;
-    if (!utxo.address.GetAddress().empty()) {
-      net_type = utxo.address.GetNetType();
-    }
-    AddressFactory address_factory(net_type);
-    // check descriptor
-    std::string descriptor = utxo.descriptor;
-    // set dummy NetType for getting AddressType.
-    auto data = address_factory.ParseOutputDescriptor(descriptor);
-
-    AddressType addr_type;
-    if (utxo.address.GetAddress().empty() ||
-        data.address_type == AddressType::kP2shP2wpkhAddress ||
-        data.address_type == AddressType::kP2shP2wshAddress) {
-      addr_type = data.address_type;
-    } else {
-      addr_type = utxo.address.GetAddressType();
-    }
-
-    Script redeem_script;
-    if (utxo.redeem_script.IsEmpty() && !data.redeem_script.IsEmpty()) {
-      redeem_script = data.redeem_script;
-    } else {
-      redeem_script = utxo.redeem_script;
-    }
-    const Script* scriptsig_template = nullptr;
-    if (((!redeem_script.IsEmpty()) ||
-         (addr_type == AddressType::kTaprootAddress)) &&
-        (!utxo.scriptsig_template.IsEmpty())) {
-      scriptsig_template = &utxo.scriptsig_template;
-    }
-
-    TxIn::EstimateTxInSize(
-        addr_type, redeem_script, &wit_size, &nowit_size, scriptsig_template);
-    size += nowit_size;
-    witness_size += wit_size;
-    if (wit_size == 0) ++not_witness_count;
-  }
-
-  uint32_t tx_size = txc.GetSizeIgnoreTxIn((witness_size != 0));
-  uint32_t tx_vsize = AbstractTransaction::GetVsizeFromSize(tx_size, 0);
-
-  if ((witness_size != 0) && (not_witness_count != 0) &&
-      (not_witness_count < static_cast<uint32_t>(utxos.size()))) {
-    // append witness size for p2pkh or p2sh
-    witness_size += not_witness_count;
-  }
-
-  uint32_t utxo_vsize =
-      AbstractTransaction::GetVsizeFromSize(size, witness_size);
-
-  uint64_t fee_rate = static_cast<uint64_t>(floor(effective_fee_rate * 1000));
-  FeeCalculator fee_calc(fee_rate);
-  Amount tx_fee_amount = fee_calc.GetFee(tx_vsize);
-  Amount utxo_fee_amount = fee_calc.GetFee(utxo_vsize);
-  uint32_t total_size = tx_size + size;
-  uint32_t total_vsize =
-      AbstractTransaction::GetVsizeFromSize(total_size, witness_size);
-  Amount fee = fee_calc.GetFee(total_vsize);
-
-  if (txout_fee) *txout_fee = tx_fee_amount;
-  if (utxo_fee) *utxo_fee = utxo_fee_amount;
-
-  info(
-      CFD_LOG_SOURCE, "EstimateFee rate={} fee={} tx={} utxo={}",
-      effective_fee_rate, fee.GetSatoshiValue(),
-      tx_fee_amount.GetSatoshiValue(), utxo_fee_amount.GetSatoshiValue());
-  return fee;
+  return txc.EstimateFee(utxos, txout_fee, utxo_fee, effective_fee_rate);
 }
 
 TransactionController TransactionApi::FundRawTransaction(
@@ -302,18 +222,6 @@ TransactionController TransactionApi::FundRawTransaction(
     std::vector<std::string>* append_txout_addresses, NetType net_type,
     const std::vector<AddressFormatData>* prefix_list,
     Amount* calculate_fee) const {
-  // set option
-  CoinSelectionOption option;
-  UtxoFilter utxo_filter;
-  if (filter) utxo_filter = *filter;
-  if (option_params) {
-    option = *option_params;
-  } else {
-    option.InitializeTxSizeInfo();
-    option.SetEffectiveFeeBaserate(effective_fee_rate);
-    option.SetLongTermFeeBaserate(effective_fee_rate);
-  }
-
   AddressFactory addr_factory(net_type);
   if (prefix_list) {
     addr_factory = AddressFactory(net_type, *prefix_list);
@@ -334,175 +242,16 @@ TransactionController TransactionApi::FundRawTransaction(
         "Input address and network is unmatch.");
   }
 
-  // txから設定済みTxIn/TxOutの額を収集
-  // (selected_txin_utxos指定分はtxid一致なら設定済みUTXO扱い)
-  TransactionController txc(tx_hex);
-  const Transaction& tx = txc.GetTransaction();
-  Amount txin_amount;
-  Amount txout_amount;
-  for (const auto& txout : tx.GetTxOutList()) {
-    txout_amount += txout.GetValue();
-  }
-  std::vector<UtxoData> matched_txin_utxos;
-  matched_txin_utxos.reserve(selected_txin_utxos.size());
-  const auto& txin_list = tx.GetTxInList();
-  for (const auto& utxo : selected_txin_utxos) {
-    for (const auto& txin : txin_list) {
-      if ((txin.GetTxid().Equals(utxo.txid)) &&
-          (utxo.vout == txin.GetVout())) {
-        txin_amount += utxo.amount;
-        matched_txin_utxos.push_back(utxo);
-        break;
-      }
-    }
-  }
-
-  std::vector<UtxoData> utxodata_list;
-  utxodata_list.reserve(utxos.size());
-  for (const auto& utxo : utxos) {
-    bool isFind = false;
-    for (const auto& txin : txin_list) {
-      if ((txin.GetTxid().Equals(utxo.txid)) &&
-          (utxo.vout == txin.GetVout())) {
-        isFind = true;
-        break;
-      }
-    }
-    if (!isFind) {
-      utxodata_list.push_back(utxo);
-    }
-  }
-
-  Amount fee;
-  if (option.GetEffectiveFeeBaserate() != 0) {
-    fee = EstimateFee(
-        tx_hex, matched_txin_utxos, nullptr, nullptr, effective_fee_rate);
-    info(
-        CFD_LOG_SOURCE, "FundRawTransaction: pre estimation fee=[{}]",
-        fee.GetSatoshiValue());
-  }
-
-  Amount diff_amount = Amount();        // difference between input and output
-  Amount target_amount = target_value;  // selection require amount
-  if (txin_amount > txout_amount) {
-    // txinの余剰分を計算
-    diff_amount = txin_amount - txout_amount;
-    if (diff_amount < target_amount) {
-      // txinの余剰分でtarget分が満たされない場合、満たされない分をコインセレクト
-      target_amount -= diff_amount;
-    }
-  } else if (txin_amount < txout_amount) {
-    // txoutの不足分を計算
-    diff_amount = txout_amount - txin_amount;
-    // txoutの不足分を合わせてコインセレクト
-    target_amount += diff_amount;
-  }
-
-  // execute coinselection
-  std::vector<Utxo> utxo_list = UtxoUtil::ConvertToUtxo(utxodata_list);
-  Amount txin_total_amount = txin_amount;
-  std::vector<Utxo> selected_coins;
-  if (target_amount > 0 || fee > 0) {
-    info(
-        CFD_LOG_SOURCE, "FundRawTransaction:CoinSelection: target_amount=[{}]",
-        target_amount.GetSatoshiValue());
-    CoinSelection coin_select;
-    selected_coins = coin_select.SelectCoins(
-        target_amount, utxo_list, utxo_filter, option, fee, &txin_total_amount,
-        nullptr, nullptr);
-    txin_total_amount += txin_amount;
-    info(
-        CFD_LOG_SOURCE, "FundRawTransaction: txin_total_amount=[{}]",
-        txin_total_amount.GetSatoshiValue());
-    if (txin_total_amount < target_amount) {
-      warn(CFD_LOG_SOURCE, "Failed to FundRawTransaction. low BTC.");
-      throw CfdException(CfdError::kCfdIllegalArgumentError, "low BTC.");
-    }
-  }
-
-  // dust_amountを計算
-  Amount dust_amount = option.GetDustFeeAmount(reserve_address);
-  info(
-      CFD_LOG_SOURCE, "FundRawTransaction: dust_amount=[{}]",
-      dust_amount.GetSatoshiValue());
-
-  // txoutへの追加
-  std::vector<uint8_t> txid_bytes(cfd::core::kByteData256Length);
-  Amount new_txout_amount =
-      txin_total_amount -
-      txout_amount;  // diff_amount: selected + txin - txout = new txout amount
-  int64_t new_txout_satoshi = new_txout_amount.GetSatoshiValue();
-  // feeを考慮する場合、追加後のTxInが既存のTxOut額以上ある場合、TxOutが追加されるのでfeeを再計算
-  if (option.GetEffectiveFeeBaserate() > 0) {
-    Amount need_amount = txout_amount + fee;
-    Amount check_amount = txin_total_amount - dust_amount;
-    if (check_amount > need_amount) {
-      // dummyのtx作成
-      TransactionController txc_dummy(tx_hex);
-      std::vector<UtxoData> new_selected_utxos = matched_txin_utxos;
-      Txid txid;
-      for (const Utxo& coin : selected_coins) {
-        memcpy(txid_bytes.data(), coin.txid, txid_bytes.size());
-        txid = Txid(ByteData256(txid_bytes));
-        for (const UtxoData& utxo : utxodata_list) {
-          if (txid.Equals(utxo.txid) && (coin.vout == utxo.vout)) {
-            new_selected_utxos.push_back(utxo);
-            break;
-          }
-        }
-      }
-      // ダミーへの追加のため額はfeeで代替
-      txc_dummy.AddTxOut(reserve_address, fee);
-      fee = EstimateFee(
-          txc_dummy.GetHex(), new_selected_utxos, nullptr, nullptr,
-          effective_fee_rate);
-      info(
-          CFD_LOG_SOURCE, "FundRawTransaction: new_fee={}",
-          fee.GetSatoshiValue());
-    }
-
-    new_txout_amount -= fee;  // txoutの追加額からfee分を除外
-    new_txout_satoshi = new_txout_amount.GetSatoshiValue();
-
-    if (txin_total_amount < new_txout_amount) {
-      warn(CFD_LOG_SOURCE, "Failed to FundRawTransaction. low fee.");
-      throw CfdException(
-          CfdError::kCfdIllegalArgumentError,
-          "Failed to FundRawTransaction. low fee.");
-    }
-
-    if (calculate_fee != nullptr) *calculate_fee = fee;
-    // optionで、超過額の設定がある場合、余剰分をfeeに設定。
-    if (dust_amount > new_txout_amount) {
-      // feeに残高をすべて設定
-      new_txout_satoshi = 0;
-      fee = txin_total_amount - new_txout_amount;
-    }
-    info(
-        CFD_LOG_SOURCE, "FundRawTransaction: new_txout_amount={}",
-        new_txout_satoshi);
-  }
-
-  // dustより小さい場合はTxOutには追加しない
-  // (fee計算ありの場合はチェック済だが、fee計算なしの場合は未チェックのため)
-  if ((new_txout_satoshi != 0) && (dust_amount < new_txout_amount)) {
-    txc.AddTxOut(reserve_address, new_txout_amount);
-    info(
-        CFD_LOG_SOURCE, "FundRawTransaction:AddTxOut: value=[{}]",
-        diff_amount.GetSatoshiValue());
-    if (append_txout_addresses) {
-      append_txout_addresses->push_back(reserve_txout_address);
-    }
-  }
-  if (estimate_fee) *estimate_fee = fee;
-
-  // SelectしたUTXOをTxInに設定
-  for (auto& utxo : selected_coins) {
-    memcpy(txid_bytes.data(), utxo.txid, txid_bytes.size());
-    txc.AddTxIn(Txid(ByteData256(txid_bytes)), utxo.vout);
+  TransactionContext txc(tx_hex);
+  uint32_t txout_count = txc.GetTxOutCount();
+  txc.Fund(
+      utxos, target_value, selected_txin_utxos, reserve_address,
+      effective_fee_rate, estimate_fee, filter, option_params, calculate_fee);
+  if ((append_txout_addresses != nullptr) &&
+      (txc.GetTxOutCount() > txout_count)) {
+    append_txout_addresses->push_back(reserve_txout_address);
   }
-
-  return txc;
+  return TransactionController(txc.GetHex());
 }
 
 std::string TransactionApi::CreateMultisigScriptSig(
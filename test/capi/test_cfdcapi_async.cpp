@@ -0,0 +1,272 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+
+#include "capi/cfdc_internal.h"
+#include "cfdc/cfdcapi_async.h"
+#include "cfdc/cfdcapi_coin.h"
+#include "cfdc/cfdcapi_common.h"
+
+/**
+ * @brief testing class.
+ */
+class cfdcapi_async : public ::testing::Test {
+ protected:
+  virtual void SetUp() { }
+  virtual void TearDown() { }
+};
+
+/**
+ * @brief async test context.
+ */
+struct AsyncTestContext {
+  const char* input;                //!< base64 input hex
+  std::string output;               //!< base64 output
+  std::atomic<bool> is_blocking;    //!< block the task
+  std::atomic<int> callback_count;  //!< callback count
+  std::atomic<int> last_status;     //!< last callback status
+};
+
+static int EncodeBase64Task(void* handle, void* context) {
+  AsyncTestContext* data = static_cast<AsyncTestContext*>(context);
+  while (data->is_blocking) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  char* output = nullptr;
+  int ret = CfdEncodeBase64(handle, data->input, &output);
+  if (ret == kCfdSuccess) {
+    data->output = output;
+    CfdFreeStringBuffer(output);
+  }
+  return ret;
+}
+
+static void AsyncTestCallback(void* context, int status, int result) {
+  AsyncTestContext* data = static_cast<AsyncTestContext*>(context);
+  data->last_status = status;
+  ++data->callback_count;
+  (void)result;
+}
+
+TEST(cfdcapi_async, SubmitAsyncTask) {
+  void* handle = nullptr;
+  int ret = CfdCreateHandle(&handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  void* worker = nullptr;
+  ret = CfdCreateAsyncWorker(handle, 2, 0, &worker);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  AsyncTestContext context;
+  context.input = "0102030405";
+  context.is_blocking = false;
+  context.callback_count = 0;
+  context.last_status = -1;
+  void* task = nullptr;
+  ret = CfdSubmitAsyncTask(
+      handle, worker, EncodeBase64Task, AsyncTestCallback, &context, &task);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    int status = -1;
+    int result = -1;
+    ret = CfdWaitAsyncTask(handle, task, 10000, &status, &result);
+    EXPECT_EQ(kCfdSuccess, ret);
+    EXPECT_EQ(kCfdAsyncTaskCompleted, status);
+    EXPECT_EQ(kCfdSuccess, result);
+    EXPECT_EQ("AQIDBAU=", context.output);
+    EXPECT_EQ(kCfdSuccess, CfdFreeAsyncTask(handle, task));
+  }
+
+  // error
+  AsyncTestContext err_context;
+  err_context.input = "zz";
+  err_context.is_blocking = false;
+  err_context.callback_count = 0;
+  err_context.last_status = -1;
+  ret = CfdSubmitAsyncTask(
+      handle, worker, EncodeBase64Task, nullptr, &err_context, &task);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    int status = -1;
+    int result = -1;
+    ret = CfdWaitAsyncTask(handle, task, 10000, &status, &result);
+    EXPECT_EQ(kCfdSuccess, ret);
+    EXPECT_EQ(kCfdAsyncTaskCompleted, status);
+    EXPECT_EQ(kCfdIllegalArgumentError, result);
+    EXPECT_EQ(kCfdIllegalArgumentError, CfdGetLastErrorCode(handle));
+    EXPECT_EQ(kCfdSuccess, CfdFreeAsyncTask(handle, task));
+  }
+
+  ret = CfdSubmitAsyncTask(
+      handle, worker, nullptr, nullptr, nullptr, &task);
+  EXPECT_EQ(kCfdIllegalArgumentError, ret);
+
+  EXPECT_EQ(kCfdSuccess, CfdFreeAsyncWorker(handle, worker));
+  EXPECT_EQ(1, context.callback_count);
+  EXPECT_EQ(kCfdAsyncTaskCompleted, context.last_status);
+  EXPECT_EQ(kCfdSuccess, CfdFreeHandle(handle));
+}
+
+TEST(cfdcapi_async, CancelAsyncTask) {
+  void* handle = nullptr;
+  int ret = CfdCreateHandle(&handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  void* worker = nullptr;
+  ret = CfdCreateAsyncWorker(handle, 1, 1, &worker);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  AsyncTestContext block_context;
+  block_context.input = "0102030405";
+  block_context.is_blocking = true;
+  block_context.callback_count = 0;
+  block_context.last_status = -1;
+  void* block_task = nullptr;
+  ret = CfdSubmitAsyncTask(
+      handle, worker, EncodeBase64Task, AsyncTestCallback, &block_context,
+      &block_task);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  int status = -1;
+  for (int count = 0; count < 1000; ++count) {
+    CfdWaitAsyncTask(handle, block_task, 0, &status, nullptr);
+    if (status == kCfdAsyncTaskRunning) break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(kCfdAsyncTaskRunning, status);
+
+  AsyncTestContext context;
+  context.input = "0102030405";
+  context.is_blocking = false;
+  context.callback_count = 0;
+  context.last_status = -1;
+  void* task = nullptr;
+  ret = CfdSubmitAsyncTask(
+      handle, worker, EncodeBase64Task, AsyncTestCallback, &context, &task);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  // backpressure: the queue is full.
+  void* full_task = nullptr;
+  ret = CfdSubmitAsyncTask(
+      handle, worker, EncodeBase64Task, nullptr, &context, &full_task);
+  EXPECT_EQ(kCfdOutOfRangeError, ret);
+
+  // running task can not be cancelled.
+  ret = CfdCancelAsyncTask(handle, block_task);
+  EXPECT_EQ(kCfdIllegalStateError, ret);
+
+  ret = CfdCancelAsyncTask(handle, task);
+  EXPECT_EQ(kCfdSuccess, ret);
+  ret = CfdWaitAsyncTask(handle, task, 0, &status, nullptr);
+  EXPECT_EQ(kCfdSuccess, ret);
+  EXPECT_EQ(kCfdAsyncTaskCancelled, status);
+  EXPECT_EQ(1, context.callback_count);
+  EXPECT_EQ(kCfdAsyncTaskCancelled, context.last_status);
+  EXPECT_EQ("", context.output);
+
+  block_context.is_blocking = false;
+  int result = -1;
+  ret = CfdWaitAsyncTask(handle, block_task, 10000, &status, &result);
+  EXPECT_EQ(kCfdSuccess, ret);
+  EXPECT_EQ(kCfdAsyncTaskCompleted, status);
+  EXPECT_EQ(kCfdSuccess, result);
+
+  EXPECT_EQ(kCfdSuccess, CfdFreeAsyncTask(handle, task));
+  EXPECT_EQ(kCfdSuccess, CfdFreeAsyncTask(handle, block_task));
+  EXPECT_EQ(kCfdSuccess, CfdFreeAsyncWorker(handle, worker));
+  EXPECT_EQ(kCfdSuccess, CfdFreeHandle(handle));
+}
+
+static void* CreateTestCoinSelection(void* handle) {
+  constexpr const char* kDescriptor = "wpkh(022c2409fbf657ba25d97bb3dab5426d20677b774d4fc7bd3bfac27ff96ada3dd1)";
+  constexpr const char* kTxid = "7ca81dd22c934747f4f5ab7844178445fe931fb248e0704c062b8f4fbd3d500a";
+  const int64_t amount_list[] = {
+      100000000, 50000000, 25000000, 12500000, 6250000};
+  void* coin_select_handle = nullptr;
+  int ret = CfdInitializeCoinSelection(
+      handle, 5, 1, "", 2000, 20, 20, -1, -1, &coin_select_handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret != kCfdSuccess) return nullptr;
+  for (int32_t index = 0; index < 5; ++index) {
+    ret = CfdAddCoinSelectionUtxo(
+        handle, coin_select_handle, index, kTxid, index, amount_list[index],
+        "", kDescriptor);
+    EXPECT_EQ(kCfdSuccess, ret);
+  }
+  ret = CfdAddCoinSelectionAmount(
+      handle, coin_select_handle, 0, 120000000, "");
+  EXPECT_EQ(kCfdSuccess, ret);
+  return coin_select_handle;
+}
+
+TEST(cfdcapi_async, SubmitFinalizeCoinSelection) {
+  void* handle = nullptr;
+  int ret = CfdCreateHandle(&handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  void* worker = nullptr;
+  ret = CfdCreateAsyncWorker(handle, 1, 0, &worker);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  void* sync_select_handle = CreateTestCoinSelection(handle);
+  int64_t sync_fee_amount = 0;
+  ret = CfdFinalizeCoinSelection(
+      handle, sync_select_handle, &sync_fee_amount);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  AsyncTestContext context;
+  context.input = nullptr;
+  context.is_blocking = false;
+  context.callback_count = 0;
+  context.last_status = -1;
+  void* coin_select_handle = CreateTestCoinSelection(handle);
+  int64_t utxo_fee_amount = -1;
+  void* task = nullptr;
+  ret = CfdSubmitFinalizeCoinSelection(
+      handle, worker, coin_select_handle, AsyncTestCallback, &context,
+      &utxo_fee_amount, &task);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    int status = -1;
+    int result = -1;
+    ret = CfdWaitAsyncTask(handle, task, 10000, &status, &result);
+    EXPECT_EQ(kCfdSuccess, ret);
+    EXPECT_EQ(kCfdAsyncTaskCompleted, status);
+    EXPECT_EQ(kCfdSuccess, result);
+    EXPECT_EQ(sync_fee_amount, utxo_fee_amount);
+    EXPECT_EQ(1, context.callback_count);
+    for (uint32_t index = 0; index < 5; ++index) {
+      int32_t sync_index = -1;
+      int32_t utxo_index = -1;
+      EXPECT_EQ(kCfdSuccess, CfdGetSelectedCoinIndex(
+          handle, sync_select_handle, index, &sync_index));
+      EXPECT_EQ(kCfdSuccess, CfdGetSelectedCoinIndex(
+          handle, coin_select_handle, index, &utxo_index));
+      EXPECT_EQ(sync_index, utxo_index);
+    }
+    EXPECT_EQ(kCfdSuccess, CfdFreeAsyncTask(handle, task));
+  }
+
+  // error: the error state of the worker handle is copied.
+  ret = CfdSubmitFinalizeCoinSelection(
+      handle, worker, nullptr, nullptr, nullptr, &utxo_fee_amount, &task);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    int status = -1;
+    int result = -1;
+    ret = CfdWaitAsyncTask(handle, task, 10000, &status, &result);
+    EXPECT_EQ(kCfdSuccess, ret);
+    EXPECT_EQ(kCfdAsyncTaskCompleted, status);
+    EXPECT_NE(kCfdSuccess, result);
+    EXPECT_EQ(result, CfdGetLastErrorCode(handle));
+    EXPECT_EQ(kCfdSuccess, CfdFreeAsyncTask(handle, task));
+  }
+
+  EXPECT_EQ(kCfdSuccess, CfdFreeAsyncWorker(handle, worker));
+  EXPECT_EQ(kCfdSuccess, CfdFreeCoinSelectionHandle(handle, coin_select_handle));
+  EXPECT_EQ(kCfdSuccess, CfdFreeCoinSelectionHandle(handle, sync_select_handle));
+  EXPECT_EQ(kCfdSuccess, CfdFreeHandle(handle));
+}
@@ -727,6 +727,10 @@ TEST(cfdcapi_coin, CfCoinSelection_BTC1) {
     ret = CfdAddCoinSelectionAmount(handle, coin_select_handle, 0, 180000000, "");
     EXPECT_EQ(kCfdSuccess, ret);
 
+    ret = CfdSetOptionCoinSelection(
+        handle, coin_select_handle, kCfdCoinSelectionCollectStatistics, 0,
+        0.0, true);
+    EXPECT_EQ(kCfdSuccess, ret);
     int64_t utxo_fee_amount = 0;
     ret = CfdFinalizeCoinSelection(handle, coin_select_handle, &utxo_fee_amount);
     EXPECT_EQ(kCfdSuccess, ret);
@@ -768,6 +772,22 @@ TEST(cfdcapi_coin, CfCoinSelection_BTC1) {
     ret = CfdGetSelectedCoinAssetAmount(handle, coin_select_handle, 0, &amount);
     EXPECT_EQ(kCfdSuccess, ret);
     EXPECT_EQ(181760100, amount);
+
+    bool searched_bnb = true;
+    uint32_t utxo_count = 0;
+    int64_t waste = -1;
+    int64_t knapsack_excess = -1;
+    ret = CfdGetCoinSelectionStatistics(
+        handle, coin_select_handle, &searched_bnb, &utxo_count, nullptr,
+        nullptr, nullptr, &waste, &knapsack_excess, nullptr, nullptr,
+        nullptr);
+    EXPECT_EQ(kCfdSuccess, ret);
+    // BnB finds no solution, so the knapsack selects from all utxos.
+    EXPECT_FALSE(searched_bnb);
+    EXPECT_EQ(static_cast<uint32_t>(utxos.size()), utxo_count);
+    EXPECT_EQ(0, waste);
+    // 181760100 - 7360(utxo fee) - (180000000 + 2000(tx fee))
+    EXPECT_EQ(1750740, knapsack_excess);
   }
   ret = CfdFreeCoinSelectionHandle(handle, coin_select_handle);
   EXPECT_EQ(kCfdSuccess, ret);
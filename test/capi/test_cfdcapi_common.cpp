@@ -1,7 +1,12 @@
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
 #include <stdexcept>
 #include <string>
+#include <thread>  // NOLINT
+#include <vector>
 
 #include "cfd/cfd_common.h"
 #include "cfdc/cfdcapi_common.h"
@@ -56,6 +61,89 @@ TEST(cfdcapi_common, CfdCreateSimpleHandle) {
   EXPECT_EQ(kCfdSuccess, ret);
 }
 
+TEST(cfdcapi_common, CfdCreateHandleMultiThread) {
+  constexpr size_t kThreadCount = 8;
+  constexpr size_t kHandleCount = 200;
+  std::vector<int> error_counts(kThreadCount, 0);
+  std::vector<std::thread> threads;
+  for (size_t index = 0; index < kThreadCount; ++index) {
+    threads.emplace_back([index, &error_counts]() {
+      std::vector<void*> handles;
+      for (size_t count = 0; count < kHandleCount; ++count) {
+        void* handle = NULL;
+        if (CfdCreateHandle(&handle) != kCfdSuccess) ++error_counts[index];
+        handles.push_back(handle);
+        // free the half of handles on the way.
+        if ((count % 2) == 1) {
+          if (CfdFreeHandle(handles.front()) != kCfdSuccess) {
+            ++error_counts[index];
+          }
+          handles.erase(handles.begin());
+        }
+      }
+      for (void* handle : handles) {
+        if (CfdFreeHandle(handle) != kCfdSuccess) ++error_counts[index];
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (int error_count : error_counts) EXPECT_EQ(0, error_count);
+
+  // reuse the free slot.
+  void* handle1 = NULL;
+  void* handle2 = NULL;
+  EXPECT_EQ(kCfdSuccess, CfdCreateHandle(&handle1));
+  EXPECT_EQ(kCfdSuccess, CfdFreeHandle(handle1));
+  EXPECT_EQ(kCfdSuccess, CfdCreateHandle(&handle2));
+  EXPECT_EQ(kCfdSuccess, CfdFreeHandle(handle2));
+}
+
+// call the first initialize on the multi thread, and count the error.
+static int CountMultiThreadInitializeError() {
+  constexpr size_t kThreadCount = 8;
+  constexpr size_t kCallCount = 100;
+  std::atomic<bool> is_start(false);
+  std::vector<int> error_counts(kThreadCount, 0);
+  std::vector<std::thread> threads;
+  for (size_t index = 0; index < kThreadCount; ++index) {
+    threads.emplace_back([index, &is_start, &error_counts]() {
+      // start all threads at once.
+      while (!is_start) std::this_thread::yield();
+      for (size_t count = 0; count < kCallCount; ++count) {
+        if (CfdInitialize() != kCfdSuccess) ++error_counts[index];
+        void* handle = NULL;
+        if (CfdCreateSimpleHandle(&handle) != kCfdSuccess) {
+          ++error_counts[index];
+          continue;
+        }
+        char* output = nullptr;
+        if (CfdEncodeBase64(handle, "0102030405", &output) != kCfdSuccess) {
+          ++error_counts[index];
+        } else {
+          if (std::string("AQIDBAU=") != output) ++error_counts[index];
+          CfdFreeStringBuffer(output);
+        }
+        if (CfdFreeHandle(handle) != kCfdSuccess) ++error_counts[index];
+      }
+    });
+  }
+  is_start = true;
+  for (auto& thread : threads) thread.join();
+  int error_count = 0;
+  for (int count : error_counts) error_count += count;
+  return error_count;
+}
+
+TEST(cfdcapi_common, CfdInitializeMultiThread) {
+  // run on the new process, where the library is not initialized yet.
+  std::string death_test_style = ::testing::FLAGS_gtest_death_test_style;
+  ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+  EXPECT_EXIT(
+      exit((CountMultiThreadInitializeError() == 0) ? 0 : 1),
+      ::testing::ExitedWithCode(0), "");
+  ::testing::FLAGS_gtest_death_test_style = death_test_style;
+}
+
 TEST(cfdcapi_common, CfdCloneHandle) {
   cfd::Initialize();
   int ret = CfdCloneHandle(NULL, NULL);
@@ -99,6 +187,157 @@ TEST(cfdcapi_common, CfdFreeStringBuffer) {
   EXPECT_EQ(kCfdSuccess, ret);
 }
 
+TEST(cfdcapi_common, AllocBufferReuse) {
+  struct TestBuffer {
+    char prefix[cfd::capi::kPrefixLength];
+    uint8_t data[100];
+  };
+  const std::string prefix = "TestBuffer";
+  for (int count = 0; count < 3; ++count) {
+    TestBuffer* buffer = static_cast<TestBuffer*>(
+        cfd::capi::AllocBuffer(prefix, sizeof(TestBuffer)));
+    EXPECT_STREQ(prefix.c_str(), buffer->prefix);
+    // the reused buffer is cleared.
+    for (size_t index = 0; index < sizeof(buffer->data); ++index) {
+      EXPECT_EQ(0, buffer->data[index]);
+    }
+    memset(buffer->data, 0xff, sizeof(buffer->data));
+    EXPECT_NO_THROW(
+        cfd::capi::FreeBuffer(buffer, prefix, sizeof(TestBuffer)));
+  }
+
+  std::vector<std::string>* list1 =
+      cfd::capi::NewPooledVector<std::string>();
+  list1->push_back("test");
+  cfd::capi::DeletePooledVector(list1);
+  std::vector<std::string>* list2 =
+      cfd::capi::NewPooledVector<std::string>(2);
+  EXPECT_EQ(size_t{2}, list2->size());
+  EXPECT_EQ("", list2->at(0));
+  cfd::capi::DeletePooledVector(list2);
+  cfd::capi::DeletePooledVector<std::string>(nullptr);
+}
+
+TEST(cfdcapi_common, CfdStringArena) {
+  void* handle = NULL;
+  int ret = CfdCreateHandle(&handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  ret = CfdBeginStringArena(NULL, 0);
+  EXPECT_EQ(kCfdIllegalArgumentError, ret);
+  ret = CfdResetStringArena(handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  ret = CfdBeginStringArena(handle, 64);
+  EXPECT_EQ(kCfdSuccess, ret);
+  char* output1 = nullptr;
+  char* output2 = nullptr;
+  ret = CfdEncodeBase64(handle, "0102030405", &output1);
+  EXPECT_EQ(kCfdSuccess, ret);
+  // over the block size
+  std::string long_hex(200, 'a');
+  ret = CfdEncodeBase64(handle, long_hex.c_str(), &output2);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    EXPECT_STREQ("AQIDBAU=", output1);
+    EXPECT_EQ(std::string(output2).length(), size_t{136});
+    // do nothing for the arena string.
+    EXPECT_EQ(kCfdSuccess, CfdFreeStringBuffer(output1));
+    EXPECT_EQ(kCfdSuccess, CfdFreeStringBuffer(output2));
+    EXPECT_STREQ("AQIDBAU=", output1);
+  }
+
+  // reuse the block after the reset.
+  ret = CfdResetStringArena(handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  char* output3 = nullptr;
+  ret = CfdEncodeBase64(handle, "0102030405", &output3);
+  EXPECT_EQ(kCfdSuccess, ret);
+  EXPECT_EQ(output1, output3);
+
+  // the other handle and the null handle do not use the arena.
+  void* other_handle = NULL;
+  ret = CfdCreateHandle(&other_handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  char* other_output = nullptr;
+  ret = CfdEncodeBase64(other_handle, "0102030405", &other_output);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    EXPECT_NE(output1 + 9, other_output);
+    EXPECT_EQ(kCfdSuccess, CfdFreeStringBuffer(other_output));
+  }
+  char* null_output = nullptr;
+  ret = CfdEncodeBase64(NULL, "0102030405", &null_output);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    EXPECT_NE(output1 + 9, null_output);
+    EXPECT_EQ(kCfdSuccess, CfdFreeStringBuffer(null_output));
+  }
+  EXPECT_EQ(kCfdSuccess, CfdFreeHandle(other_handle));
+
+  ret = CfdEndStringArena(handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  char* output4 = nullptr;
+  ret = CfdEncodeBase64(handle, "0102030405", &output4);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    EXPECT_STREQ("AQIDBAU=", output4);
+    EXPECT_NE(output1, output4);
+    CfdFreeStringBuffer(output4);
+  }
+
+  // free after the end. (the arena string is not released)
+  EXPECT_EQ(kCfdSuccess, CfdFreeStringBuffer(output3));
+  EXPECT_STREQ("AQIDBAU=", output3);
+
+  ret = CfdFreeHandle(handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+}
+
+TEST(cfdcapi_common, CfdStringArenaOtherThread) {
+  void* handle = NULL;
+  int ret = CfdCreateHandle(&handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  ret = CfdBeginStringArena(handle, 0);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  // the arena is chosen by the handle on the other thread.
+  char* output = nullptr;
+  int thread_ret = kCfdUnknownError;
+  std::thread worker([handle, &output, &thread_ret]() {
+    thread_ret = CfdEncodeBase64(handle, "0102030405", &output);
+  });
+  worker.join();
+  EXPECT_EQ(kCfdSuccess, thread_ret);
+  ASSERT_NE(nullptr, output);
+
+  // free on the other thread after the end. (the arena string is kept)
+  ret = CfdEndStringArena(handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  int free_ret = kCfdUnknownError;
+  std::thread free_worker([output, &free_ret]() {
+    free_ret = CfdFreeStringBuffer(output);
+  });
+  free_worker.join();
+  EXPECT_EQ(kCfdSuccess, free_ret);
+  EXPECT_STREQ("AQIDBAU=", output);
+
+  // the next string is allocated after the first string on the arena.
+  ret = CfdBeginStringArena(handle, 0);
+  EXPECT_EQ(kCfdSuccess, ret);
+  char* output2 = nullptr;
+  ret = CfdEncodeBase64(handle, "0102030405", &output2);
+  EXPECT_EQ(kCfdSuccess, ret);
+  EXPECT_EQ(output + 9, output2);
+
+  ret = CfdFreeHandle(handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  // free after the handle free. (the arena block is not released)
+  EXPECT_EQ(kCfdSuccess, CfdFreeStringBuffer(output2));
+  EXPECT_EQ(kCfdSuccess, CfdFreeBuffer(output));
+}
+
 TEST(cfdcapi_common, CfdGetLastErrorCode) {
   int ret = CfdGetLastErrorCode(NULL);
   EXPECT_EQ(kCfdSuccess, ret);
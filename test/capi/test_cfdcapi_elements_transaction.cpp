@@ -3,6 +3,7 @@
 
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "cfd/cfd_elements_address.h"
 #include "cfd/cfdapi_elements_transaction.h"
@@ -12,6 +13,7 @@
 #include "cfdc/cfdcapi_transaction.h"
 #include "capi/cfdc_internal.h"
 #include "cfdcore/cfdcore_amount.h"
+#include "cfdcore/cfdcore_bytedata.h"
 #include "cfdcore/cfdcore_exception.h"
 #include "cfdcore/cfdcore_elements_transaction.h"
 
@@ -494,6 +496,64 @@ TEST(cfdcapi_elements_transaction, GetTransactionData) {
   EXPECT_EQ(kCfdSuccess, ret);
 }
 
+TEST(cfdcapi_elements_transaction, TxDataHandleByBytes) {
+  void* handle = NULL;
+  int ret = CfdCreateHandle(&handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  static const char* tx_data = "0200000000020f231181a6d8fa2c5f7020948464110fbcc925f94d673d5752ce66d00250a1570000000000ffffffff0f231181a6d8fa2c5f7020948464110fbcc925f94d673d5752ce66d00250a1570100008000ffffffffd8bbe31bc590cbb6a47d2e53a956ec25d8890aefd60dcfc93efd34727554890b0683fe0819a4f9770c8a7cd5824e82975c825e017aff8ba0d6a5eb4959cf9c6f010000000023c346000004017981c1f171d7973a1fd922652f559f47d6d1506a4be2394b27a54951957f6c1801000000003b947f6002200d8510dfcf8e2330c0795c771d1e6064daab2f274ac32a6e2708df9bfa893d17a914ef3e40882e17d6e477082fcafeb0f09dc32d377b87010bad521bafdac767421d45b71b29a349c7b2ca2a06b5d8e3b5898c91df2769ed010000000029b9270002cc645552109331726c0ffadccab21620dd7a5a33260c6ac7bd1c78b98cb1e35a1976a9146c22e209d36612e0d9d2a20b814d7d8648cc7a7788ac017981c1f171d7973a1fd922652f559f47d6d1506a4be2394b27a54951957f6c1801000000000000c350000001cdb0ed311810e61036ac9255674101497850f5eee5e4320be07479c05473cbac010000000023c3460003ce4c4eac09fe317f365e45c00ffcf2e9639bc0fd792c10f72cdc173c4e5ed8791976a9149bdcb18911fa9faad6632ca43b81739082b0a19588ac00000000";
+  const std::vector<uint8_t> tx_bytes =
+      cfd::core::ByteData(tx_data).GetBytes();
+
+  void* tx_handle = NULL;
+  ret = CfdInitializeTxDataHandleByBytes(
+      handle, kCfdNetworkElementsRegtest, tx_bytes.data(), tx_bytes.size(),
+      &tx_handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    uint32_t txin_count = 0;
+    ret = CfdGetTxInCountByHandle(handle, tx_handle, &txin_count);
+    EXPECT_EQ(kCfdSuccess, ret);
+    EXPECT_EQ(2, txin_count);
+
+    size_t data_size = 0;
+    ret = CfdGetModifiedTxBytesByHandle(
+        handle, tx_handle, nullptr, 0, &data_size);
+    EXPECT_EQ(kCfdSuccess, ret);
+    EXPECT_EQ(tx_bytes.size(), data_size);
+    std::vector<uint8_t> buffer(data_size);
+    ret = CfdGetModifiedTxBytesByHandle(
+        handle, tx_handle, buffer.data(), buffer.size(), &data_size);
+    EXPECT_EQ(kCfdSuccess, ret);
+    EXPECT_EQ(tx_bytes, buffer);
+
+    char* tx_hex = nullptr;
+    ret = CfdGetModifiedTxByHandle(handle, tx_handle, &tx_hex);
+    EXPECT_EQ(kCfdSuccess, ret);
+    if (ret == kCfdSuccess) {
+      EXPECT_STREQ(tx_data, tx_hex);
+      CfdFreeStringBuffer(tx_hex);
+    }
+    CfdFreeTxDataHandle(handle, tx_handle);
+  }
+
+  void* create_handle = NULL;
+  ret = CfdInitializeTransactionByBytes(
+      handle, kCfdNetworkElementsRegtest, 2, 0, nullptr, 0, &create_handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    size_t data_size = 0;
+    ret = CfdFinalizeTransactionBytes(
+        handle, create_handle, nullptr, 0, &data_size);
+    EXPECT_EQ(kCfdSuccess, ret);
+    EXPECT_EQ(size_t{11}, data_size);
+    CfdFreeTransactionHandle(handle, create_handle);
+  }
+
+  ret = CfdFreeHandle(handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+}
+
 TEST(cfdcapi_elements_transaction, GetTransactionDataByHandle) {
   void* handle = NULL;
   int ret = CfdCreateHandle(&handle);
@@ -616,6 +676,29 @@ TEST(cfdcapi_elements_transaction, GetTransactionDataByHandle) {
       }
     }
 
+    if (ret == kCfdSuccess) {
+      uint32_t txout_count = 0;
+      size_t data_size = 0;
+      ret = CfdGetTxOutListByHandle(
+          handle, tx_handle, nullptr, 0, nullptr, 0, &txout_count, &data_size);
+      EXPECT_EQ(kCfdSuccess, ret);
+      std::vector<CfdTxOutData> txout_list(txout_count);
+      std::vector<uint8_t> buffer(data_size);
+      ret = CfdGetTxOutListByHandle(
+          handle, tx_handle, txout_list.data(), txout_count, buffer.data(),
+          data_size, &txout_count, &data_size);
+      EXPECT_EQ(kCfdSuccess, ret);
+      if ((ret == kCfdSuccess) && (txout_count > 3)) {
+        const CfdTxOutData& txout = txout_list[3];
+        EXPECT_EQ(600000000, txout.value_satoshi);
+        // unblinded value has no commitment.
+        EXPECT_EQ(0, txout.value_commitment[0]);
+        EXPECT_EQ("03ce4c4eac09fe317f365e45c00ffcf2e9639bc0fd792c10f72cdc173c4e5ed879",
+            cfd::core::ByteData(std::vector<uint8_t>(
+                txout.nonce, txout.nonce + sizeof(txout.nonce))).GetHex());
+      }
+    }
+
     ret = CfdFreeTxDataHandle(handle, tx_handle);
     EXPECT_EQ(kCfdSuccess, ret);
   }
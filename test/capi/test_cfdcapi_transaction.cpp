@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 
+#include <cstring>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -18,6 +19,7 @@
 using cfd::Utxo;
 using cfd::core::ByteData;
 using cfd::core::ByteData256;
+using cfd::core::Txid;
 
 extern std::vector<Utxo> CfdGetElementsUtxoListByC(bool use_asset);
 
@@ -98,6 +100,84 @@ TEST(cfdcapi_transaction, CreateRawTransaction) {
   EXPECT_EQ(kCfdSuccess, ret);
 }
 
+TEST(cfdcapi_transaction, CreateRawTransactionByBytes) {
+  static const char* exp_tx = "0100000002fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f0000000000eeffffffef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a0100000000ffffffff02202cb206000000001976a9148280b37df378db99f66f85c95a783a76ac7a6d5988ac9093510d000000001976a9143bde42dbee7e4dbe6a21b2d50ce2f0167faa815988ac11000000";
+  const std::vector<uint8_t> exp_bytes = ByteData(exp_tx).GetBytes();
+
+  void* handle = nullptr;
+  int ret = CfdCreateHandle(&handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  void* create_handle = nullptr;
+  ret = CfdInitializeTransactionByBytes(
+      handle, kCfdNetworkMainnet, 1, 17, nullptr, 0, &create_handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    size_t data_size = 0;
+    ret = CfdFinalizeTransactionBytes(
+        handle, create_handle, nullptr, 0, &data_size);
+    EXPECT_EQ(kCfdSuccess, ret);
+    EXPECT_EQ(size_t{10}, data_size);
+    CfdFreeTransactionHandle(handle, create_handle);
+    create_handle = nullptr;
+  }
+
+  ret = CfdInitializeTransactionByBytes(
+      handle, kCfdNetworkMainnet, 2, 0, exp_bytes.data(), exp_bytes.size(),
+      &create_handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    size_t data_size = 0;
+    ret = CfdFinalizeTransactionBytes(
+        handle, create_handle, nullptr, 0, &data_size);
+    EXPECT_EQ(kCfdSuccess, ret);
+    EXPECT_EQ(exp_bytes.size(), data_size);
+
+    std::vector<uint8_t> buffer(data_size);
+    size_t small_size = 0;
+    ret = CfdFinalizeTransactionBytes(
+        handle, create_handle, buffer.data(), 4, &small_size);
+    EXPECT_EQ(kCfdOutOfRangeError, ret);
+    EXPECT_EQ(data_size, small_size);
+
+    ret = CfdFinalizeTransactionBytes(
+        handle, create_handle, buffer.data(), buffer.size(), &data_size);
+    EXPECT_EQ(kCfdSuccess, ret);
+    EXPECT_EQ(exp_bytes, buffer);
+    CfdFreeTransactionHandle(handle, create_handle);
+  }
+
+  void* tx_handle = nullptr;
+  ret = CfdInitializeTxDataHandleByBytes(
+      handle, kCfdNetworkMainnet, nullptr, 0, &tx_handle);
+  EXPECT_EQ(kCfdIllegalArgumentError, ret);
+  ret = CfdInitializeTxDataHandleByBytes(
+      handle, kCfdNetworkMainnet, exp_bytes.data(), exp_bytes.size(),
+      &tx_handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    char* tx_hex = nullptr;
+    ret = CfdGetModifiedTxByHandle(handle, tx_handle, &tx_hex);
+    EXPECT_EQ(kCfdSuccess, ret);
+    if (ret == kCfdSuccess) {
+      EXPECT_STREQ(exp_tx, tx_hex);
+      CfdFreeStringBuffer(tx_hex);
+    }
+    size_t data_size = 0;
+    ret = CfdGetModifiedTxBytesByHandle(
+        handle, tx_handle, nullptr, 0, nullptr);
+    EXPECT_EQ(kCfdIllegalArgumentError, ret);
+    ret = CfdGetModifiedTxBytesByHandle(
+        handle, tx_handle, nullptr, 0, &data_size);
+    EXPECT_EQ(kCfdSuccess, ret);
+    EXPECT_EQ(exp_bytes.size(), data_size);
+    CfdFreeTxDataHandle(handle, tx_handle);
+  }
+
+  ret = CfdFreeHandle(handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+}
+
 TEST(cfdcapi_transaction, SignTransactionTest) {
   void* handle = nullptr;
   int ret = CfdCreateHandle(&handle);
@@ -518,6 +598,46 @@ TEST(cfdcapi_transaction, GetTransaction) {
   EXPECT_EQ(kCfdSuccess, ret);
 }
 
+TEST(cfdcapi_transaction, GetTransactionCache) {
+  static const char* kTxBase = "0200000001efcdab89674523010000000000000000000000000000000000000000000000000000000000ffffffff01406f4001000000001976a9144b8fe2da0c979ec6027dc2287e65569f41d483ec88ac";
+  static const char* kLocktimeList[] = {
+    "00000000", "01000000", "02000000", "03000000", "04000000", "05000000",
+  };
+  void* handle = NULL;
+  int ret = CfdCreateHandle(&handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  // over the cache size, and repeat on the same hex.
+  for (uint32_t loop = 0; loop < 2; ++loop) {
+    for (uint32_t index = 0; index < 6; ++index) {
+      std::string tx_hex = std::string(kTxBase) + kLocktimeList[index];
+      for (uint32_t repeat = 0; repeat < 2; ++repeat) {
+        uint32_t locktime = 0xffffffff;
+        ret = CfdGetTxInfo(
+            handle, kCfdNetworkMainnet, tx_hex.c_str(), nullptr, nullptr,
+            nullptr, nullptr, nullptr, nullptr, &locktime);
+        EXPECT_EQ(kCfdSuccess, ret);
+        EXPECT_EQ(index, locktime);
+        uint32_t count = 0;
+        ret = CfdGetTxOutCount(
+            handle, kCfdNetworkMainnet, tx_hex.c_str(), &count);
+        EXPECT_EQ(kCfdSuccess, ret);
+        EXPECT_EQ(1, count);
+      }
+    }
+  }
+
+  // the parse error is not cached.
+  uint32_t count = 0;
+  for (uint32_t repeat = 0; repeat < 2; ++repeat) {
+    ret = CfdGetTxInCount(handle, kCfdNetworkMainnet, "0200", &count);
+    EXPECT_NE(kCfdSuccess, ret);
+  }
+
+  ret = CfdFreeHandle(handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+}
+
 TEST(cfdcapi_transaction, GetTransactionByHandle) {
   static const char* exp_tx = "0100000000010136641869ca081e70f394c6948e8af409e18b619df2ed74aa106c1ca29787b96e0100000023220020a16b5755f7f6f96dbd65f5f0d6ab9418b89af4b1f14a1bb8a09062c35f0dcb54ffffffff0200e9a435000000001976a914389ffce9cd9ae88dcc0631e88a821ffdbe9bfe2688acc0832f05000000001976a9147480a33f950689af511e6e84c138dbbd3c3ee41588ac080047304402206ac44d672dac41f9b00e28f4df20c52eeb087207e8d758d76d92c6fab3b73e2b0220367750dbbe19290069cba53d096f44530e4f98acaa594810388cf7409a1870ce01473044022068c7946a43232757cbdf9176f009a928e1cd9a1a8c212f15c1e11ac9f2925d9002205b75f937ff2f9f3c1246e547e54f62e027f64eefa2695578cc6432cdabce271502473044022059ebf56d98010a932cf8ecfec54c48e6139ed6adb0728c09cbe1e4fa0915302e022007cd986c8fa870ff5d2b3a89139c9fe7e499259875357e20fcbb15571c76795403483045022100fbefd94bd0a488d50b79102b5dad4ab6ced30c4069f1eaa69a4b5a763414067e02203156c6a5c9cf88f91265f5a942e96213afae16d83321c8b31bb342142a14d16381483045022100a5263ea0553ba89221984bd7f0b13613db16e7a70c549a86de0cc0444141a407022005c360ef0ae5a5d4f9f2f87a56c1546cc8268cab08c73501d6b3be2e1e1a8a08824730440220525406a1482936d5a21888260dc165497a90a15669636d8edca6b9fe490d309c022032af0c646a34a44d1f4576bf6a4a74b67940f8faa84c7df9abe12a01a11e2b4783cf56210307b8ae49ac90a048e9b53357a2354b3334e9c8bee813ecb98e99a7e07e8c3ba32103b28f0c28bfab54554ae8c658ac5c3e0ce6e79ad336331f78c428dd43eea8449b21034b8113d703413d57761b8b9781957b8c0ac1dfe69f492580ca4195f50376ba4a21033400f6afecb833092a9a21cfdf1ed1376e58c5d1f47de74683123987e967a8f42103a6d48b1131e94ba04d9737d61acdaa1322008af9602b3b14862c07a1789aac162102d8b661b0b3302ee2f162b09e07a55ad5dfbe673a9f01d9f0c19617681024306b56ae00000000";
 
@@ -659,6 +779,100 @@ TEST(cfdcapi_transaction, GetTransactionByHandle) {
   EXPECT_EQ(kCfdSuccess, ret);
 }
 
+TEST(cfdcapi_transaction, GetTxListByHandle) {
+  static const char* exp_tx = "0100000000010136641869ca081e70f394c6948e8af409e18b619df2ed74aa106c1ca29787b96e0100000023220020a16b5755f7f6f96dbd65f5f0d6ab9418b89af4b1f14a1bb8a09062c35f0dcb54ffffffff0200e9a435000000001976a914389ffce9cd9ae88dcc0631e88a821ffdbe9bfe2688acc0832f05000000001976a9147480a33f950689af511e6e84c138dbbd3c3ee41588ac080047304402206ac44d672dac41f9b00e28f4df20c52eeb087207e8d758d76d92c6fab3b73e2b0220367750dbbe19290069cba53d096f44530e4f98acaa594810388cf7409a1870ce01473044022068c7946a43232757cbdf9176f009a928e1cd9a1a8c212f15c1e11ac9f2925d9002205b75f937ff2f9f3c1246e547e54f62e027f64eefa2695578cc6432cdabce271502473044022059ebf56d98010a932cf8ecfec54c48e6139ed6adb0728c09cbe1e4fa0915302e022007cd986c8fa870ff5d2b3a89139c9fe7e499259875357e20fcbb15571c76795403483045022100fbefd94bd0a488d50b79102b5dad4ab6ced30c4069f1eaa69a4b5a763414067e02203156c6a5c9cf88f91265f5a942e96213afae16d83321c8b31bb342142a14d16381483045022100a5263ea0553ba89221984bd7f0b13613db16e7a70c549a86de0cc0444141a407022005c360ef0ae5a5d4f9f2f87a56c1546cc8268cab08c73501d6b3be2e1e1a8a08824730440220525406a1482936d5a21888260dc165497a90a15669636d8edca6b9fe490d309c022032af0c646a34a44d1f4576bf6a4a74b67940f8faa84c7df9abe12a01a11e2b4783cf56210307b8ae49ac90a048e9b53357a2354b3334e9c8bee813ecb98e99a7e07e8c3ba32103b28f0c28bfab54554ae8c658ac5c3e0ce6e79ad336331f78c428dd43eea8449b21034b8113d703413d57761b8b9781957b8c0ac1dfe69f492580ca4195f50376ba4a21033400f6afecb833092a9a21cfdf1ed1376e58c5d1f47de74683123987e967a8f42103a6d48b1131e94ba04d9737d61acdaa1322008af9602b3b14862c07a1789aac162102d8b661b0b3302ee2f162b09e07a55ad5dfbe673a9f01d9f0c19617681024306b56ae00000000";
+
+  void* handle = NULL;
+  int ret = CfdCreateHandle(&handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+
+  void* tx_handle = NULL;
+  ret = CfdInitializeTxDataHandle(handle, kCfdNetworkMainnet, exp_tx, &tx_handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    // size query
+    uint32_t txin_count = 0;
+    uint32_t witness_count = 0;
+    size_t data_size = 0;
+    ret = CfdGetTxInListByHandle(
+        handle, tx_handle, kCfdTxWitnessStackNormal, nullptr, 0, nullptr, 0,
+        nullptr, 0, &txin_count, &witness_count, &data_size);
+    EXPECT_EQ(kCfdSuccess, ret);
+    EXPECT_EQ(1, txin_count);
+    EXPECT_EQ(8, witness_count);
+
+    std::vector<CfdTxInData> txin_list(txin_count);
+    std::vector<CfdTxDataRange> witness_list(witness_count);
+    std::vector<uint8_t> buffer(data_size);
+    ret = CfdGetTxInListByHandle(
+        handle, tx_handle, kCfdTxWitnessStackNormal, txin_list.data(),
+        txin_count, witness_list.data(), witness_count, buffer.data(),
+        data_size - 1, &txin_count, &witness_count, &data_size);
+    EXPECT_EQ(kCfdOutOfRangeError, ret);
+    ret = CfdGetTxInListByHandle(
+        handle, tx_handle, kCfdTxWitnessStackNormal, txin_list.data(),
+        txin_count, witness_list.data(), witness_count, buffer.data(),
+        data_size, &txin_count, &witness_count, &data_size);
+    EXPECT_EQ(kCfdSuccess, ret);
+    if (ret == kCfdSuccess) {
+      const CfdTxInData& txin = txin_list[0];
+      EXPECT_EQ("6eb98797a21c6c10aa74edf29d618be109f48a8e94c694f3701e08ca69186436",
+          Txid(ByteData256(std::vector<uint8_t>(
+              txin.txid, txin.txid + sizeof(txin.txid)))).GetHex());
+      EXPECT_EQ(1, txin.vout);
+      EXPECT_EQ(4294967295, txin.sequence);
+      EXPECT_EQ("220020a16b5755f7f6f96dbd65f5f0d6ab9418b89af4b1f14a1bb8a09062c35f0dcb54",
+          ByteData(std::vector<uint8_t>(
+              buffer.begin() + txin.script_sig_offset,
+              buffer.begin() + txin.script_sig_offset + txin.script_sig_size)).GetHex());
+      EXPECT_EQ(0, txin.witness_index);
+      EXPECT_EQ(8, txin.witness_count);
+      const CfdTxDataRange& stack = witness_list[7];
+      char* stack_data = nullptr;
+      ret = CfdGetTxInWitnessByHandle(
+          handle, tx_handle, kCfdTxWitnessStackNormal, 0, 7, &stack_data);
+      EXPECT_EQ(kCfdSuccess, ret);
+      if (ret == kCfdSuccess) {
+        EXPECT_EQ(std::string(stack_data),
+            ByteData(std::vector<uint8_t>(
+                buffer.begin() + stack.offset,
+                buffer.begin() + stack.offset + stack.size)).GetHex());
+        CfdFreeStringBuffer(stack_data);
+      }
+    }
+
+    uint32_t txout_count = 0;
+    ret = CfdGetTxOutListByHandle(
+        handle, tx_handle, nullptr, 0, nullptr, 0, &txout_count, &data_size);
+    EXPECT_EQ(kCfdSuccess, ret);
+    EXPECT_EQ(2, txout_count);
+    std::vector<CfdTxOutData> txout_list(txout_count);
+    buffer.resize(data_size);
+    ret = CfdGetTxOutListByHandle(
+        handle, tx_handle, txout_list.data(), txout_count, buffer.data(),
+        data_size, &txout_count, &data_size);
+    EXPECT_EQ(kCfdSuccess, ret);
+    if (ret == kCfdSuccess) {
+      const CfdTxOutData& txout = txout_list[1];
+      EXPECT_EQ(87000000, txout.value_satoshi);
+      EXPECT_EQ("76a9147480a33f950689af511e6e84c138dbbd3c3ee41588ac",
+          ByteData(std::vector<uint8_t>(
+              buffer.begin() + txout.locking_script_offset,
+              buffer.begin() + txout.locking_script_offset +
+                  txout.locking_script_size)).GetHex());
+      EXPECT_EQ(0, txout.asset[0]);
+      EXPECT_EQ(0, txout.value_commitment[0]);
+      EXPECT_EQ(0, txout.nonce[0]);
+    }
+
+    ret = CfdFreeTxDataHandle(handle, tx_handle);
+    EXPECT_EQ(kCfdSuccess, ret);
+  }
+
+  ret = CfdFreeHandle(handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+}
+
 TEST(cfdcapi_transaction, UpdateTxOutAmount) {
   static const char* exp_tx = "0100000000010136641869ca081e70f394c6948e8af409e18b619df2ed74aa106c1ca29787b96e0100000023220020a16b5755f7f6f96dbd65f5f0d6ab9418b89af4b1f14a1bb8a09062c35f0dcb54ffffffff0200e9a435000000001976a914389ffce9cd9ae88dcc0631e88a821ffdbe9bfe2688acc0832f05000000001976a9147480a33f950689af511e6e84c138dbbd3c3ee41588ac080047304402206ac44d672dac41f9b00e28f4df20c52eeb087207e8d758d76d92c6fab3b73e2b0220367750dbbe19290069cba53d096f44530e4f98acaa594810388cf7409a1870ce01473044022068c7946a43232757cbdf9176f009a928e1cd9a1a8c212f15c1e11ac9f2925d9002205b75f937ff2f9f3c1246e547e54f62e027f64eefa2695578cc6432cdabce271502473044022059ebf56d98010a932cf8ecfec54c48e6139ed6adb0728c09cbe1e4fa0915302e022007cd986c8fa870ff5d2b3a89139c9fe7e499259875357e20fcbb15571c76795403483045022100fbefd94bd0a488d50b79102b5dad4ab6ced30c4069f1eaa69a4b5a763414067e02203156c6a5c9cf88f91265f5a942e96213afae16d83321c8b31bb342142a14d16381483045022100a5263ea0553ba89221984bd7f0b13613db16e7a70c549a86de0cc0444141a407022005c360ef0ae5a5d4f9f2f87a56c1546cc8268cab08c73501d6b3be2e1e1a8a08824730440220525406a1482936d5a21888260dc165497a90a15669636d8edca6b9fe490d309c022032af0c646a34a44d1f4576bf6a4a74b67940f8faa84c7df9abe12a01a11e2b4783cf56210307b8ae49ac90a048e9b53357a2354b3334e9c8bee813ecb98e99a7e07e8c3ba32103b28f0c28bfab54554ae8c658ac5c3e0ce6e79ad336331f78c428dd43eea8449b21034b8113d703413d57761b8b9781957b8c0ac1dfe69f492580ca4195f50376ba4a21033400f6afecb833092a9a21cfdf1ed1376e58c5d1f47de74683123987e967a8f42103a6d48b1131e94ba04d9737d61acdaa1322008af9602b3b14862c07a1789aac162102d8b661b0b3302ee2f162b09e07a55ad5dfbe673a9f01d9f0c19617681024306b56ae00000000";
 
@@ -728,6 +942,124 @@ TEST(cfdcapi_transaction, CfdAddSignWithPrivkeySimple) {
   EXPECT_EQ(kCfdSuccess, ret);
 }
 
+TEST(cfdcapi_transaction, AddSignListByHandle) {
+  static const char* tx_hex = "0100000002fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f0000000000eeffffffef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a0100000000ffffffff02202cb206000000001976a9148280b37df378db99f66f85c95a783a76ac7a6d5988ac9093510d000000001976a9143bde42dbee7e4dbe6a21b2d50ce2f0167faa815988ac11000000";
+  static const char* exp_tx_hex = "01000000000102fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f0000000000eeffffffef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a010000001716001473a4fc7f4c3cd762c86986f61abb7274d3914bf5ffffffff02202cb206000000001976a9148280b37df378db99f66f85c95a783a76ac7a6d5988ac9093510d000000001976a9143bde42dbee7e4dbe6a21b2d50ce2f0167faa815988ac000247304402205c933cb3e81a1cb298e62e237169714bbc3a73c071d5c95d4b8e96b658913d8a022034075443df871165b5c998ead5e728d269182edde68b8b23a9c52a91d69293d0012102715ed9a5f16153c5216a6751b7d84eba32076f0b607550a58b209077ab7c30ad11000000";
+  static const char* txid =
+      "8ac60eb9575db5b2d987e29f301b5b819ea83a5c6579d282d189cc04b8e151ef";
+  const std::vector<uint8_t> txid_bytes = Txid(txid).GetData().GetBytes();
+
+  void* handle = NULL;
+  int ret = CfdCreateHandle(&handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  EXPECT_FALSE((NULL == handle));
+
+  void* create_handle = nullptr;
+  ret = CfdInitializeTransaction(
+      handle, kCfdNetworkMainnet, 2, 0, tx_hex, &create_handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    // the utxo is set from the entry. (without CfdSetTransactionUtxoData)
+    CfdTxInSignData sign_list[2];
+    memset(sign_list, 0, sizeof(sign_list));
+    memcpy(sign_list[0].txid, txid_bytes.data(), sizeof(sign_list[0].txid));
+    sign_list[0].vout = 1;
+    sign_list[0].privkey =
+        "cRVLMWHogUo51WECRykTbeLNbm5c57iEpSegjdxco3oef6o5dbFi";
+    sign_list[0].sighash_type = kCfdSigHashAll;
+    sign_list[0].amount = 112340000;
+    sign_list[0].descriptor =
+        "sh(wpkh(02715ed9a5f16153c5216a6751b7d84eba32076f0b607550a58b209077ab7c30ad))";
+    // error: privkey, pubkey and signature are empty.
+    memcpy(sign_list[1].txid, txid_bytes.data(), sizeof(sign_list[1].txid));
+    sign_list[1].vout = 1;
+    sign_list[1].hash_type = kCfdP2shP2wpkh;
+    sign_list[1].sighash_type = kCfdSigHashAll;
+
+    int result_list[2] = {-1, -1};
+    ret = CfdAddSignListByHandle(
+        handle, create_handle, sign_list, 2, true, result_list);
+    EXPECT_EQ(kCfdIllegalArgumentError, ret);
+    EXPECT_EQ(kCfdSuccess, result_list[0]);
+    EXPECT_EQ(kCfdIllegalArgumentError, result_list[1]);
+    EXPECT_EQ(kCfdIllegalArgumentError, CfdGetLastErrorCode(handle));
+
+    char* tx_string = nullptr;
+    ret = CfdFinalizeTransaction(handle, create_handle, &tx_string);
+    EXPECT_EQ(kCfdSuccess, ret);
+    if (ret == kCfdSuccess) {
+      EXPECT_STREQ(exp_tx_hex, tx_string);
+      CfdFreeStringBuffer(tx_string);
+    }
+
+    ret = CfdAddSignListByHandle(
+        handle, create_handle, nullptr, 0, true, nullptr);
+    EXPECT_EQ(kCfdSuccess, ret);
+    ret = CfdAddSignListByHandle(
+        handle, create_handle, nullptr, 1, true, nullptr);
+    EXPECT_EQ(kCfdIllegalArgumentError, ret);
+    CfdFreeTransactionHandle(handle, create_handle);
+  }
+
+  ret = CfdFreeHandle(handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+}
+
+TEST(cfdcapi_transaction, AddSignListByHandleTaproot) {
+  static const char* exp_tx_hex = "0200000000010116d975e4c2cea30f72f4f5fe528f5a0727d9ea149892a50c030d44423088ea2f0000000000ffffffff0130f1029500000000160014164e985d0fc92c927a66c0cbaf78e6ea389629d5014151df55894d1a024c244e20ecedc39cae39fa6d43653305b7f32605eea6359415a7ceef44c52a2f26be2e06d33d79c2e90b5dfaebcb4f79e242134121e0b9579e0100000000";
+  static const char* txid =
+      "2fea883042440d030ca5929814ead927075a8f52fef5f4720fa3cec2e475d916";
+  const std::vector<uint8_t> txid_bytes = Txid(txid).GetData().GetBytes();
+
+  void* handle = NULL;
+  int ret = CfdCreateHandle(&handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  EXPECT_FALSE((NULL == handle));
+
+  void* create_handle = nullptr;
+  ret = CfdInitializeTransaction(
+      handle, kCfdNetworkRegtest, 2, 0, nullptr, &create_handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+  if (ret == kCfdSuccess) {
+    ret = CfdAddTransactionInput(handle, create_handle, txid, 0, 0xffffffff);
+    EXPECT_EQ(kCfdSuccess, ret);
+    ret = CfdAddTransactionOutput(handle, create_handle, 2499998000,
+        "bcrt1qze8fshg0eykfy7nxcr96778xagufv2w429wx40", nullptr, nullptr);
+    EXPECT_EQ(kCfdSuccess, ret);
+
+    CfdTxInSignData sign_data;
+    memset(&sign_data, 0, sizeof(sign_data));
+    memcpy(sign_data.txid, txid_bytes.data(), sizeof(sign_data.txid));
+    sign_data.vout = 0;
+    sign_data.privkey =
+        "305e293b010d29bf3c888b617763a438fee9054c8cab66eb12ad078f819d9f27";
+    sign_data.sighash_type = kCfdSigHashAll;
+    sign_data.amount = 2499999000;
+    sign_data.locking_script =
+        "51201777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb";
+    sign_data.aux_rand =
+        "2fea883042440d030ca5929814ead927075a8f52fef5f4720fa3cec2e475d916";
+
+    int result = -1;
+    ret = CfdAddSignListByHandle(
+        handle, create_handle, &sign_data, 1, true, &result);
+    EXPECT_EQ(kCfdSuccess, ret);
+    EXPECT_EQ(kCfdSuccess, result);
+
+    char* tx_string = nullptr;
+    ret = CfdFinalizeTransaction(handle, create_handle, &tx_string);
+    EXPECT_EQ(kCfdSuccess, ret);
+    if (ret == kCfdSuccess) {
+      EXPECT_STREQ(exp_tx_hex, tx_string);
+      CfdFreeStringBuffer(tx_string);
+    }
+    CfdFreeTransactionHandle(handle, create_handle);
+  }
+
+  ret = CfdFreeHandle(handle);
+  EXPECT_EQ(kCfdSuccess, ret);
+}
+
 TEST(cfdcapi_transaction, CfdCreateSighash) {
   static const char* tx_hex = "0100000002fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f0000000000eeffffffef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a0100000000ffffffff02202cb206000000001976a9148280b37df378db99f66f85c95a783a76ac7a6d5988ac9093510d000000001976a9143bde42dbee7e4dbe6a21b2d50ce2f0167faa815988ac11000000";
 
@@ -425,6 +425,7 @@ TEST(CoinSelection, SelectCoins_Simple_SelectCoinsBnB)
 
   option_params.InitializeTxSizeInfo();
   option_params.SetEffectiveFeeBaserate(2);
+  option_params.SetCollectStatistics(true);
 
   EXPECT_NO_THROW((select_utxos = coin_select.SelectCoins(target_value, utxos,
       exp_filter, option_params, tx_fee, &select_value, &fee_value, &use_bnb)));
@@ -436,6 +437,23 @@ TEST(CoinSelection, SelectCoins_Simple_SelectCoinsBnB)
     EXPECT_EQ(select_utxos[1].amount, static_cast<int64_t>(14938590));
   }
   EXPECT_TRUE(use_bnb);
+
+  const cfd::CoinSelectionStatistics& statistics = coin_select.GetStatistics();
+  EXPECT_TRUE(statistics.searched_bnb);
+  EXPECT_EQ(statistics.utxo_count, static_cast<uint32_t>(utxos.size()));
+  EXPECT_LE(uint64_t{1}, statistics.bnb_tries);
+  EXPECT_LE(statistics.bnb_backtracks, statistics.bnb_tries);
+  EXPECT_EQ(statistics.knapsack_iterations, uint64_t{0});
+  EXPECT_LE(0, statistics.waste);
+  EXPECT_EQ(statistics.knapsack_excess, int64_t{0});
+
+  // not collected without the option.
+  option_params.SetCollectStatistics(false);
+  EXPECT_NO_THROW((select_utxos = coin_select.SelectCoins(target_value, utxos,
+      exp_filter, option_params, tx_fee, &select_value, &fee_value, &use_bnb)));
+  EXPECT_FALSE(coin_select.GetStatistics().searched_bnb);
+  EXPECT_EQ(coin_select.GetStatistics().bnb_tries, uint64_t{0});
+  EXPECT_EQ(coin_select.GetStatistics().total_elapsed_usec, uint64_t{0});
 }
 
 TEST(CoinSelection, SelectCoins_Simple_SelectCoinsBnB_single)
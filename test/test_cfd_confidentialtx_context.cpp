@@ -128,6 +128,39 @@ TEST(ConfidentialTransactionContext, AddTxInOut)
   }
 }
 
+TEST(ConfidentialTransactionContext, FindTxInOutMiss)
+{
+  ConfidentialTransactionContext txc(2, 0);
+  ElementsConfidentialAddress ct_addr("CTEyBCf1WzQDpbv6sXLTnFaknGK2UJMHqjyGJjQGq9NEytBR2JLHR9cHJSk4MbLVcKQYWsWERUEYN6R3");
+  Address addr = ct_addr.GetUnblindedAddress();
+  Script other_script("0014925d4028880bd0c9d68fbc7fc7dfee976698629c");
+  ConfidentialAssetId asset("5ac9f65c0efcc4775e0baec4ec03abdde22473cd3cf33c0419ca290e0751b225");
+  Txid txid("4aa201f333e80b8f62ba5b593edb47b4730212e2917b21279f389ba1c14588a3");
+  txc.AddTxIn(OutPoint(txid, 0));
+  txc.AddTxIn(OutPoint(txid, 1));
+  txc.AddTxOut(ct_addr, Amount::CreateBySatoshiAmount(100000), asset);
+
+  uint32_t index = 9;
+  EXPECT_TRUE(txc.IsFindTxOut(addr));
+  EXPECT_FALSE(txc.IsFindTxIn(OutPoint(txid, 2), &index));
+  EXPECT_EQ(index, 9);
+  EXPECT_FALSE(txc.IsFindTxOut(other_script, &index));
+  EXPECT_FALSE(txc.IsFindTxOut(Script(), &index));
+  EXPECT_EQ(index, 9);
+  EXPECT_THROW(txc.GetTxInIndex(OutPoint(txid, 2)), CfdException);
+  EXPECT_THROW(txc.GetTxOutIndex(other_script), CfdException);
+
+  // replace the txin with the same txin count.
+  txc.RemoveTxIn(0);
+  txc.AddTxIn(OutPoint(txid, 2));
+  EXPECT_FALSE(txc.IsFindTxIn(OutPoint(txid, 0)));
+  EXPECT_TRUE(txc.IsFindTxIn(OutPoint(txid, 1), &index));
+  EXPECT_EQ(index, 0);
+  EXPECT_TRUE(txc.IsFindTxIn(OutPoint(txid, 2), &index));
+  EXPECT_EQ(index, 1);
+  EXPECT_EQ(txc.GetTxInIndex(OutPoint(txid, 2)), 1);
+}
+
 TEST(ConfidentialTransactionContext, CalculateSimpleFeeTest)
 {
     ConfidentialTransactionContext tx(
@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <sstream>
 #include <vector>
 
 #include "cfd/cfd_common.h"
@@ -18,6 +19,7 @@
 #include "cfdcore/cfdcore_util.h"
 
 using cfd::core::CfdException;
+using cfd::core::CfdError;
 using cfd::core::Address;
 using cfd::core::AddressType;
 using cfd::core::Amount;
@@ -336,6 +338,16 @@ TEST(Psbt, UsecaseTest2) {
     throw except;
   }
 
+  // Parallel signer (same result as the serial signer)
+  try {
+    Psbt psbt_parallel(psbt);
+    psbt_parallel.Sign(privkey_list1, true, 2);
+    EXPECT_STREQ(psbt1.GetBase64().c_str(), psbt_parallel.GetBase64().c_str());
+  } catch (const CfdException& except) {
+    EXPECT_STREQ("", except.what());
+    throw except;
+  }
+
   // Combiner
   try {
     psbt.Combine(psbt1);
@@ -347,6 +359,31 @@ TEST(Psbt, UsecaseTest2) {
     throw except;
   }
 
+  // Transaction context bridge
+  try {
+    TransactionContext context = psbt.GetTransactionContext();
+    EXPECT_STREQ(psbt.GetTransaction().GetHex().c_str(),
+        context.GetHex().c_str());
+    EXPECT_EQ(psbt.GetFeeAmount().GetSatoshiValue(),
+        context.GetFeeAmount().GetSatoshiValue());
+
+    OutPoint outpoint1(utxo_list1[0].txid, utxo_list1[0].vout);
+    context.SignWithPrivkeySimple(outpoint1,
+        privkey_list1[0].GeneratePubkey(), privkey_list1[0], SigHashType(),
+        utxo_list1[0].amount, AddressType::kP2wpkhAddress);
+    Psbt psbt_context(psbt);
+    psbt_context.SetTxInFinalScriptByContext(context);
+    EXPECT_TRUE(psbt_context.IsFinalizedInput(outpoint1));
+    auto stack = psbt_context.GetTxInFinalScript(outpoint1, true);
+    EXPECT_EQ(2, stack.size());
+    EXPECT_EQ(
+        context.GetTxIn(outpoint1).GetScriptWitness().GetWitness()[0].GetHex(),
+        stack[0].GetHex());
+  } catch (const CfdException& except) {
+    EXPECT_STREQ("", except.what());
+    throw except;
+  }
+
   // Input Finalizer
   try {
     EXPECT_FALSE(psbt.IsFinalized());
@@ -357,11 +394,64 @@ TEST(Psbt, UsecaseTest2) {
     EXPECT_STREQ("70736274ff0100fd86010200000007f834da7cb5e183fc815f7846227284660fa4a0a583be2bfb4a535bf425e531de0100000000ffffffff5aef6a3bce7624951ae5b9e8c0908e8ff74721eedf7a0994d5bf1efc7dee82810200000000ffffffffa92dd64952789efd1444938e9ce5b106e7280089c4dc4a78b3da7c7a2b69d93f0300000000fffffffffcf72c7bb8881945955e48f54e6081b51901836484e5c48a9925061029c405d10400000000ffffffffa0be1a4d9a22c832d2d20a3a084f010d09a9ab41fb3e2dedbd46eb0104578fb90500000000ffffffff71a141bf5b653e2c43773305d69a8c9876944470ca1e29e4b03a0953c4beb6950100000000ffffffff3c427c95ec8ed79796f13d37d525fbe868545cd91a1eb0d89ff90980731f3a8b0700000000ffffffff0380f0fa0200000000160014b322bddce633b851ac7370ab454f0b367a0654e580f0fa0200000000160014cab8c53a6e8fc0296d1cd3915a307d51c491a555f2919800000000001600142b6e16ba38e280500f80b2c5706ef02f38d59081000000000001011f8096980000000000160014962c4e08f336d3afbc3415c9d359ae104047052001086b02473044022016d6be246613d8f20a98f79651ba6402352478bde005ba292adee40c3060f97a022061e5e264be9a892f4579bcbcd5c660405d3b95adb807c8b54caf3dc22f75f9fd012102565248460b3c186decf13db06f0724fd50b47cc3e489c30076c8363d5038cefe0001011f80969800000000001600148bf09d60b7e34f34827d8dbcb1c76390a916ca8201086b024730440220622277094f292704dfbcd95c951b95f83f8ae85b0584d0a6058548a7a0ae814e02200b913ac3fcce9780911e927997442af8de0945f03a9576a2c300bdebe08c61820121022744cfb2436e156040ec1c8fe842d9ef9a18cb40ad41f312725390c35f7bd36b0001011f8096980000000000160014f1d3ee67829225eb892ccab01e22f6a777e7e21e01086b0247304402202dc3146d944ac124e6964730524e73b3600ce84ec4c286cbcccfe7eb25cfb2a30220701661116a179ce213c14280073253c3467ef8e8a7324618ac263e337046b3a6012102e7e8dc236fa024369408d2ce4d8508048261abc297b811604da087ad71d138550001011f809698000000000016001419d65f8328b2206d9970785660ec0d34808fb07501086b02473044022062b755ad1f11cd001bb9744788c4db87d90253d337f37048cb29529eacd854050220483bbc41077c7a31cbaf7dc02acad05e28e42d2a3224c99cfb31064fa21015b00121033d874bf19b697cf6c639659547a583b86730164a5b6db01bf20a14eb9b6adb440001011f809698000000000016001412b7954a75efc2a20e86e32dc2d78647d670077901086b02473044022065ef50669cb7804a837b11c727f8a4891de3b408544c5b817fed41b3a2cdbd67022046b380b373c2368ffdce73a9b2b0f634ef83915aea9e677133caeae861a24f88012102fb061730dbde3c806b4a17a99f454c81282aecee6d46f4a975a94cdfd3a065040001011f80f0fa0200000000160014978a90460e44671a52f49a09bb59cc6794b63c8901086b024730440220779520daeb0ae58727df2578543ce32a060ed74eca86c44820e52acec43013d10220097b0815506262bf9728276db3aa227834959187455dc3f191f9fe80aa309552012103e3d244a3967e0b87765fda86c5ff38885f74993953b9584388aef30b26af6aec0001011f80969800000000001600141ce878e3a0da3b34308797fdecb76221f85418af01086b0247304402200fd024910c6207d2679ad1b9bb0ed8c0ff8d55aa603ef7c499917da20a3f417a0220086dfa0cce871385e24da90b7e20f5f1e1f9f7d707c5562bcfa66a855d7d2208012103c02325c328fed622a9d88f8f5318e05261a3c3a967b7211d7d67657e2b5e9fbe00220203473bfc8c770c1b220a2e7aae4badf6c0d7eaf29028d5b29d3438012bb289ef81182a7047602c00008000000080000000800000000002000000002202036474aff2633c351865539fb52b62b9d6fb9e4e23576628e1f0a0a7993458e06c189d6b6d862c0000800000008000000080000000000200000000220202f7f0d7d00289b7c5a581bc35276040c348de48fc414067f31ea26ad95c00550c182a7047602c0000800000008000000080010000006400000000", psbt.GetData().GetHex().c_str());
 
     psbt.Verify();
+    psbt.Verify(uint32_t{4});
+    psbt.Verify(OutPoint(utxo_list1[0].txid, utxo_list1[0].vout));
   } catch (const CfdException& except) {
     EXPECT_STREQ("", except.what());
     throw except;
   }
 
+  // Verify failing inputs: the parallel path throws the serial path error.
+  {
+    Psbt broken(psbt);
+    auto tx = broken.GetTransaction();
+    OutPoint outpoint0 = tx.GetTxIn(0).GetOutPoint();
+    OutPoint outpoint2 = tx.GetTxIn(2).GetOutPoint();
+    OutPoint outpoint5 = tx.GetTxIn(5).GetOutPoint();
+    OutPoint outpoint6 = tx.GetTxIn(6).GetOutPoint();
+    // txin[2]: another input's witness. (unmatch pubkey)
+    broken.SetTxInFinalScript(
+        outpoint2, broken.GetTxInFinalScript(outpoint0, true));
+    // txin[5]: another input's signature. (invalid signature)
+    auto stack5 = broken.GetTxInFinalScript(outpoint5, true);
+    stack5[0] = broken.GetTxInFinalScript(outpoint6, true)[0];
+    broken.SetTxInFinalScript(outpoint5, stack5);
+    // txin[6]: not finalized. (the error of txin[2] is thrown first)
+    broken.ClearTxInSignData(outpoint6);
+    EXPECT_FALSE(broken.IsFinalizedInput(outpoint6));
+
+    std::string input_error;
+    std::string serial_error;
+    std::string parallel_error;
+    CfdError input_code = CfdError::kCfdSuccess;
+    CfdError serial_code = CfdError::kCfdSuccess;
+    CfdError parallel_code = CfdError::kCfdSuccess;
+    try {
+      broken.Verify(outpoint2);
+    } catch (const CfdException& except) {
+      input_error = except.what();
+      input_code = except.GetErrorCode();
+    }
+    try {
+      broken.Verify();
+    } catch (const CfdException& except) {
+      serial_error = except.what();
+      serial_code = except.GetErrorCode();
+    }
+    try {
+      broken.Verify(uint32_t{4});
+    } catch (const CfdException& except) {
+      parallel_error = except.what();
+      parallel_code = except.GetErrorCode();
+    }
+    EXPECT_NE(CfdError::kCfdSuccess, input_code);
+    EXPECT_FALSE(input_error.empty());
+    EXPECT_EQ(input_code, serial_code);
+    EXPECT_EQ(input_error, serial_error);
+    EXPECT_EQ(serial_code, parallel_code);
+    EXPECT_EQ(serial_error, parallel_error);
+  }
+
   // Transaction Extractor
   try {
     EXPECT_TRUE(psbt.IsFinalized());
@@ -545,6 +635,79 @@ TEST(Psbt, UsecaseMultisig2) {
 }
 
 
+TEST(Psbt, CombineList) {
+  HDWallet wallet1 = HDWallet(ByteData(g_psbt_seed1));
+  HDWallet wallet2 = HDWallet(ByteData(g_psbt_seed2));
+  std::string in_path = "44h/0h/0h/0/11";
+  auto key_in1 = wallet1.GeneratePrivkeyData(NetType::kTestnet, in_path);
+  auto key_in2 = wallet2.GeneratePrivkeyData(NetType::kTestnet, in_path);
+  auto multisig = ScriptUtil::CreateMultisigRedeemScript(
+    2, std::vector<Pubkey>{key_in1.GetPubkey(), key_in2.GetPubkey()});
+  auto addr = Address(NetType::kTestnet, WitnessVersion::kVersion0, multisig);
+  Transaction utxo_tx(g_psbt_utxo_sh_wsh_multi);
+  TxIn txin1(Txid("544d545a1e53becbf9dd9b0e424e1189b8f6e46d6bc36b191816d341c2d32f69"), 0, 0xffffffff);
+  TxIn txin2(Txid("544d545a1e53becbf9dd9b0e424e1189b8f6e46d6bc36b191816d341c2d32f69"), 1, 0xffffffff);
+  SigHashType sighash_type(cfd::core::SigHashAlgorithm::kSigHashSingle, true);
+
+  // base: redeem scripts and the non-default sighash type.
+  Psbt psbt;
+  try {
+    psbt.AddTxIn(txin1);
+    psbt.AddTxIn(txin2);
+    psbt.AddTxOut(addr.GetLockingScript(), Amount(499993360));
+    psbt.AddTxOut(addr.GetLockingScript(), Amount(499993360));
+    for (uint32_t index = 0; index < 2; ++index) {
+      psbt.SetTxInUtxo(index, utxo_tx.GetTxOut(0), multisig, KeyData());
+      psbt.SetTxInSighashType(index, sighash_type);
+    }
+  } catch (const CfdException& except) {
+    EXPECT_STREQ("", except.what());
+    throw except;
+  }
+
+  Psbt psbt1(psbt);
+  Psbt psbt2(psbt);
+  Psbt psbt3(psbt);
+  try {
+    psbt1.SetTxInUtxo(0, utxo_tx.GetTxOut(0), multisig, key_in1);
+    psbt1.Sign(key_in1.GetPrivkey());
+    psbt2.SetTxInUtxo(0, utxo_tx.GetTxOut(0), multisig, key_in2);
+    psbt2.Sign(key_in2.GetPrivkey());
+    // final scripts and the global record.
+    psbt3.SetTxInFinalScript(1, std::vector<ByteData>{
+        ByteData(), ByteData("0102"), multisig.GetData()});
+    psbt3.SetGlobalRecord(
+        Psbt::CreateRecordKey(kProprietary, "cfd", 0, "dummy1"),
+        ByteData("01020304"));
+    EXPECT_TRUE(psbt3.IsFinalizedInput(1));
+  } catch (const CfdException& except) {
+    EXPECT_STREQ("", except.what());
+    throw except;
+  }
+
+  try {
+    Psbt expect(psbt);
+    expect.Combine(psbt1);
+    expect.Combine(psbt2);
+    expect.Combine(psbt3);
+    EXPECT_TRUE(expect.IsFinalizedInput(1));
+    EXPECT_EQ(sighash_type.GetSigHashFlag(),
+        expect.GetTxInSighashType(0).GetSigHashFlag());
+
+    std::vector<Psbt> psbt_list{psbt1, psbt2, psbt3};
+    Psbt psbt_serial(psbt);
+    psbt_serial.Combine(psbt_list, 1);
+    EXPECT_STREQ(expect.GetBase64().c_str(), psbt_serial.GetBase64().c_str());
+    Psbt psbt_parallel(psbt);
+    psbt_parallel.Combine(psbt_list, 2);
+    EXPECT_STREQ(expect.GetBase64().c_str(),
+        psbt_parallel.GetBase64().c_str());
+  } catch (const CfdException& except) {
+    EXPECT_STREQ("", except.what());
+    throw except;
+  }
+}
+
 TEST(Psbt, EmptyObject) {
   try {
     Psbt empty_obj;
@@ -853,6 +1016,27 @@ TEST(Psbt, SetInputOnly) {
   EXPECT_STREQ("cHNidP8BAFwCAAAAAiZ//Xbq5rbBP/uGzquqJNQkhVICM8LDgF4K12RwlXjAAQAAAAD/////fSVGKkL/LLG6VAHliTJZ2zykvPXParlxXTUWPTHJ7MAAAAAAAP////8AAAAAAAABAPYCAAAAAAEB8Zk/6OcYlULuRQYljhcCAb4pJwPNJ1rLCezhZnL9hIsAAAAAFxYAFKye+AsnrxydlcHbXXYTGTIrxC/F/////wIIBBAkAQAAABYAFAneKgQxy7NET8IsrZ2aD9CWOXIQAOH1BQAAAAAXqRRQn1mF9OkKFPuQ45MW/bTzrJdTB4cCRzBEAiAeB99yHDMiQZ6PNtB+6uR5WXW6DZ0ZYwyjzT3A1JZxcgIgFUKOe+BrZWdQFTkFC9eRo4DwC73bxQl+qXunvkAXEUoBIQJK70Ox1ax7pQFJmNY86sWDlZ0f3GbqJpnNhO6vgqKDBgAAAAABASAA4fUFAAAAABepFFCfWYX06QoU+5Djkxb9tPOsl1MHhwEDBAEAAAABBBYAFJYsTgjzNtOvvDQVydNZrhBARwUgIgYCVlJIRgs8GG3s8T2wbwck/VC0fMPkicMAdsg2PVA4zv4YKnBHYCwAAIAAAACAAAAAgAEAAAABAAAAAAEAvwIAAAABxtLqNuLoArUt2sZl2svtL4MbUmNFnhynNPXJRddRXkAAAAAAakcwRAIgEblsfS0NLo3LNxOOGKzEYHUpZa3Zy4eH31w0nfDirmYCIC6TrzG2T1Fm5WBYGVVdq+xXvnlDAPrbNwUvMd3eqZBcASED49JEo5Z+C4d2X9qGxf84iF90mTlTuVhDiK7zCyavauz/////AXhRzR0AAAAAGXapFI0gRDqRlp47yg4kDND/5NyYxj3iiKwAAAAAIgYC2faIjyhaFaahiAoiAsKyMKQtd89i2mpIrKQZgmLNo8cYnWtthiwAAIAAAACAAAAAgAAAAAABAAAAAA==", psbt2.GetBase64().c_str());
 }
 
+TEST(Psbt, CopyConstructor) {
+  Psbt psbt("cHNidP8BAFwCAAAAAiZ//Xbq5rbBP/uGzquqJNQkhVICM8LDgF4K12RwlXjAAQAAAAD/////fSVGKkL/LLG6VAHliTJZ2zykvPXParlxXTUWPTHJ7MAAAAAAAP////8AAAAAAAAAAA==");
+  HDWallet wallet2 = HDWallet(ByteData(g_psbt_seed2));
+  auto key2 = wallet2.GeneratePubkeyData(NetType::kTestnet, "44h/0h/0h/0/1");
+  psbt.SetTxInUtxo(1, Transaction(g_psbt_utxo_legacy), key2);
+
+  Psbt psbt2(psbt);
+  EXPECT_STREQ(psbt.GetBase64().c_str(), psbt2.GetBase64().c_str());
+  EXPECT_STREQ(psbt.GetTransaction().GetHex().c_str(),
+      psbt2.GetTransaction().GetHex().c_str());
+
+  // the copy does not share the structure.
+  psbt2.SetTxInSighashType(1, SigHashType());
+  EXPECT_TRUE(psbt2.IsFindTxInSighashType(1));
+  EXPECT_FALSE(psbt.IsFindTxInSighashType(1));
+
+  Psbt psbt3;
+  psbt3 = psbt2;
+  EXPECT_STREQ(psbt2.GetBase64().c_str(), psbt3.GetBase64().c_str());
+}
+
 TEST(Psbt, SetInputOnlySimpleWitness) {
   Psbt psbt("cHNidP8BAFwCAAAAAiZ//Xbq5rbBP/uGzquqJNQkhVICM8LDgF4K12RwlXjAAQAAAAD/////fSVGKkL/LLG6VAHliTJZ2zykvPXParlxXTUWPTHJ7MAAAAAAAP////8AAAAAAAAAAA==");
 
@@ -1482,4 +1666,114 @@ TEST(Psbt, GetUtxoDataList) {
     EXPECT_EQ(499995000, utxos[1].amount.GetSatoshiValue());
     EXPECT_EQ("pkh([9d6b6d86/44'/0'/0'/0/1]02d9f6888f285a15a6a1880a2202c2b230a42d77cf62da6a48aca4198262cda3c7)", utxos[1].descriptor);
   }
-}
\ No newline at end of file
+}
+
+TEST(Psbt, DecodeUtxoDataByStream) {
+  Psbt psbt("cHNidP8BAJoCAAAAAiZ//Xbq5rbBP/uGzquqJNQkhVICM8LDgF4K12RwlXjAAQAAAAD/////fSVGKkL/LLG6VAHliTJZ2zykvPXParlxXTUWPTHJ7MAAAAAAAP////8CAOH1BQAAAAAWABSzIr3c5jO4UaxzcKtFTws2egZU5QDh9QUAAAAAFgAUyrjFOm6PwCltHNORWjB9UcSRpVUAAAAAAAEA9gIAAAAAAQHxmT/o5xiVQu5FBiWOFwIBviknA80nWssJ7OFmcv2EiwAAAAAXFgAUrJ74CyevHJ2VwdtddhMZMivEL8X/////AggEECQBAAAAFgAUCd4qBDHLs0RPwiytnZoP0JY5chAA4fUFAAAAABepFFCfWYX06QoU+5Djkxb9tPOsl1MHhwJHMEQCIB4H33IcMyJBno820H7q5HlZdboNnRljDKPNPcDUlnFyAiAVQo574GtlZ1AVOQUL15GjgPALvdvFCX6pe6e+QBcRSgEhAkrvQ7HVrHulAUmY1jzqxYOVnR/cZuommc2E7q+CooMGAAAAAAEBIADh9QUAAAAAF6kUUJ9ZhfTpChT7kOOTFv2086yXUweHAQMEAQAAAAEEFgAUlixOCPM206+8NBXJ01muEEBHBSAiBgJWUkhGCzwYbezxPbBvByT9ULR8w+SJwwB2yDY9UDjO/hgqcEdgLAAAgAAAAIAAAACAAQAAAAEAAAAAAQC/AgAAAAHG0uo24ugCtS3axmXay+0vgxtSY0WeHKc09clF11FeQAAAAABqRzBEAiARuWx9LQ0ujcs3E44YrMRgdSllrdnLh4ffXDSd8OKuZgIgLpOvMbZPUWblYFgZVV2r7Fe+eUMA+ts3BS8x3d6pkFwBIQPj0kSjln4Lh3Zf2obF/ziIX3SZOVO5WEOIrvMLJq9q7P////8BeFHNHQAAAAAZdqkUjSBEOpGWnjvKDiQM0P/k3JjGPeKIrAAAAAAiAgLZ9oiPKFoVpqGICiICwrIwpC13z2LaakispBmCYs2jx0cwRAIgZuyVbpZ4PNYSLJwHcyo66ZMbaava/x82LCjtX6lnKNMCIGoW1K5G/tSNPQSSc3YTvZtR/j4kU7REbkR8Zb8sln4QASIGAtn2iI8oWhWmoYgKIgLCsjCkLXfPYtpqSKykGYJizaPHGJ1rbYYsAACAAAAAgAAAAIAAAAAAAQAAAAAiAgNHO/yMdwwbIgoueq5LrfbA1+rykCjVsp00OAErsonvgRgqcEdgLAAAgAAAAIAAAACAAAAAAAIAAAAAIgIDZHSv8mM8NRhlU5+1K2K51vueTiNXZijh8KCnmTRY4GwYnWtthiwAAIAAAACAAAAAgAAAAAACAAAAAA==");
+  std::string psbt_bytes(
+      reinterpret_cast<const char*>(psbt.GetData().GetBytes().data()),
+      psbt.GetData().GetDataSize());
+
+  std::istringstream stream(psbt_bytes);
+  std::vector<UtxoData> utxos;
+  EXPECT_NO_THROW(utxos = Psbt::DecodeUtxoDataByStream(&stream));
+  ASSERT_EQ(2, utxos.size());
+  EXPECT_EQ("c078957064d70a5e80c3c23302528524d424aaabce86fb3fc1b6e6ea76fd7f26", utxos[0].txid.GetHex());
+  EXPECT_EQ(1, utxos[0].vout);
+  EXPECT_EQ(100000000, utxos[0].amount.GetSatoshiValue());
+  EXPECT_EQ("a914509f5985f4e90a14fb90e39316fdb4f3ac97530787", utxos[0].locking_script.GetHex());
+  EXPECT_EQ(AddressType::kP2shAddress, utxos[0].address_type);
+  EXPECT_EQ("c0ecc9313d16355d71b96acff5bca43cdb593289e50154bab12cff422a46257d", utxos[1].txid.GetHex());
+  EXPECT_EQ(0, utxos[1].vout);
+  EXPECT_EQ(499995000, utxos[1].amount.GetSatoshiValue());
+  EXPECT_EQ("76a9148d20443a91969e3bca0e240cd0ffe4dc98c63de288ac", utxos[1].locking_script.GetHex());
+  EXPECT_EQ(AddressType::kP2pkhAddress, utxos[1].address_type);
+  for (uint32_t index = 0; index < 2; ++index) {
+    auto txout = psbt.GetTxInUtxo(index);
+    EXPECT_EQ(txout.GetLockingScript().GetHex(), utxos[index].locking_script.GetHex());
+    EXPECT_EQ(txout.GetValue().GetSatoshiValue(), utxos[index].amount.GetSatoshiValue());
+  }
+
+  // truncated stream
+  std::istringstream truncated_stream(psbt_bytes.substr(0, psbt_bytes.size() / 2));
+  EXPECT_THROW(Psbt::DecodeUtxoDataByStream(&truncated_stream), CfdException);
+
+  // invalid magic
+  std::istringstream invalid_stream(std::string("psbx") + psbt_bytes.substr(4));
+  EXPECT_THROW(Psbt::DecodeUtxoDataByStream(&invalid_stream), CfdException);
+}
+
+TEST(Psbt, DecodeUtxoDataByStreamV2) {
+  const std::string magic = "70736274ff";
+  const std::string tx_version = "01fb0402000000";
+  const std::string input_count = "01040101";
+  const std::string output_count = "01050100";
+  const std::string txid_record = "010e20"
+      "267ffd76eae6b6c13ffb86ceabaa24d424855202"
+      "33c2c3805e0ad764709578c0";
+  const std::string vout_record = "010f0401000000";
+  auto to_stream_bytes = [](const std::string& hex) -> std::string {
+    ByteData data(hex);
+    return std::string(
+        reinterpret_cast<const char*>(data.GetBytes().data()),
+        data.GetDataSize());
+  };
+
+  std::istringstream stream(to_stream_bytes(
+      magic + tx_version + input_count + output_count + "00" +
+      txid_record + vout_record + "00"));
+  std::vector<UtxoData> utxos;
+  EXPECT_NO_THROW(utxos = Psbt::DecodeUtxoDataByStream(&stream));
+  ASSERT_EQ(1, utxos.size());
+  EXPECT_EQ("c078957064d70a5e80c3c23302528524d424aaabce86fb3fc1b6e6ea76fd7f26", utxos[0].txid.GetHex());
+  EXPECT_EQ(1, utxos[0].vout);
+
+  // input count not found
+  std::istringstream no_count_stream(to_stream_bytes(
+      magic + tx_version + output_count + "00" +
+      txid_record + vout_record + "00"));
+  try {
+    Psbt::DecodeUtxoDataByStream(&no_count_stream);
+    ADD_FAILURE();
+  } catch (const CfdException& except) {
+    EXPECT_EQ(CfdError::kCfdIllegalArgumentError, except.GetErrorCode());
+  }
+
+  // previous txid not found
+  std::istringstream no_txid_stream(to_stream_bytes(
+      magic + tx_version + input_count + output_count + "00" +
+      vout_record + "00"));
+  try {
+    Psbt::DecodeUtxoDataByStream(&no_txid_stream);
+    ADD_FAILURE();
+  } catch (const CfdException& except) {
+    EXPECT_EQ(CfdError::kCfdIllegalArgumentError, except.GetErrorCode());
+  }
+}
+
+TEST(Psbt, TxInIndexMap) {
+  Txid txid("c078957064d70a5e80c3c23302528524d424aaabce86fb3fc1b6e6ea76fd7f26");
+  Psbt psbt(2, 0);
+  for (uint32_t vout = 0; vout < 3; ++vout) {
+    EXPECT_EQ(vout, psbt.AddTxIn(OutPoint(txid, vout)));
+  }
+  uint32_t index = 0;
+  EXPECT_TRUE(psbt.IsFindTxIn(OutPoint(txid, 2), &index));
+  EXPECT_EQ(2, index);
+  EXPECT_FALSE(psbt.IsFindTxIn(OutPoint(txid, 3)));
+
+  // added txin after the index map is built.
+  EXPECT_EQ(3, psbt.AddTxIn(OutPoint(txid, 3)));
+  EXPECT_EQ(3, psbt.GetTxInIndex(OutPoint(txid, 3)));
+  EXPECT_EQ(0, psbt.GetTxInIndex(OutPoint(txid, 0)));
+
+  // replaced by the other psbt with the same txin count.
+  Psbt psbt2(2, 0);
+  for (uint32_t vout = 0; vout < 4; ++vout) {
+    psbt2.AddTxIn(OutPoint(txid, 10 - vout));
+  }
+  psbt = psbt2;
+  EXPECT_FALSE(psbt.IsFindTxIn(OutPoint(txid, 0)));
+  EXPECT_EQ(3, psbt.GetTxInIndex(OutPoint(txid, 7)));
+  EXPECT_THROW(psbt.GetTxInIndex(OutPoint(txid, 3)), CfdException);
+}
@@ -115,6 +115,42 @@ TEST(TransactionContext, AddTxInOut)
   }
 }
 
+TEST(TransactionContext, FindTxInOutMiss)
+{
+  TransactionContext txc(2, 0);
+  Address addr("1ELuNB5fLNUcrLzb93oJDPmjxjnsVwhNHn");
+  Address other_addr("17iJ5ssEuAcrD267chtACp6qLzVbPvwrms");
+  Txid txid("4aa201f333e80b8f62ba5b593edb47b4730212e2917b21279f389ba1c14588a3");
+  txc.AddTxIn(OutPoint(txid, 0));
+  txc.AddTxIn(OutPoint(txid, 1));
+  txc.AddTxOut(addr, Amount(int64_t{100000}));
+
+  uint32_t index = 9;
+  EXPECT_FALSE(txc.IsFindTxIn(OutPoint(txid, 2), &index));
+  EXPECT_EQ(index, 9);
+  EXPECT_FALSE(txc.IsFindTxOut(other_addr, &index));
+  EXPECT_FALSE(txc.IsFindTxOut(other_addr.GetLockingScript(), &index));
+  EXPECT_EQ(index, 9);
+  EXPECT_THROW(txc.GetTxInIndex(OutPoint(txid, 2)), CfdException);
+  EXPECT_THROW(txc.GetTxOutIndex(other_addr), CfdException);
+
+  // replace the txin with the same txin count.
+  txc.RemoveTxIn(0);
+  txc.AddTxIn(OutPoint(txid, 2));
+  EXPECT_FALSE(txc.IsFindTxIn(OutPoint(txid, 0)));
+  EXPECT_TRUE(txc.IsFindTxIn(OutPoint(txid, 1), &index));
+  EXPECT_EQ(index, 0);
+  EXPECT_TRUE(txc.IsFindTxIn(OutPoint(txid, 2), &index));
+  EXPECT_EQ(index, 1);
+  EXPECT_EQ(txc.GetTxInIndex(OutPoint(txid, 2)), 1);
+
+  TransactionContext copy_txc;
+  copy_txc = txc;
+  EXPECT_TRUE(copy_txc.IsFindTxIn(OutPoint(txid, 2), &index));
+  EXPECT_EQ(index, 1);
+  EXPECT_FALSE(copy_txc.IsFindTxIn(OutPoint(txid, 0)));
+}
+
 TEST(TransactionContext, CreateP2wpkhSignatureHash_Test) {
   // input-only transaction
   std::string tx = "0200000001efcdab89674523010000000000000000000000000000000000000000000000000000000000ffffffff01406f4001000000001976a9144b8fe2da0c979ec6027dc2287e65569f41d483ec88ac00000000";
@@ -944,3 +980,110 @@ TEST(TransactionContext, SplitTxOut)
     "0200000001ffa8db90b81db256874ff7a98fb7202cdc0b91b5b02d7c3427c4190adc66981f0000000000ffffffff0300943577000000002251201777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb18ddf505000000001600141462eca4b9b8d8df63550abd24d0cb64e8f2d7460084d7170000000017a914d081b8e259b744aa903e1831cfce8956941273ce8700000000",
     tx.GetHex());
 }
+
+TEST(TransactionContext, PayoutBatcher) {
+  AddressFactory factory(NetType::kRegtest);
+  std::vector<UtxoData> utxos;
+  for (uint32_t index = 0; index < 4; ++index) {
+    UtxoData utxo;
+    utxo.block_height = 0;
+    utxo.binary_data = nullptr;
+    utxo.txid = Txid("4aa201f333e80b8f62ba5b593edb47b4730212e2917b21279f389ba1c14588a3");
+    utxo.vout = index;
+    utxo.locking_script = Script("0014f330ed8383f8afdc977dd88600eb8ff120ba15e4");
+    utxo.address = factory.GetAddress("bcrt1q7vcwmqurlzhae9mamzrqp6u07yst590y5ujv3w");
+    utxo.descriptor = "wpkh(0359bc91953b251ae501758673b9d6dd78eafa327190741536025d92217a3f567b)";
+    utxo.amount = Amount(int64_t{100000000});
+    utxo.address_type = AddressType::kP2wpkhAddress;
+    utxos.push_back(utxo);
+  }
+  Address address = factory.GetAddress("bcrt1qg4nrukf07cf4slc0m4h8gq6v2guhzrw29sfnlu");
+  Address reserve_address = factory.GetAddress("bcrt1q7vcwmqurlzhae9mamzrqp6u07yst590y5ujv3w");
+
+  std::vector<cfd::PayoutRequest> requests;
+  for (int64_t index = 0; index < 5; ++index) {
+    cfd::PayoutRequest request;
+    request.address = address;
+    request.amount = Amount(int64_t{10000000} + index);
+    requests.push_back(request);
+  }
+
+  cfd::PayoutBatcher batcher(0, 2);
+  std::vector<cfd::PayoutBatchData> batches;
+  EXPECT_NO_THROW(batches = batcher.CreateBatches(
+      requests, utxos, reserve_address, 2.0));
+  ASSERT_EQ(batches.size(), size_t{3});
+  std::vector<OutPoint> used_outpoints;
+  uint32_t request_index = 0;
+  for (const auto& batch : batches) {
+    EXPECT_GE(batch.utxos.size(), size_t{1});
+    EXPECT_EQ(batch.transaction.GetTxInCount(),
+        static_cast<uint32_t>(batch.utxos.size()));
+    for (const auto& index : batch.request_indexes) {
+      EXPECT_EQ(index, request_index);
+      ++request_index;
+    }
+    for (const auto& utxo : batch.utxos) {
+      OutPoint outpoint(utxo.txid, utxo.vout);
+      for (const auto& used : used_outpoints) {
+        EXPECT_FALSE(used == outpoint);
+      }
+      used_outpoints.push_back(outpoint);
+    }
+  }
+  EXPECT_EQ(request_index, uint32_t{5});
+  EXPECT_EQ(batches[2].request_indexes.size(), size_t{1});
+}
+
+TEST(TransactionContext, PayoutBatcher_MaxWeight) {
+  AddressFactory factory(NetType::kRegtest);
+  std::vector<UtxoData> utxos;
+  for (uint32_t index = 0; index < 4; ++index) {
+    UtxoData utxo;
+    utxo.block_height = 0;
+    utxo.binary_data = nullptr;
+    utxo.txid = Txid("4aa201f333e80b8f62ba5b593edb47b4730212e2917b21279f389ba1c14588a3");
+    utxo.vout = index;
+    utxo.locking_script = Script("0014f330ed8383f8afdc977dd88600eb8ff120ba15e4");
+    utxo.address = factory.GetAddress("bcrt1q7vcwmqurlzhae9mamzrqp6u07yst590y5ujv3w");
+    utxo.descriptor = "wpkh(0359bc91953b251ae501758673b9d6dd78eafa327190741536025d92217a3f567b)";
+    utxo.amount = Amount(int64_t{100000000});
+    utxo.address_type = AddressType::kP2wpkhAddress;
+    utxos.push_back(utxo);
+  }
+  Address address = factory.GetAddress("bcrt1qg4nrukf07cf4slc0m4h8gq6v2guhzrw29sfnlu");
+  Address reserve_address = factory.GetAddress("bcrt1q7vcwmqurlzhae9mamzrqp6u07yst590y5ujv3w");
+
+  std::vector<cfd::PayoutRequest> requests;
+  for (int64_t index = 0; index < 5; ++index) {
+    cfd::PayoutRequest request;
+    request.address = address;
+    request.amount = Amount(int64_t{10000000} + index);
+    requests.push_back(request);
+  }
+
+  // skeleton and change: 164, p2wpkh txout: 124, signed p2wpkh txin: ~274.
+  // 4 requests are packed by the txout weight (660), but the funded weight
+  // exceeds 700. The trailing requests are dropped, and funded again.
+  cfd::PayoutBatcher batcher(700);
+  std::vector<cfd::PayoutBatchData> batches;
+  EXPECT_NO_THROW(batches = batcher.CreateBatches(
+      requests, utxos, reserve_address, 2.0));
+  ASSERT_EQ(batches.size(), size_t{3});
+  EXPECT_EQ(batches[0].request_indexes, std::vector<uint32_t>({0, 1}));
+  EXPECT_EQ(batches[1].request_indexes, std::vector<uint32_t>({2, 3}));
+  EXPECT_EQ(batches[2].request_indexes, std::vector<uint32_t>({4}));
+  for (const auto& batch : batches) {
+    EXPECT_EQ(batch.utxos.size(), size_t{1});
+    EXPECT_EQ(batch.transaction.GetTxInCount(), uint32_t{1});
+    // payout txout and the change txout
+    EXPECT_EQ(batch.transaction.GetTxOutCount(),
+        static_cast<uint32_t>(batch.request_indexes.size() + 1));
+  }
+
+  // a single request with the txin does not fit.
+  cfd::PayoutBatcher small_batcher(400);
+  EXPECT_THROW(
+      small_batcher.CreateBatches(requests, utxos, reserve_address, 2.0),
+      CfdException);
+}
@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <string>
 #include <vector>
 
 #include "cfdcore/cfdcore_amount.h"
@@ -7,6 +8,7 @@
 #include "cfd/cfd_utxo.h"
 #include "cfdcore/cfdcore_address.h"
 #include "cfdcore/cfdcore_coin.h"
+#include "cfdcore/cfdcore_exception.h"
 
 using cfd::Utxo;
 using cfd::UtxoData;
@@ -59,3 +61,52 @@ TEST(UtxoUtil, ConvertToUtxo)
                utxo1.txid.GetData().GetHex().c_str());
   EXPECT_EQ(dest.vout, utxo1.vout);
 }
+
+TEST(UtxoUtil, ConvertToUtxoParallel)
+{
+  std::vector<UtxoData> utxos;
+  for (uint32_t index = 0; index < 1000; ++index) {
+    UtxoData utxo;
+    utxo.txid = Txid("9e1ead91c432889cb478237da974dd1e9009c9e22694fd1e3999c40a1ef59b0a");
+    utxo.vout = index;
+    utxo.descriptor = "wpkh(0359bc91953b251ae501758673b9d6dd78eafa327190741536025d92217a3f567b)";
+    if (index == 500) utxo.descriptor = "wpkh(invalid)";
+    utxos.push_back(utxo);
+  }
+
+  std::vector<std::string> errors;
+  std::vector<Utxo> results;
+  EXPECT_NO_THROW((results = UtxoUtil::ConvertToUtxoParallel(utxos, &errors, 4)));
+  ASSERT_EQ(results.size(), utxos.size());
+  ASSERT_EQ(errors.size(), utxos.size());
+  for (uint32_t index = 0; index < 1000; ++index) {
+    if (index == 500) {
+      EXPECT_FALSE(errors[index].empty());
+      EXPECT_EQ(results[index].vout, uint32_t{0});
+    } else {
+      EXPECT_TRUE(errors[index].empty());
+      EXPECT_EQ(results[index].vout, index);
+      EXPECT_EQ(results[index].address_type, AddressType::kP2wpkhAddress);
+    }
+  }
+
+  EXPECT_THROW((results = UtxoUtil::ConvertToUtxoParallel(utxos)),
+      cfd::core::CfdException);
+
+  // the parallel path keeps the error code of the serial path.
+  cfd::core::CfdError serial_error = cfd::core::kCfdSuccess;
+  cfd::core::CfdError parallel_error = cfd::core::kCfdSuccess;
+  Utxo utxo;
+  try {
+    UtxoUtil::ConvertToUtxo(utxos[500], &utxo);
+  } catch (const cfd::core::CfdException& except) {
+    serial_error = except.GetErrorCode();
+  }
+  try {
+    results = UtxoUtil::ConvertToUtxoParallel(utxos, nullptr, 4);
+  } catch (const cfd::core::CfdException& except) {
+    parallel_error = except.GetErrorCode();
+  }
+  EXPECT_NE(serial_error, cfd::core::kCfdSuccess);
+  EXPECT_EQ(serial_error, parallel_error);
+}
@@ -965,6 +965,79 @@ TEST(ElementsTransactionApi, FundRawTransaction_MillionAmountValue) {
 }
 
 
+TEST(ElementsTransactionApi, FundRawTransaction_ContextFund) {
+  ElementsAddressFactory factory(NetType::kElementsRegtest);
+  UtxoData utxo1;
+  utxo1.block_height = 0;
+  utxo1.binary_data = nullptr;
+  utxo1.txid = Txid("4aa201f333e80b8f62ba5b593edb47b4730212e2917b21279f389ba1c14588a3");
+  utxo1.vout = 0;
+  utxo1.locking_script = Script("76a914f330ed8383f8afdc977dd88600eb8ff120ba15e488ac");
+  utxo1.address = factory.GetAddress("2dwbdChKUXiSWECFEzLdmegbRtGAAHTC2ph");
+  utxo1.descriptor = "pkh(0359bc91953b251ae501758673b9d6dd78eafa327190741536025d92217a3f567b)";
+  utxo1.amount = Amount(int64_t{300000000000000});
+  utxo1.address_type = AddressType::kP2pkhAddress;
+  utxo1.asset = exp_dummy_asset_a;
+
+  UtxoData utxo2;
+  utxo2.block_height = 0;
+  utxo2.binary_data = nullptr;
+  utxo2.txid = Txid("31559192b619fd52b2cc0ca54d33778acae393ed31c453e29301a3919763b9e3");
+  utxo2.vout = 0;
+  utxo2.locking_script = Script("a9145d54db96a28f844a744e393fcd699d6f825b284187");
+  utxo2.address = factory.GetAddress("XKrjM1JtrjasbbrdJ9Ci51dmkZ1DMxzPJE");
+  utxo2.descriptor = "sh(wpkh(0206d4fabad19c61ffb180fa8a6d0f973e11485e60115557179786f7ea5d806a27))";
+  utxo2.amount = Amount(int64_t{400000000000000});
+  utxo2.address_type = AddressType::kP2shP2wpkhAddress;
+  utxo2.asset = exp_dummy_asset_a;
+
+  Address address1 = factory.GetAddress("2dwbdChKUXiSWECFEzLdmegbRtGAAHTC2ph");
+  Address address3 = factory.GetAddress("ert1q7vcwmqurlzhae9mamzrqp6u07yst590yvg8j0w");
+  ExtPubkey key = ExtPubkey("xpub661MyMwAqRbcGB88KaFbLGiYAat55APKhtWg4uYMkXAmfuSTbq2QYsn9sKJCj1YqZPafsboef4h4YbXXhNhPwMbkHTpkf3zLhx7HvFw1NDy");
+  ElementsConfidentialAddress reserve_ct_addr1 = ElementsConfidentialAddress(
+      address1, key.DerivePubkey(91).GetPubkey());
+  ElementsConfidentialAddress reserve_ct_addr3 = ElementsConfidentialAddress(
+      address3, key.DerivePubkey(93).GetPubkey());
+
+  std::vector<cfd::UtxoData> utxos{utxo1, utxo2};
+  double fee_rate = 0.11;
+  ConfidentialAssetId fee_asset = exp_dummy_asset_a;
+  std::map<std::string, Amount> map_target_value;
+  map_target_value.emplace(exp_dummy_asset_a.GetHex(), Amount(int64_t{0}));
+  std::map<std::string, std::string> reserve_txout_address;
+  reserve_txout_address.emplace(exp_dummy_asset_a.GetHex(), reserve_ct_addr3.GetAddress());
+  UtxoFilter filter;
+  CoinSelectionOption option;
+  option.InitializeConfidentialTxSizeInfo();
+  option.SetEffectiveFeeBaserate(fee_rate);
+  option.SetLongTermFeeBaserate(fee_rate);
+  option.SetFeeAsset(fee_asset);
+  option.SetBlindInfo(0, 52);
+
+  ConfidentialTransactionContext txc(2, 0);
+  txc.AddTxOut(reserve_ct_addr1, Amount(int64_t{500000000000000}), exp_dummy_asset_a);
+
+  ElementsTransactionApi api;
+  Amount api_fee;
+  std::vector<std::string> api_addresses;
+  ConfidentialTransactionController ctx = api.FundRawTransaction(
+      txc.GetHex(), utxos, map_target_value, {}, reserve_txout_address,
+      fee_asset, true, fee_rate, &api_fee, &filter, &option, &api_addresses,
+      NetType::kElementsRegtest);
+
+  Amount context_fee;
+  std::vector<std::string> context_addresses;
+  std::vector<UtxoData> append_utxos;
+  EXPECT_NO_THROW(append_utxos = txc.Fund(
+      utxos, map_target_value, {}, reserve_txout_address, fee_asset, true,
+      fee_rate, &context_fee, &filter, &option, &context_addresses,
+      NetType::kElementsRegtest));
+  EXPECT_EQ(append_utxos.size(), size_t{2});
+  EXPECT_EQ(context_fee.GetSatoshiValue(), api_fee.GetSatoshiValue());
+  EXPECT_EQ(context_addresses.size(), api_addresses.size());
+  EXPECT_STREQ(txc.GetHex().c_str(), ctx.GetHex().c_str());
+}
+
 TEST(ElementsTransactionApi, FundRawTransaction_LimitAmountValue) {
   ElementsAddressFactory factory(NetType::kElementsRegtest);
   // Address1
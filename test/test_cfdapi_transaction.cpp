@@ -281,6 +281,154 @@ TEST(TransactionApi, FundRawTransaction_MillionAmountValue) {
 }
 
 
+TEST(TransactionApi, FundRawTransaction_ContextFund) {
+  AddressFactory factory(NetType::kRegtest);
+  UtxoData utxo1;
+  utxo1.block_height = 0;
+  utxo1.binary_data = nullptr;
+  utxo1.txid = Txid("4aa201f333e80b8f62ba5b593edb47b4730212e2917b21279f389ba1c14588a3");
+  utxo1.vout = 0;
+  utxo1.locking_script = Script("76a914f330ed8383f8afdc977dd88600eb8ff120ba15e488ac");
+  utxo1.address = factory.GetAddress("n3gq7EMkVLyrpSxVxKLFX8qsqiDC5DcqfW");
+  utxo1.descriptor = "pkh(0359bc91953b251ae501758673b9d6dd78eafa327190741536025d92217a3f567b)";
+  utxo1.amount = Amount(int64_t{300000000000000});
+  utxo1.address_type = AddressType::kP2pkhAddress;
+
+  UtxoData utxo2;
+  utxo2.block_height = 0;
+  utxo2.binary_data = nullptr;
+  utxo2.txid = Txid("31559192b619fd52b2cc0ca54d33778acae393ed31c453e29301a3919763b9e3");
+  utxo2.vout = 0;
+  utxo2.locking_script = Script("a9145d54db96a28f844a744e393fcd699d6f825b284187");
+  utxo2.address = factory.GetAddress("2N1kiV9NkmZetZ3j7FuWGkBZxubBMPLxJ16");
+  utxo2.descriptor = "sh(wpkh(0206d4fabad19c61ffb180fa8a6d0f973e11485e60115557179786f7ea5d806a27))";
+  utxo2.amount = Amount(int64_t{400000000000000});
+  utxo2.address_type = AddressType::kP2shP2wpkhAddress;
+
+  UtxoData utxo3;
+  utxo3.block_height = 0;
+  utxo3.binary_data = nullptr;
+  utxo3.txid = Txid("4aa201f333e80b8f62ba5b593edb47b4730212e2917b21279f389ba1c14588a3");
+  utxo3.vout = 1;
+  utxo3.locking_script = Script("0014f330ed8383f8afdc977dd88600eb8ff120ba15e4");
+  utxo3.address = factory.GetAddress("bcrt1q7vcwmqurlzhae9mamzrqp6u07yst590y5ujv3w");
+  utxo3.descriptor = "wpkh(0359bc91953b251ae501758673b9d6dd78eafa327190741536025d92217a3f567b)";
+  utxo3.amount = Amount(int64_t{300000000000000});
+  utxo3.address_type = AddressType::kP2wpkhAddress;
+
+  Address address("mtmTFSnUTqGt6AaSqoRemj7ePPZ6YGXWeo");
+  Address address2("bcrt1qg4nrukf07cf4slc0m4h8gq6v2guhzrw29sfnlu");
+  Address address3("bcrt1q7vcwmqurlzhae9mamzrqp6u07yst590y5ujv3w");
+
+  Amount fee(int64_t{10000});
+  TransactionContext txc(2, 0);
+  txc.AddTxOut(address, utxo1.amount + utxo3.amount - fee);
+  txc.AddTxOut(address2, utxo2.amount);
+
+  std::vector<cfd::UtxoData> utxos{utxo1, utxo2, utxo3};
+  double effective_fee_rate = 20.0;
+  CoinSelectionOption option;
+  std::vector<UtxoData> selected_txin_utxos;
+  Amount target_value;
+  Amount api_fee;
+  Amount context_fee;
+
+  TransactionApi api;
+  auto tx_obj = api.FundRawTransaction(
+      txc.GetHex(), utxos, target_value, selected_txin_utxos, address3.GetAddress(),
+      effective_fee_rate, &api_fee, nullptr, &option, nullptr, NetType::kRegtest);
+
+  std::vector<UtxoData> append_utxos;
+  EXPECT_NO_THROW(append_utxos = txc.Fund(
+      utxos, target_value, selected_txin_utxos, address3,
+      effective_fee_rate, &context_fee, nullptr, &option));
+  EXPECT_EQ(append_utxos.size(), size_t{3});
+  EXPECT_EQ(context_fee.GetSatoshiValue(), api_fee.GetSatoshiValue());
+  EXPECT_EQ(context_fee.GetSatoshiValue(), 8360);
+  EXPECT_EQ(txc.GetTxInCount(), uint32_t{3});
+  EXPECT_EQ(txc.GetTxOutCount(), uint32_t{3});
+  EXPECT_STREQ(txc.GetHex().c_str(), tx_obj.GetHex().c_str());
+}
+
+TEST(TransactionApi, FundRawTransaction_ContextFundByFeeRates) {
+  AddressFactory factory(NetType::kRegtest);
+  UtxoData utxo1;
+  utxo1.block_height = 0;
+  utxo1.binary_data = nullptr;
+  utxo1.txid = Txid("4aa201f333e80b8f62ba5b593edb47b4730212e2917b21279f389ba1c14588a3");
+  utxo1.vout = 0;
+  utxo1.locking_script = Script("76a914f330ed8383f8afdc977dd88600eb8ff120ba15e488ac");
+  utxo1.address = factory.GetAddress("n3gq7EMkVLyrpSxVxKLFX8qsqiDC5DcqfW");
+  utxo1.descriptor = "pkh(0359bc91953b251ae501758673b9d6dd78eafa327190741536025d92217a3f567b)";
+  utxo1.amount = Amount(int64_t{300000000000000});
+  utxo1.address_type = AddressType::kP2pkhAddress;
+
+  UtxoData utxo2;
+  utxo2.block_height = 0;
+  utxo2.binary_data = nullptr;
+  utxo2.txid = Txid("31559192b619fd52b2cc0ca54d33778acae393ed31c453e29301a3919763b9e3");
+  utxo2.vout = 0;
+  utxo2.locking_script = Script("a9145d54db96a28f844a744e393fcd699d6f825b284187");
+  utxo2.address = factory.GetAddress("2N1kiV9NkmZetZ3j7FuWGkBZxubBMPLxJ16");
+  utxo2.descriptor = "sh(wpkh(0206d4fabad19c61ffb180fa8a6d0f973e11485e60115557179786f7ea5d806a27))";
+  utxo2.amount = Amount(int64_t{400000000000000});
+  utxo2.address_type = AddressType::kP2shP2wpkhAddress;
+
+  UtxoData utxo3;
+  utxo3.block_height = 0;
+  utxo3.binary_data = nullptr;
+  utxo3.txid = Txid("4aa201f333e80b8f62ba5b593edb47b4730212e2917b21279f389ba1c14588a3");
+  utxo3.vout = 1;
+  utxo3.locking_script = Script("0014f330ed8383f8afdc977dd88600eb8ff120ba15e4");
+  utxo3.address = factory.GetAddress("bcrt1q7vcwmqurlzhae9mamzrqp6u07yst590y5ujv3w");
+  utxo3.descriptor = "wpkh(0359bc91953b251ae501758673b9d6dd78eafa327190741536025d92217a3f567b)";
+  utxo3.amount = Amount(int64_t{300000000000000});
+  utxo3.address_type = AddressType::kP2wpkhAddress;
+
+  Address address("mtmTFSnUTqGt6AaSqoRemj7ePPZ6YGXWeo");
+  Address address2("bcrt1qg4nrukf07cf4slc0m4h8gq6v2guhzrw29sfnlu");
+  Address address3("bcrt1q7vcwmqurlzhae9mamzrqp6u07yst590y5ujv3w");
+
+  Amount fee(int64_t{10000});
+  TransactionContext txc(2, 0);
+  txc.AddTxOut(address, utxo1.amount + utxo3.amount - fee);
+  txc.AddTxOut(address2, utxo2.amount);
+
+  std::vector<cfd::UtxoData> utxos{utxo1, utxo2, utxo3};
+  // the fee must be in 10000 satoshi, so all utxos are selected.
+  std::vector<double> fee_rates{1.0, 20.0};
+  std::vector<UtxoData> selected_txin_utxos;
+  Amount target_value;
+  std::vector<Amount> context_fees;
+
+  std::vector<TransactionContext> tx_list;
+  EXPECT_NO_THROW(tx_list = txc.FundByFeeRates(
+      utxos, target_value, selected_txin_utxos, address3, fee_rates,
+      &context_fees));
+  ASSERT_EQ(tx_list.size(), fee_rates.size());
+  ASSERT_EQ(context_fees.size(), fee_rates.size());
+  EXPECT_EQ(txc.GetTxInCount(), uint32_t{0});
+  EXPECT_EQ(txc.GetTxOutCount(), uint32_t{2});
+
+  // estimated vsize: 418 (3 txin and 3 txout with the change)
+  std::vector<int64_t> expect_fees{418, 8360};
+  for (size_t index = 0; index < fee_rates.size(); ++index) {
+    const TransactionContext& tx = tx_list[index];
+    EXPECT_EQ(context_fees[index].GetSatoshiValue(), expect_fees[index]);
+    ASSERT_EQ(tx.GetTxInCount(), uint32_t{3});
+    EXPECT_TRUE(tx.IsFindTxIn(OutPoint(utxo1.txid, utxo1.vout)));
+    EXPECT_TRUE(tx.IsFindTxIn(OutPoint(utxo2.txid, utxo2.vout)));
+    EXPECT_TRUE(tx.IsFindTxIn(OutPoint(utxo3.txid, utxo3.vout)));
+    ASSERT_EQ(tx.GetTxOutCount(), uint32_t{3});
+    EXPECT_EQ(
+        tx.GetTxOut(2).GetValue().GetSatoshiValue(),
+        fee.GetSatoshiValue() - expect_fees[index]);
+    EXPECT_STREQ(
+        tx.GetTxOut(2).GetLockingScript().GetHex().c_str(),
+        address3.GetLockingScript().GetHex().c_str());
+  }
+}
+
 TEST(TransactionApi, FundRawTransaction_LimitAmountValue) {
   AddressFactory factory(NetType::kRegtest);
   // Address1